@@ -0,0 +1,196 @@
+// Replays a VectorDeque operation trace (see VectorDequeTrace.hpp) against several policy configurations and reports
+// the time per operation and the peak memory of each.
+//
+// Usage:
+//   replay_trace <trace file> [repetitions]
+//   replay_trace --record-sample <trace file> [operations]
+//
+// The second form records a synthetic queue-like workload, which is useful for trying the tool out without a captured
+// trace.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "VectorDeque.hpp"
+#include "VectorDequeTrace.hpp"
+
+// Heap usage of the whole process, tracked by replacing the global array allocation functions, which are what the
+// heap storage policies use.
+static size_t currentHeapBytes = 0;
+static size_t peakHeapBytes = 0;
+
+void* operator new[](const size_t size) {
+    // Store the size in front of the block so that it can be subtracted again on deletion.
+    void* const block = std::malloc(size + sizeof(std::max_align_t));
+    if (block == NULL) {
+        throw std::bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    currentHeapBytes += size;
+    if (currentHeapBytes > peakHeapBytes) {
+        peakHeapBytes = currentHeapBytes;
+    }
+    return static_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete[](void* const pointer) noexcept {
+    if (pointer != NULL) {
+        void* const block = static_cast<char*>(pointer) - sizeof(std::max_align_t);
+        currentHeapBytes -= *static_cast<size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete[](void* const pointer, size_t) noexcept {
+    operator delete[](pointer);
+}
+
+// Apply a single trace record to `deque`. Added elements are taken from `values`, which is at least as long as the
+// largest count in the trace.
+template <class Deque>
+static void apply(Deque& deque, const TraceRecord& record, const std::vector<int>& values, int64_t& checksum) {
+    const size_t argument = static_cast<size_t>(record.argument);
+    switch (record.operation) {
+        case TRACE_ACCESS:
+            checksum += deque[argument];
+            break;
+        case TRACE_ADD:
+            if (argument == 1) {
+                deque.add(values[0]);
+            } else {
+                deque.addAll(values.data(), argument);
+            }
+            break;
+        case TRACE_ADD_FIRST:
+            for (size_t i = 0; i < argument; ++i) {
+                deque.addFirst(values[i]);
+            }
+            break;
+        case TRACE_ASSIGN:
+            // The contents are not recorded, so an assignment is replayed as refilling to the same size.
+            deque.clear();
+            deque.addAll(values.data(), argument);
+            break;
+        case TRACE_INSERT:
+            deque.insert(values[0], argument);
+            break;
+        case TRACE_REMOVE:
+            deque.skip(argument);
+            break;
+        case TRACE_REMOVE_AT:
+            checksum += deque.removeAt(argument);
+            break;
+        case TRACE_REMOVE_LAST:
+            deque.skipLast(argument);
+            break;
+    }
+}
+
+// Replay `records` `repetitions` times with a fresh `Deque` each time and print the results.
+template <class Deque>
+static void replay(const char* const name, const std::vector<TraceRecord>& records, const std::vector<int>& values,
+        const size_t repetitions) {
+    int64_t checksum = 0;
+    size_t peakBytes = 0;
+    size_t finalCapacity = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t repetition = 0; repetition < repetitions; ++repetition) {
+        const size_t heapBytesBefore = currentHeapBytes;
+        peakHeapBytes = currentHeapBytes;
+        {
+            Deque deque;
+            for (size_t i = 0; i < records.size(); ++i) {
+                apply(deque, records[i], values, checksum);
+            }
+            checksum += static_cast<int64_t>(deque.size());
+            finalCapacity = deque.capacity();
+        }
+        const size_t bytes = peakHeapBytes - heapBytesBefore + sizeof(Deque);
+        if (bytes > peakBytes) {
+            peakBytes = bytes;
+        }
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double numOperations = static_cast<double>(records.size()) * repetitions;
+    std::printf("%-28s %10.2f ns/op %12zu peak bytes %10zu final capacity (checksum %lld)\n", name,
+            seconds * 1e9 / numOperations, peakBytes, finalCapacity, static_cast<long long>(checksum));
+}
+
+// Record a synthetic workload: a queue with occasional priority insertions near the front, cancellations near the
+// back and peeks at random positions.
+static void recordSample(const std::string& path, const size_t numOperations) {
+    BasicVectorDeque<int, TraceOperations> deque;
+    deque.observer<TraceOperations>().startTrace(path);
+    uint64_t state = 88172645463325252ULL;
+    for (size_t i = 0; i < numOperations; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        const unsigned choice = static_cast<unsigned>(state % 100);
+        const size_t size = deque.size();
+        if (choice < 40 || size == 0) {
+            deque.add(static_cast<int>(i));
+        } else if (choice < 75) {
+            deque.pop();
+        } else if (choice < 90) {
+            deque[static_cast<size_t>(state >> 32) % size];
+        } else if (choice < 94) {
+            deque.insert(static_cast<int>(i), static_cast<size_t>(state >> 32) % (size < 8 ? size : 8));
+        } else if (choice < 97) {
+            deque.removeAt(size - 1 - static_cast<size_t>(state >> 32) % (size < 8 ? size : 8));
+        } else {
+            deque.popLast();
+        }
+    }
+    const uint64_t numRecords = deque.observer<TraceOperations>().stopTrace();
+    std::printf("Recorded %llu operations to %s\n", static_cast<unsigned long long>(numRecords), path.c_str());
+}
+
+int main(const int argc, const char* const argv[]) {
+    try {
+        if (argc >= 3 && std::string(argv[1]) == "--record-sample") {
+            recordSample(argv[2], argc >= 4 ? std::strtoul(argv[3], NULL, 10) : 1000000);
+            return 0;
+        }
+        if (argc < 2) {
+            std::fprintf(stderr, "Usage: %s <trace file> [repetitions]\n"
+                    "       %s --record-sample <trace file> [operations]\n", argv[0], argv[0]);
+            return 2;
+        }
+        const size_t repetitions = argc >= 3 ? std::strtoul(argv[2], NULL, 10) : 5;
+        std::vector<TraceRecord> records;
+        size_t maxCount = 1;
+        TraceReader reader(argv[1]);
+        TraceRecord record;
+        while (reader.next(record)) {
+            records.push_back(record);
+            if (record.operation != TRACE_ACCESS && record.operation != TRACE_INSERT
+                    && record.operation != TRACE_REMOVE_AT && record.argument > maxCount) {
+                maxCount = static_cast<size_t>(record.argument);
+            }
+        }
+        std::printf("Replaying %zu operations %zu times\n", records.size(), repetitions);
+        const std::vector<int> values(maxCount, 1);
+        replay<VectorDeque<int> >("default", records, values, repetitions);
+        replay<BasicVectorDeque<int, OneAndAHalfGrowth> >("1.5x growth", records, values, repetitions);
+        replay<BasicVectorDeque<int, MaskWrapping> >("mask wrapping", records, values, repetitions);
+        replay<BasicVectorDeque<int, NoBoundsChecking> >("no bounds checking", records, values, repetitions);
+        replay<BasicVectorDeque<int, NoBoundsChecking, MaskWrapping> >("unchecked + mask", records, values,
+                repetitions);
+        replay<BasicVectorDeque<int, SmallBufferStorage<64> > >("small buffer (64)", records, values, repetitions);
+        replay<BasicVectorDeque<int, SmallBufferStorage<1024> > >("small buffer (1024)", records, values,
+                repetitions);
+        replay<BasicVectorDeque<int, CollectStatistics> >("with statistics", records, values, repetitions);
+    } catch (const std::exception& exception) {
+        std::fprintf(stderr, "%s\n", exception.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Benchmarks SlidingQuantiles against sorting a copy of the window for every query, under a latency monitor workload:
+// every slide adds a sample to a full window, evicting the oldest, then queries p50, p90 and p99.
+//
+// Usage:
+//   sliding_quantiles_bench [window size] [slides] [baseline slides]
+//
+// The defaults are a window of 1000000 samples, 1000000 slides, and 20 slides for the sort-per-query baseline, each
+// of which sorts the whole window.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "SlidingQuantiles.hpp"
+#include "VectorDeque.hpp"
+
+// The quantiles queried after every slide.
+static const double QUANTILES[] = {0.5, 0.9, 0.99};
+
+// The window being replaced: samples in a deque, copied out and sorted for every query.
+class SortPerQuery {
+    private:
+    const size_t _windowSize;
+
+    VectorDeque<uint32_t> _window;
+
+    std::vector<uint32_t> _sorted;
+
+    public:
+    explicit SortPerQuery(const size_t windowSize): _windowSize(windowSize) {}
+
+    void add(const uint32_t sample) {
+        if (_window.size() >= _windowSize) {
+            _window.pop();
+        }
+        _window.add(sample);
+    }
+
+    // Sort once, then read every quantile.
+    uint64_t query() {
+        _sorted.resize(_window.size());
+        _window.copyToArray(_sorted.data());
+        std::sort(_sorted.begin(), _sorted.end());
+        uint64_t sum = 0;
+        for (const double q: QUANTILES) {
+            sum += _sorted[static_cast<size_t>(q * static_cast<double>(_sorted.size() - 1))];
+        }
+        return sum;
+    }
+};
+
+// Adapts SlidingQuantiles to the interface of SortPerQuery.
+class SkiplistQuantiles {
+    private:
+    SlidingQuantiles<uint32_t> _quantiles;
+
+    public:
+    explicit SkiplistQuantiles(const size_t windowSize): _quantiles(windowSize) {}
+
+    void add(const uint32_t sample) {
+        _quantiles.add(sample);
+    }
+
+    uint64_t query() {
+        uint64_t sum = 0;
+        for (const double q: QUANTILES) {
+            sum += _quantiles.quantile(q);
+        }
+        return sum;
+    }
+};
+
+// A latency in microseconds: mostly fast requests, with a long tail.
+static uint32_t randomLatency() {
+    const int kind = std::rand() % 100;
+    if (kind < 90) {
+        return 100 + static_cast<uint32_t>(std::rand() % 400);
+    }
+    if (kind < 99) {
+        return 500 + static_cast<uint32_t>(std::rand() % 4500);
+    }
+    return 5000 + static_cast<uint32_t>(std::rand() % 95000);
+}
+
+template <class Quantiles>
+static void run(const char* const name, const size_t windowSize, const size_t numSlides) {
+    std::srand(1);
+    Quantiles quantiles(windowSize);
+    for (size_t i = 0; i < windowSize; ++i) {
+        quantiles.add(randomLatency());
+    }
+    uint64_t checksum = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < numSlides; ++i) {
+        quantiles.add(randomLatency());
+        checksum += quantiles.query();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-20s %10zu window %10zu slides %10.3f s %14.1f ns/slide (checksum %llu)\n", name, windowSize,
+            numSlides, seconds, seconds * 1e9 / static_cast<double>(numSlides),
+            static_cast<unsigned long long>(checksum));
+}
+
+int main(const int argc, const char* const* const argv) {
+    const size_t windowSize = argc > 1 ? std::strtoull(argv[1], NULL, 10) : 1000000;
+    const size_t numSlides = argc > 2 ? std::strtoull(argv[2], NULL, 10) : 1000000;
+    const size_t numBaselineSlides = argc > 3 ? std::strtoull(argv[3], NULL, 10) : 20;
+    run<SkiplistQuantiles>("SlidingQuantiles", windowSize, numSlides);
+    run<SortPerQuery>("sort per query", windowSize, numBaselineSlides);
+    return 0;
+}
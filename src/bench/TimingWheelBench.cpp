@@ -0,0 +1,167 @@
+// Benchmarks TimingWheel against a sorted VectorDeque of timers under a timer service workload: every tick schedules a
+// batch of timers with a mix of timeouts, most of which are cancelled when the operation they guard completes, and the
+// rest expire.
+//
+// Usage:
+//   timing_wheel_bench [timers] [cancel ratio] [baseline timers]
+//
+// The defaults are 10000000 timers, of which 90% are cancelled, and 100000 timers for the sorted deque, whose
+// inserts are O(n).
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+#include "TimingWheel.hpp"
+#include "VectorDeque.hpp"
+
+// Number of timers scheduled per tick.
+static const size_t TIMERS_PER_TICK = 1000;
+
+// Number of ticks after which the operation guarded by a timer completes, cancelling it if it is to be cancelled.
+static const uint64_t COMPLETION_TICKS = 50;
+
+// The timer service being replaced: timers kept sorted by deadline in a deque, so scheduling and cancelling are O(n).
+class SortedDequeTimers {
+    private:
+    struct Timer {
+        uint64_t deadline;
+        uint64_t id;
+        int value;
+    };
+
+    VectorDeque<Timer> _timers;
+
+    uint64_t _nextId;
+
+    // Index of the first timer whose deadline is after `deadline`, found by binary search.
+    size_t _upperBound(const uint64_t deadline) const {
+        size_t low = 0;
+        size_t high = _timers.size();
+        while (low < high) {
+            const size_t middle = low + (high - low) / 2;
+            if (_timers[middle].deadline <= deadline) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        return low;
+    }
+
+    public:
+    // Deadline and id of a timer.
+    typedef std::pair<uint64_t, uint64_t> Handle;
+
+    SortedDequeTimers(): _nextId(0) {}
+
+    size_t advance(const uint64_t now, VectorDeque<int>& expired) {
+        size_t numExpired = 0;
+        while (!_timers.isEmpty() && _timers.peek().deadline <= now) {
+            expired.add(_timers.pop().value);
+            ++numExpired;
+        }
+        return numExpired;
+    }
+
+    bool cancel(const Handle& handle) {
+        for (size_t i = _upperBound(handle.first); i > 0 && _timers[i - 1].deadline == handle.first; --i) {
+            if (_timers[i - 1].id == handle.second) {
+                _timers.removeAt(i - 1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Handle schedule(const int value, const uint64_t deadline) {
+        _timers.insert(Timer{deadline, _nextId, value}, _upperBound(deadline));
+        return Handle(deadline, _nextId++);
+    }
+};
+
+// Adapts TimingWheel to the interface of SortedDequeTimers.
+class WheelTimers {
+    private:
+    TimingWheel<int> _wheel;
+
+    public:
+    typedef TimerHandle Handle;
+
+    size_t advance(const uint64_t now, VectorDeque<int>& expired) {
+        return _wheel.advance(now, expired);
+    }
+
+    bool cancel(const Handle& handle) {
+        return _wheel.cancel(handle);
+    }
+
+    Handle schedule(const int value, const uint64_t deadline) {
+        return _wheel.schedule(value, deadline);
+    }
+};
+
+// A timeout in ticks (milliseconds): mostly request timeouts of a few seconds, some short retransmission timeouts and
+// a few long idle timeouts.
+static uint64_t randomTimeout() {
+    const int kind = std::rand() % 10;
+    if (kind < 2) {
+        return 100 + static_cast<uint64_t>(std::rand() % 900);
+    }
+    if (kind < 9) {
+        return 5000 + static_cast<uint64_t>(std::rand() % 25000);
+    }
+    return 60000 + static_cast<uint64_t>(std::rand() % 540000);
+}
+
+template <class Timers>
+static void run(const char* const name, const size_t numTimers, const double cancelRatio) {
+    std::srand(1);
+    Timers timers;
+    // Timers in the order they were scheduled, with whether to cancel each when its operation completes.
+    VectorDeque<std::pair<typename Timers::Handle, bool> > inFlight;
+    VectorDeque<int> expired;
+    size_t numScheduled = 0;
+    size_t numCancelled = 0;
+    size_t numExpired = 0;
+    uint64_t now = 0;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (numScheduled < numTimers || !inFlight.isEmpty()) {
+        ++now;
+        for (size_t i = 0; i < TIMERS_PER_TICK && numScheduled < numTimers; ++i, ++numScheduled) {
+            const bool toCancel = std::rand() < cancelRatio * RAND_MAX;
+            inFlight.add(std::make_pair(timers.schedule(static_cast<int>(numScheduled), now + randomTimeout()),
+                    toCancel));
+        }
+        // Operations complete in the order they started.
+        const size_t numCompleting = now > COMPLETION_TICKS ? TIMERS_PER_TICK : 0;
+        for (size_t i = 0; i < numCompleting && !inFlight.isEmpty(); ++i) {
+            const std::pair<typename Timers::Handle, bool> timer = inFlight.pop();
+            if (timer.second && timers.cancel(timer.first)) {
+                ++numCancelled;
+            }
+        }
+        expired.clear();
+        numExpired += timers.advance(now, expired);
+    }
+    // Let the remaining timers expire.
+    expired.clear();
+    numExpired += timers.advance(now + 600000, expired);
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const size_t numOperations = numScheduled + numCancelled + numExpired;
+    std::printf("%-20s %10zu timers %10zu cancelled %10zu expired %10.3f s %10.1f ns/operation\n", name,
+            numScheduled, numCancelled, numExpired, seconds, seconds * 1e9 / static_cast<double>(numOperations));
+}
+
+int main(const int argc, const char* const* const argv) {
+    const size_t numTimers = argc > 1 ? std::strtoull(argv[1], NULL, 10) : 10000000;
+    const double cancelRatio = argc > 2 ? std::strtod(argv[2], NULL) : 0.9;
+    const size_t numBaselineTimers = argc > 3 ? std::strtoull(argv[3], NULL, 10) : 100000;
+    run<WheelTimers>("TimingWheel", numTimers, cancelRatio);
+    run<SortedDequeTimers>("sorted VectorDeque", numBaselineTimers, cancelRatio);
+    return 0;
+}
@@ -0,0 +1,371 @@
+#ifndef ASYNC_WRITER_SINK_HPP
+#define ASYNC_WRITER_SINK_HPP
+
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "VectorDeque.hpp"
+
+/**
+ * When an `AsyncWriterSink` calls `fdatasync` on its file.
+ */
+enum AsyncWriterSyncPolicy {
+    // Never: the data reaches the disk whenever the operating system writes it back.
+    SYNC_NEVER = 0,
+    // After every batch written.
+    SYNC_EVERY_WRITE = 1,
+    // Once, when the sink is closed.
+    SYNC_ON_CLOSE = 2
+};
+
+/**
+ * What `AsyncWriterSink::append` does when the buffer has no room for a record.
+ */
+enum AsyncWriterFullPolicy {
+    // Wait for the writer thread to make room.
+    FULL_BLOCK = 0,
+    // Drop the record, counting it in `numDropped`.
+    FULL_DROP = 1
+};
+
+/**
+ * Options of an `AsyncWriterSink`. The defaults write at least every 64 KiB or 100 milliseconds, never sync and block
+ * when full.
+ */
+struct AsyncWriterSinkOptions {
+    // Number of buffered bytes which wakes the writer thread.
+    size_t flushBytes;
+
+    // Longest time data stays buffered before being written, or zero to only write on size and on `flush`.
+    std::chrono::milliseconds flushInterval;
+
+    AsyncWriterSyncPolicy syncPolicy;
+
+    AsyncWriterFullPolicy fullPolicy;
+
+    AsyncWriterSinkOptions(): flushBytes(64 * 1024), flushInterval(100), syncPolicy(SYNC_NEVER),
+            fullPolicy(FULL_BLOCK) {}
+};
+
+/**
+ * `AsyncWriterSink` batches records appended by any number of threads and writes them to a file from a background
+ * thread, so that appending costs a copy into memory instead of a system call per record.
+ * Records are buffered in a byte `VectorDeque` of fixed capacity, which bounds the memory used. The writer thread
+ * writes everything buffered with a single `writev` over the (at most two) contiguous segments of the deque, without
+ * holding the lock, so appends continue while it writes.
+ * Only available on POSIX systems.
+ */
+class AsyncWriterSink {
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class AsyncWriterSinkTest;
+
+    typedef BasicVectorDeque<char, FixedCapacity> Buffer;
+
+    const AsyncWriterSinkOptions _options;
+
+    // Descriptor of the file written to.
+    const int _fd;
+
+    // Guards all the fields below.
+    std::mutex _mutex;
+
+    // Signalled when there is something for the writer thread to do.
+    std::condition_variable _writerWakeup;
+
+    // Signalled when the writer thread has written a batch, freeing room and possibly completing flushes.
+    std::condition_variable _written;
+
+    Buffer _buffer;
+
+    // Total number of bytes appended and written so far.
+    uint64_t _numBytesAppended;
+    uint64_t _numBytesWritten;
+
+    // Number of bytes which must be written before the pending `flush` calls return.
+    uint64_t _flushTarget;
+
+    // Number of records dropped because the buffer was full.
+    uint64_t _numDropped;
+
+    // Number of `writev` calls made.
+    uint64_t _numWrites;
+
+    // Number of appends waiting for room, which the writer thread writes for regardless of `flushBytes`.
+    size_t _numWaiting;
+
+    // The `errno` of the first failed write or sync, or `0`.
+    int _error;
+
+    bool _closing;
+
+    std::thread _writer;
+
+    static int _open(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        return fd;
+    }
+
+    // Throw the error of the writer thread, if any. Must hold `_mutex`.
+    void _checkError() const {
+        if (_error != 0) {
+            throw std::system_error(_error, std::generic_category(), "AsyncWriterSink write failed");
+        }
+    }
+
+    // Write the `length` bytes of `segments` to the file, retrying partial writes, and count the `writev` calls made in
+    // `numWrites`. Returns `0` on success, or `errno`.
+    int _writeAll(VectorDequeSegments<char> segments, size_t length, uint64_t& numWrites) const {
+        iovec vectors[2];
+        vectors[0].iov_base = segments.first.data;
+        vectors[0].iov_len = segments.first.length;
+        vectors[1].iov_base = segments.second.data;
+        vectors[1].iov_len = segments.second.length;
+        iovec* remaining = vectors;
+        int numRemaining = segments.second.length > 0 ? 2 : 1;
+        while (length > 0) {
+            const ssize_t numWritten = ::writev(_fd, remaining, numRemaining);
+            ++numWrites;
+            if (numWritten < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return errno;
+            }
+            length -= static_cast<size_t>(numWritten);
+            size_t skipped = static_cast<size_t>(numWritten);
+            while (numRemaining > 0 && skipped >= remaining->iov_len) {
+                skipped -= remaining->iov_len;
+                ++remaining;
+                --numRemaining;
+            }
+            if (numRemaining > 0) {
+                remaining->iov_base = static_cast<char*>(remaining->iov_base) + skipped;
+                remaining->iov_len -= skipped;
+            }
+        }
+        return 0;
+    }
+
+    // Body of the writer thread.
+    void _run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (;;) {
+            const auto ready = [this]() {
+                return _closing || (_numWaiting > 0 && !_buffer.isEmpty()) || _flushTarget > _numBytesWritten
+                        || _buffer.size() >= _options.flushBytes;
+            };
+            if (_options.flushInterval.count() > 0) {
+                _writerWakeup.wait_for(lock, _options.flushInterval, ready);
+            } else {
+                _writerWakeup.wait(lock, ready);
+            }
+            if (_buffer.isEmpty()) {
+                if (_closing) {
+                    return;
+                }
+                continue;
+            }
+            // Appends only add to the back of the buffer and it never reallocates, so its front segments stay valid
+            // while the lock is released.
+            const size_t length = _buffer.size();
+            const VectorDequeSegments<char> segments = _buffer.segments();
+            lock.unlock();
+            uint64_t numWrites = 0;
+            int error = _error == 0 ? _writeAll(segments, length, numWrites) : 0;
+            if (error == 0 && _options.syncPolicy == SYNC_EVERY_WRITE && ::fdatasync(_fd) != 0) {
+                error = errno;
+            }
+            lock.lock();
+            if (error != 0 && _error == 0) {
+                _error = error;
+            }
+            _buffer.skip(length);
+            _numBytesWritten += length;
+            _numWrites += numWrites;
+            _written.notify_all();
+        }
+    }
+
+    public:
+    /**
+     * Opens `path` for appending (creating it if needed) and starts the writer thread.
+     * Runtime: `O(capacity)`
+     * @param path Path of the file to write to.
+     * @param capacity The number of bytes which can be buffered.
+     * @param options When to write and sync, and what to do when the buffer is full.
+     * @throws std::system_error If the file cannot be opened or the thread cannot be started.
+     */
+    AsyncWriterSink(const std::string& path, const size_t capacity,
+            const AsyncWriterSinkOptions& options = AsyncWriterSinkOptions()): _options(options), _fd(_open(path)),
+            _buffer(capacity), _numBytesAppended(0), _numBytesWritten(0), _flushTarget(0), _numDropped(0),
+            _numWrites(0), _numWaiting(0), _error(0), _closing(false) {
+        try {
+            _writer = std::thread(&AsyncWriterSink::_run, this);
+        } catch (...) {
+            ::close(_fd);
+            throw;
+        }
+    }
+
+    AsyncWriterSink(const AsyncWriterSink&) = delete;
+
+    AsyncWriterSink& operator =(const AsyncWriterSink&) = delete;
+
+    /**
+     * Writes everything buffered and closes the file. Errors are ignored; call `close` to see them.
+     * Runtime: `O(number of bytes buffered)`
+     */
+    ~AsyncWriterSink() {
+        try {
+            close();
+        } catch (...) {}
+    }
+
+    /**
+     * Append the record `data` of `length` bytes. If the buffer has no room for it, this either waits for room or
+     * drops the record, depending on the full policy.
+     * Runtime: `O(length)` if the buffer has room
+     * @param data The bytes of the record.
+     * @param length The number of bytes.
+     * @return `true` If the record was appended, `false` if it was dropped.
+     * @throws std::length_error If `length` is more than the capacity of the buffer.
+     * @throws std::logic_error If the sink is closed.
+     * @throws std::system_error If an earlier write failed.
+     */
+    bool append(const char* const data, const size_t length) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (length > _buffer.capacity()) {
+            throw std::length_error("Record of " + std::to_string(length) + " bytes is larger than the buffer");
+        }
+        for (;;) {
+            if (_closing) {
+                throw std::logic_error("AsyncWriterSink is closed");
+            }
+            _checkError();
+            if (_buffer.size() + length <= _buffer.capacity()) {
+                break;
+            }
+            if (_options.fullPolicy == FULL_DROP) {
+                ++_numDropped;
+                return false;
+            }
+            ++_numWaiting;
+            _writerWakeup.notify_one();
+            _written.wait(lock);
+            --_numWaiting;
+        }
+        _buffer.addAll(data, length);
+        _numBytesAppended += length;
+        if (_buffer.size() >= _options.flushBytes) {
+            _writerWakeup.notify_one();
+        }
+        return true;
+    }
+
+    /**
+     * Append the record `record`. See `append(const char*, size_t)`.
+     * Runtime: `O(record.size())` if the buffer has room
+     * @param record The record.
+     * @return `true` If the record was appended, `false` if it was dropped.
+     */
+    bool append(const std::string& record) {
+        return append(record.data(), record.size());
+    }
+
+    /**
+     * Write everything buffered, stop the writer thread and close the file, syncing it first unless the sync policy
+     * is `SYNC_NEVER`. Further appends throw. Does nothing if already closed.
+     * Runtime: `O(number of bytes buffered)`
+     * @throws std::system_error If a write, the sync or closing the file failed.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_closing) {
+                return;
+            }
+            _closing = true;
+        }
+        _writerWakeup.notify_one();
+        _writer.join();
+        // Wake any appends still waiting for room so that they see the sink is closed.
+        _written.notify_all();
+        int error = _error;
+        if (error == 0 && _options.syncPolicy != SYNC_NEVER && ::fdatasync(_fd) != 0) {
+            error = errno;
+        }
+        if (::close(_fd) != 0 && error == 0) {
+            error = errno;
+        }
+        if (error != 0) {
+            throw std::system_error(error, std::generic_category(), "AsyncWriterSink close failed");
+        }
+    }
+
+    /**
+     * Wait until every record appended before this call is written to the file (and synced, if the sync policy is
+     * `SYNC_EVERY_WRITE`).
+     * Runtime: `O(number of bytes buffered)`
+     * @throws std::system_error If a write failed.
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        const uint64_t target = _numBytesAppended;
+        if (target > _flushTarget) {
+            _flushTarget = target;
+        }
+        _writerWakeup.notify_one();
+        while (_numBytesWritten < target && _error == 0) {
+            _written.wait(lock);
+        }
+        _checkError();
+    }
+
+    /**
+     * Returns the number of bytes written to the file so far.
+     * Runtime: `O(1)`
+     * @return The number of bytes written.
+     */
+    uint64_t numBytesWritten() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _numBytesWritten;
+    }
+
+    /**
+     * Returns the number of records dropped because the buffer was full.
+     * Runtime: `O(1)`
+     * @return The number of records dropped.
+     */
+    uint64_t numDropped() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _numDropped;
+    }
+
+    /**
+     * Returns the number of `writev` calls made so far.
+     * Runtime: `O(1)`
+     * @return The number of `writev` calls.
+     */
+    uint64_t numWrites() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _numWrites;
+    }
+};
+
+#endif
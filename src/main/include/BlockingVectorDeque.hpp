@@ -0,0 +1,183 @@
+#ifndef BLOCKING_VECTOR_DEQUE_HPP
+#define BLOCKING_VECTOR_DEQUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+#include "VectorDeque.hpp"
+
+/**
+ * `BlockingVectorDeque` is a bounded queue shared between threads whose overflow policy is to block: additions which
+ * would exceed the maximum size wait until consumers have made room, and removals wait until there is something to
+ * remove. It wraps a `VectorDeque` bounded with `RejectOnOverflow` behind a mutex, so the non-blocking `tryAdd` simply
+ * rejects and counts the drop.
+ * A batch added with `addAll` waits once for room for the whole batch and is then added at once, so the elements of a
+ * batch are never interleaved with those of other producers.
+ * @param DataType The type of the data to contain.
+ */
+template <class DataType>
+class BlockingVectorDeque {
+    private:
+    typedef BasicVectorDeque<DataType, RejectOnOverflow> Deque;
+
+    // Guards all the fields below.
+    mutable std::mutex _mutex;
+
+    // Signalled when elements are removed, making room for waiting additions.
+    std::condition_variable _notFull;
+
+    // Signalled when elements are added.
+    std::condition_variable _notEmpty;
+
+    Deque _deque;
+
+    // Number of additions which had to wait for room.
+    uint64_t _numBlocked;
+
+    // Wait until `amount` more elements fit. Must hold `lock`.
+    void _waitForRoom(std::unique_lock<std::mutex>& lock, const size_t amount) {
+        if (amount > _deque.maxSize()) {
+            throw std::length_error("Cannot add " + std::to_string(amount) + " elements to a BlockingVectorDeque of "
+                    + "maximum size " + std::to_string(_deque.maxSize()));
+        }
+        if (_deque.size() + amount > _deque.maxSize()) {
+            ++_numBlocked;
+            do {
+                _notFull.wait(lock);
+            } while (_deque.size() + amount > _deque.maxSize());
+        }
+    }
+
+    public:
+    /**
+     * Constructs an empty `BlockingVectorDeque` holding at most `maxSize` elements.
+     * Runtime: `O(1)`
+     * @param maxSize The maximum number of elements.
+     */
+    explicit BlockingVectorDeque(const size_t maxSize): _numBlocked(0) {
+        _deque.setMaxSize(maxSize);
+    }
+
+    BlockingVectorDeque(const BlockingVectorDeque&) = delete;
+
+    BlockingVectorDeque& operator =(const BlockingVectorDeque&) = delete;
+
+    /**
+     * Add `element` to the back, waiting for room if full.
+     * Runtime: `O(1)` if there is room
+     * @param element Element to add.
+     * @throws std::length_error If the maximum size is `0`.
+     */
+    void add(const DataType& element) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _waitForRoom(lock, 1);
+        _deque.add(element);
+        _notEmpty.notify_one();
+    }
+
+    /**
+     * Add an array of elements to the back, waiting until there is room for all of them and then adding them at once.
+     * Runtime: `O(length)` once there is room
+     * @param elements Elements to add.
+     * @param length Amount of elements to add.
+     * @throws std::length_error If `length` is more than the maximum size, so that the batch could never fit.
+     */
+    void addAll(const DataType* const elements, const size_t length) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _waitForRoom(lock, length);
+        _deque.addAll(elements, length);
+        _notEmpty.notify_all();
+    }
+
+    /**
+     * Returns the maximum number of elements.
+     * Runtime: `O(1)`
+     * @return The maximum size.
+     */
+    size_t maxSize() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _deque.maxSize();
+    }
+
+    /**
+     * Returns the number of additions which had to wait for room, counting a batch as one.
+     * Runtime: `O(1)`
+     * @return The number of blocked additions.
+     */
+    uint64_t numBlocked() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _numBlocked;
+    }
+
+    /**
+     * Returns the number of elements `tryAdd` dropped because the deque was full.
+     * Runtime: `O(1)`
+     * @return The number of elements dropped.
+     */
+    size_t numDropped() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _deque.numDropped();
+    }
+
+    /**
+     * Remove and return the first element, waiting for one if empty.
+     * Runtime: `O(1)` if not empty
+     * @return The first element.
+     */
+    DataType pop() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (_deque.isEmpty()) {
+            _notEmpty.wait(lock);
+        }
+        const DataType element = _deque.pop();
+        _notFull.notify_all();
+        return element;
+    }
+
+    /**
+     * Returns the number of elements.
+     * Runtime: `O(1)`
+     * @return The number of elements.
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _deque.size();
+    }
+
+    /**
+     * Add `element` to the back if there is room, without waiting.
+     * Runtime: `O(1)`
+     * @param element Element to add.
+     * @return `true` If `element` was added, `false` if the deque was full, in which case it is counted as dropped.
+     */
+    bool tryAdd(const DataType& element) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_deque.add(element)) {
+            return false;
+        }
+        _notEmpty.notify_one();
+        return true;
+    }
+
+    /**
+     * Remove the first element into `target` if there is one, without waiting.
+     * Runtime: `O(1)`
+     * @param target Where to store the removed element.
+     * @return `true` If an element was removed, `false` if the deque was empty.
+     */
+    bool tryPop(DataType& target) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_deque.isEmpty()) {
+            return false;
+        }
+        target = _deque.pop();
+        _notFull.notify_all();
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,303 @@
+#ifndef BUFFER_POOL_HPP
+#define BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "VectorDequePolicies.hpp"
+
+/**
+ * `BufferPool` caches freed memory blocks for reuse, so that code creating and destroying many short-lived deques does
+ * not go to the global heap (and contend on its locks) for every backing array. Each thread has its own pool, returned
+ * by `local()`, so taking and returning blocks needs no synchronization.
+ * Blocks are grouped into power-of-two size classes from `2^MIN_CLASS` to `2^MAX_CLASS` bytes, each holding a free
+ * list threaded through the cached blocks themselves. Requests are rounded up to their class, and larger ones bypass
+ * the pool. At most `maxCachedBytes()` bytes are cached: blocks returned beyond that go back to the heap. Every block
+ * comes from `::operator new`, so a block may be returned to any thread's pool, or to the heap.
+ */
+class BufferPool {
+    public:
+    /**
+     * Base 2 logarithm of the smallest block size.
+     */
+    static const unsigned MIN_CLASS = 6;
+
+    /**
+     * Base 2 logarithm of the largest block size cached. Larger blocks always come from and return to the heap.
+     */
+    static const unsigned MAX_CLASS = 24;
+
+    /**
+     * Number of bytes each pool caches at most unless changed with `setMaxCachedBytes`.
+     */
+    static const size_t DEFAULT_MAX_CACHED_BYTES = static_cast<size_t>(8) << 20;
+
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class BufferPoolTest;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    // Cached blocks of each class.
+    FreeBlock* _freeBlocks[MAX_CLASS + 1];
+
+    size_t _cachedBytes;
+
+    size_t _maxCachedBytes;
+
+    uint64_t _numHits;
+
+    uint64_t _numMisses;
+
+    // Whether the pool of the current thread has been destroyed, which happens at thread exit. Deques destroyed
+    // after it, such as those with static storage duration, return their blocks to the heap instead.
+    static bool& _isLocalDestroyed() noexcept {
+        static thread_local bool destroyed = false;
+        return destroyed;
+    }
+
+    // The size class of a block of `bytes` bytes.
+    static unsigned _classOf(const size_t bytes) noexcept {
+        unsigned sizeClass = MIN_CLASS;
+        while (sizeClass <= MAX_CLASS && (static_cast<size_t>(1) << sizeClass) < bytes) {
+            ++sizeClass;
+        }
+        return sizeClass;
+    }
+
+    public:
+    /**
+     * Constructs an empty `BufferPool`.
+     * Runtime: `O(MAX_CLASS)`
+     * @param maxCachedBytes Number of bytes to cache at most.
+     */
+    explicit BufferPool(const size_t maxCachedBytes = DEFAULT_MAX_CACHED_BYTES): _freeBlocks(), _cachedBytes(0),
+            _maxCachedBytes(maxCachedBytes), _numHits(0), _numMisses(0) {}
+
+    BufferPool(const BufferPool&) = delete;
+
+    BufferPool& operator =(const BufferPool&) = delete;
+
+    /**
+     * Returns every cached block to the heap.
+     * Runtime: `O(number of cached blocks)`
+     */
+    ~BufferPool() {
+        trim();
+        if (this == local()) {
+            _isLocalDestroyed() = true;
+        }
+    }
+
+    /**
+     * Get the pool of the current thread, which is created on first use and destroyed at thread exit.
+     * Runtime: `O(1)`
+     * @return The pool of the current thread, or `nullptr` if the thread is exiting and its pool has been destroyed.
+     */
+    static BufferPool* local() {
+        if (_isLocalDestroyed()) {
+            return nullptr;
+        }
+        static thread_local BufferPool pool;
+        return &pool;
+    }
+
+    /**
+     * Get a block of at least `bytes` bytes, reusing a cached one of its size class if there is one.
+     * Runtime: `O(1)`, plus that of the heap if no block is cached
+     * @param bytes Number of bytes needed. Updated to the size of the block, which is a power of two unless larger
+     * than `2^MAX_CLASS`.
+     * @return The block, aligned for any fundamental type. Return it with `deallocate`.
+     * @throws std::bad_alloc If the heap cannot provide a block.
+     */
+    void* allocate(size_t& bytes) {
+        const unsigned sizeClass = _classOf(bytes);
+        if (sizeClass > MAX_CLASS) {
+            ++_numMisses;
+            return ::operator new(bytes);
+        }
+        bytes = static_cast<size_t>(1) << sizeClass;
+        FreeBlock* const block = _freeBlocks[sizeClass];
+        if (block == nullptr) {
+            ++_numMisses;
+            return ::operator new(bytes);
+        }
+        _freeBlocks[sizeClass] = block->next;
+        _cachedBytes -= bytes;
+        ++_numHits;
+        return block;
+    }
+
+    /**
+     * Returns the number of bytes cached.
+     * Runtime: `O(1)`
+     * @return The number of bytes.
+     */
+    size_t cachedBytes() const noexcept {
+        return _cachedBytes;
+    }
+
+    /**
+     * Return a block to the pool, which caches it unless that would exceed `maxCachedBytes()`.
+     * Runtime: `O(1)`, plus that of the heap if the block is not cached
+     * @param block Block from `allocate` of any thread's pool. May be `nullptr`, in which case nothing is done.
+     * @param bytes Number of bytes requested for the block, or its size.
+     */
+    void deallocate(void* const block, const size_t bytes) noexcept {
+        if (block == nullptr) {
+            return;
+        }
+        const unsigned sizeClass = _classOf(bytes);
+        if (sizeClass > MAX_CLASS || _cachedBytes + (static_cast<size_t>(1) << sizeClass) > _maxCachedBytes) {
+            ::operator delete(block);
+            return;
+        }
+        FreeBlock* const freeBlock = static_cast<FreeBlock*>(block);
+        freeBlock->next = _freeBlocks[sizeClass];
+        _freeBlocks[sizeClass] = freeBlock;
+        _cachedBytes += static_cast<size_t>(1) << sizeClass;
+    }
+
+    /**
+     * Returns the maximum number of bytes cached.
+     * Runtime: `O(1)`
+     * @return The number of bytes.
+     */
+    size_t maxCachedBytes() const noexcept {
+        return _maxCachedBytes;
+    }
+
+    /**
+     * Returns the number of blocks handed out from the cache.
+     * Runtime: `O(1)`
+     * @return The number of blocks.
+     */
+    uint64_t numHits() const noexcept {
+        return _numHits;
+    }
+
+    /**
+     * Returns the number of blocks which had to come from the heap.
+     * Runtime: `O(1)`
+     * @return The number of blocks.
+     */
+    uint64_t numMisses() const noexcept {
+        return _numMisses;
+    }
+
+    /**
+     * Set the maximum number of bytes cached, trimming the cache down to it if needed.
+     * Runtime: `O(number of blocks trimmed + MAX_CLASS)`
+     * @param maxCachedBytes Number of bytes to cache at most.
+     */
+    void setMaxCachedBytes(const size_t maxCachedBytes) noexcept {
+        _maxCachedBytes = maxCachedBytes;
+        trim(maxCachedBytes);
+    }
+
+    /**
+     * Return cached blocks to the heap, largest first, until at most `targetBytes` bytes are cached. Call it when a
+     * burst is over to give memory back, or with no argument to empty the cache.
+     * Runtime: `O(number of blocks trimmed + MAX_CLASS)`
+     * @param targetBytes Number of bytes to keep cached at most.
+     */
+    void trim(const size_t targetBytes = 0) noexcept {
+        for (unsigned sizeClass = MAX_CLASS + 1; sizeClass-- > MIN_CLASS && _cachedBytes > targetBytes;) {
+            while (_freeBlocks[sizeClass] != nullptr && _cachedBytes > targetBytes) {
+                FreeBlock* const block = _freeBlocks[sizeClass];
+                _freeBlocks[sizeClass] = block->next;
+                _cachedBytes -= static_cast<size_t>(1) << sizeClass;
+                ::operator delete(block);
+            }
+        }
+    }
+};
+
+/**
+ * Store the backing array on the heap, recycling it through the current thread's `BufferPool`: freed arrays are
+ * cached by size class and handed to the next deque of the thread needing one of that size, instead of going through
+ * the global heap each time. Elements are constructed when an array is taken and destroyed when it is returned, so
+ * recycled arrays hold no old elements.
+ * Since blocks are powers of two in size, capacities are rounded up to fill them when `sizeof(DataType)` is a power of
+ * two (and so the capacity stays one for `MaskWrapping`). A capacity of `0` allocates nothing.
+ */
+struct PooledHeapStorage {
+    typedef StoragePolicy Category;
+
+    template <class DataType>
+    class Storage {
+        static_assert(alignof(DataType) <= alignof(std::max_align_t),
+                "PooledHeapStorage does not support over-aligned types");
+
+        public:
+        static const size_t INLINE_CAPACITY = 0;
+
+        // Arrays come from the pool, so they cannot be adopted or released.
+        static const bool NEW_ARRAYS = false;
+
+        static VECTOR_DEQUE_CONSTEXPR size_t defaultCapacity(const size_t suggested) noexcept {
+            return suggested;
+        }
+
+        // Allocate an array of at least `capacity` elements, updating `capacity` to its actual length.
+        DataType* allocate(size_t& capacity) const {
+            if (capacity == 0) {
+                return nullptr;
+            }
+            if (capacity > SIZE_MAX / sizeof(DataType)) {
+                throw std::bad_array_new_length();
+            }
+            size_t bytes = capacity * sizeof(DataType);
+            BufferPool* const pool = BufferPool::local();
+            DataType* const data = static_cast<DataType*>(pool != nullptr ? pool->allocate(bytes)
+                    : ::operator new(bytes));
+            const size_t actualCapacity = (sizeof(DataType) & (sizeof(DataType) - 1)) == 0 ? bytes / sizeof(DataType)
+                    : capacity;
+            size_t numConstructed = 0;
+            try {
+                for (; numConstructed < actualCapacity; ++numConstructed) {
+                    ::new (static_cast<void*>(data + numConstructed)) DataType;
+                }
+            } catch (...) {
+                _destroy(data, numConstructed);
+                _release(data, bytes);
+                throw;
+            }
+            capacity = actualCapacity;
+            return data;
+        }
+
+        void deallocate(DataType* const data, const size_t capacity) const noexcept {
+            if (data == nullptr) {
+                return;
+            }
+            _destroy(data, capacity);
+            _release(data, capacity * sizeof(DataType));
+        }
+
+        bool isInline(const DataType* const) const noexcept {
+            return false;
+        }
+
+        private:
+        static void _destroy(DataType* const data, const size_t length) noexcept {
+            for (size_t i = length; i > 0; --i) {
+                data[i - 1].~DataType();
+            }
+        }
+
+        static void _release(DataType* const data, const size_t bytes) noexcept {
+            BufferPool* const pool = BufferPool::local();
+            if (pool != nullptr) {
+                pool->deallocate(data, bytes);
+            } else {
+                ::operator delete(data);
+            }
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,205 @@
+#ifndef COALESCER_HPP
+#define COALESCER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "VectorDeque.hpp"
+
+/**
+ * When a `Coalescer` emits a batch. A batch is emitted as soon as any of the limits is reached; a limit of `0` is
+ * disabled.
+ */
+struct CoalescerLimits {
+    // Number of items in a batch.
+    size_t maxCount;
+
+    // Number of bytes in a batch, as measured by the coalescer's size function.
+    size_t maxBytes;
+
+    // Age of the oldest item of a batch. Only checked when items are added and by `poll`.
+    std::chrono::nanoseconds maxAge;
+
+    CoalescerLimits(const size_t maxCount = 0, const size_t maxBytes = 0,
+            const std::chrono::nanoseconds maxAge = std::chrono::nanoseconds(0)): maxCount(maxCount),
+            maxBytes(maxBytes), maxAge(maxAge) {}
+};
+
+/**
+ * `BasicCoalescer` is a batching stage: it accumulates items in a `VectorDeque` and hands them to a sink in batches,
+ * for consumers which are much faster when fed many items at once. A batch is emitted when it reaches a number of
+ * items, a number of bytes or an age, whichever comes first, or when `flush` is called.
+ * The sink receives the batch as the (at most two) contiguous segments of the deque, so items are handed over without
+ * being copied, and may be moved from. Since time only advances between calls, the age limit is checked when items are
+ * added and when `poll` is called; call `poll` from a timer (at `deadline()`) to bound the age of batches that receive
+ * no more items.
+ * @param DataType The type of the items.
+ * @param Clock The clock to measure ages by, such as `std::chrono::steady_clock`.
+ */
+template <class DataType, class Clock>
+class BasicCoalescer {
+    public:
+    /**
+     * Function receiving each batch. The segments are only valid during the call.
+     */
+    typedef std::function<void(VectorDequeSegments<DataType>)> Sink;
+
+    /**
+     * Function measuring the number of bytes of an item.
+     */
+    typedef std::function<size_t(const DataType&)> SizeFunction;
+
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class CoalescerTest;
+
+    const CoalescerLimits _limits;
+
+    const Sink _sink;
+
+    const SizeFunction _sizeOf;
+
+    // The current batch.
+    VectorDeque<DataType> _batch;
+
+    // Number of bytes of the current batch.
+    size_t _bytes;
+
+    // When the first item of the current batch was added.
+    typename Clock::time_point _batchStart;
+
+    // Number of batches emitted.
+    uint64_t _numBatches;
+
+    // Whether the current batch has reached a limit.
+    bool _isDue(const typename Clock::time_point now) const {
+        return (_limits.maxCount != 0 && _batch.size() >= _limits.maxCount)
+                || (_limits.maxBytes != 0 && _bytes >= _limits.maxBytes)
+                || (_limits.maxAge.count() != 0 && now - _batchStart >= _limits.maxAge);
+    }
+
+    // Hand the current batch to the sink and start a new one. The items are only removed once the sink returns, so if
+    // it throws they stay in the batch.
+    void _emit() {
+        _sink(_batch.segments());
+        _batch.clear();
+        _bytes = 0;
+        ++_numBatches;
+    }
+
+    public:
+    /**
+     * Constructs an empty `BasicCoalescer`.
+     * Runtime: `O(1)`
+     * @param limits When to emit a batch.
+     * @param sink Function receiving each batch.
+     * @param sizeOf Function measuring the bytes of an item, for the byte limit. Defaults to `sizeof(DataType)`.
+     * @throws std::invalid_argument If `sink` is empty.
+     */
+    BasicCoalescer(const CoalescerLimits& limits, Sink sink, SizeFunction sizeOf = SizeFunction()):
+            _limits(limits), _sink(std::move(sink)), _sizeOf(std::move(sizeOf)), _bytes(0), _batchStart(),
+            _numBatches(0) {
+        if (!_sink) {
+            throw std::invalid_argument("Coalescer requires a sink");
+        }
+    }
+
+    /**
+     * Add `item` to the current batch, then emit the batch if it has reached a limit.
+     * Runtime: Amortized `O(1)`, plus that of the sink if a batch is emitted
+     * @param item Item to add.
+     * @return `true` If a batch was emitted.
+     */
+    bool add(const DataType& item) {
+        const typename Clock::time_point now = Clock::now();
+        if (_batch.isEmpty()) {
+            _batchStart = now;
+        }
+        _batch.add(item);
+        _bytes += _sizeOf ? _sizeOf(item) : sizeof(DataType);
+        if (!_isDue(now)) {
+            return false;
+        }
+        _emit();
+        return true;
+    }
+
+    /**
+     * Returns the number of bytes in the current batch.
+     * Runtime: `O(1)`
+     * @return The number of bytes.
+     */
+    size_t bytes() const noexcept {
+        return _bytes;
+    }
+
+    /**
+     * Returns when the current batch reaches its age limit, at which point `poll` emits it.
+     * Runtime: `O(1)`
+     * @return The deadline of the current batch.
+     * @throws std::logic_error If the current batch is empty or there is no age limit.
+     */
+    typename Clock::time_point deadline() const {
+        if (_batch.isEmpty() || _limits.maxAge.count() == 0) {
+            throw std::logic_error("Coalescer has no deadline");
+        }
+        return _batchStart + std::chrono::duration_cast<typename Clock::duration>(_limits.maxAge);
+    }
+
+    /**
+     * Emit the current batch now, unless it is empty.
+     * Runtime: That of the sink
+     * @return `true` If a batch was emitted.
+     */
+    bool flush() {
+        if (_batch.isEmpty()) {
+            return false;
+        }
+        _emit();
+        return true;
+    }
+
+    /**
+     * Returns the number of batches emitted so far.
+     * Runtime: `O(1)`
+     * @return The number of batches.
+     */
+    uint64_t numBatches() const noexcept {
+        return _numBatches;
+    }
+
+    /**
+     * Emit the current batch if it has reached its age limit.
+     * Runtime: `O(1)`, plus that of the sink if a batch is emitted
+     * @return `true` If a batch was emitted.
+     */
+    bool poll() {
+        if (_batch.isEmpty() || !_isDue(Clock::now())) {
+            return false;
+        }
+        _emit();
+        return true;
+    }
+
+    /**
+     * Returns the number of items in the current batch.
+     * Runtime: `O(1)`
+     * @return The number of items.
+     */
+    size_t size() const noexcept {
+        return _batch.size();
+    }
+};
+
+/**
+ * `BasicCoalescer` measuring ages with `std::chrono::steady_clock`.
+ * @param DataType The type of the items.
+ */
+template <class DataType>
+using Coalescer = BasicCoalescer<DataType, std::chrono::steady_clock>;
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef FINGERPRINTED_VECTOR_DEQUE_HPP
+#define FINGERPRINTED_VECTOR_DEQUE_HPP
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include "Hashing.hpp"
+#include "VectorDeque.hpp"
+
+/**
+ * `FingerprintedVectorDeque` is a `VectorDeque` which maintains a rolling fingerprint of its contents.
+ * The fingerprint is updated in `O(1)` on every addition or removal at either end, so it is suitable for
+ * fingerprinting the contents of a sliding window without rehashing the whole window on each slide.
+ * Two `FingerprintedVectorDeque`s with equal contents have equal fingerprints, regardless of which operations produced
+ * those contents. Note that the fingerprint is not the same value as `VectorDeque::hash`.
+ * Elements may be read through `contents()`, but must not be modified through it, since the fingerprint would not
+ * reflect the modification.
+ * @param DataType The type of the data to contain.
+ * @param Hash The function object used to hash individual elements.
+ */
+template <class DataType, class Hash = std::hash<DataType> >
+class FingerprintedVectorDeque {
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class FingerprintedVectorDequeTest;
+
+    // The elements.
+    VectorDeque<DataType> _contents;
+
+    // Hash function for individual elements.
+    Hash _elementHash;
+
+    // Rolling hash of `_contents`.
+    PolynomialRollingHash _rollingHash;
+
+    // Check to see if `*this` has at least `required` elements, so that a failing removal leaves the hash untouched.
+    // If not, throw `length_error`.
+    void _checkSize(const size_t required) const {
+        if (required > _contents.size()) {
+            throw std::length_error(std::to_string(required - 1));
+        }
+    }
+
+    public:
+    /**
+     * Constructs an empty `FingerprintedVectorDeque` with a default initial capacity.
+     * Runtime: `O(1)`
+     */
+    FingerprintedVectorDeque() {}
+
+    /**
+     * Constructs an empty `FingerprintedVectorDeque` with the given initial capacity.
+     * Runtime: `O(1)`
+     * @param capacity Initial capacity to construct with.
+     */
+    explicit FingerprintedVectorDeque(const size_t capacity): _contents(capacity) {}
+
+    /**
+     * Add `element` to the back of `*this`.
+     * Runtime: `O(1)`
+     * @param element Element to add.
+     */
+    void add(const DataType& element) {
+        _contents.add(element);
+        _rollingHash.addLast(_elementHash(element));
+    }
+
+    /**
+     * Add an array of elements to the back of `*this`.
+     * Runtime: `O(length)`
+     * @param elements Elements to add.
+     * @param length Amount of elements to add.
+     */
+    void addAll(const DataType* const elements, const size_t length) {
+        _contents.addAll(elements, length);
+        for (size_t i = 0; i < length; ++i) {
+            _rollingHash.addLast(_elementHash(elements[i]));
+        }
+    }
+
+    /**
+     * Add `element` to the front of `*this`.
+     * Runtime: `O(1)`
+     * @param element Element to add.
+     */
+    void addFirst(const DataType& element) {
+        _contents.addFirst(element);
+        _rollingHash.addFirst(_elementHash(element));
+    }
+
+    /**
+     * Remove all elements from `*this`.
+     * Runtime: `O(1)`
+     */
+    void clear() noexcept {
+        _contents.clear();
+        _rollingHash.clear();
+    }
+
+    /**
+     * Get read-only access to the elements of `*this`.
+     * Runtime: `O(1)`
+     * @return The underlying `VectorDeque`.
+     */
+    const VectorDeque<DataType>& contents() const noexcept {
+        return _contents;
+    }
+
+    /**
+     * Get the fingerprint of the current contents.
+     * Runtime: `O(1)`
+     * @return The fingerprint.
+     */
+    uint64_t fingerprint() const noexcept {
+        return _rollingHash.value();
+    }
+
+    /**
+     * Checks whether `*this` is empty.
+     * Runtime: `O(1)`
+     * @returns `true` If `size() == 0`, `false` otherwise.
+     */
+    bool isEmpty() const noexcept {
+        return _contents.isEmpty();
+    }
+
+    /**
+     * Remove and return the first element.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @return The first element.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    DataType pop() {
+        const DataType popped = _contents.pop();
+        _rollingHash.removeFirst(_elementHash(popped));
+        return popped;
+    }
+
+    /**
+     * Remove and return the last element.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @return The last element.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    DataType popLast() {
+        const DataType popped = _contents.popLast();
+        _rollingHash.removeLast(_elementHash(popped));
+        return popped;
+    }
+
+    /**
+     * Returns the number of elements in `*this`.
+     * Runtime: `O(1)`
+     * @return The number of elements in `*this`.
+     */
+    size_t size() const noexcept {
+        return _contents.size();
+    }
+
+    /**
+     * Removes `amount` elements from the front of `*this`.
+     * Runtime: `O(amount)`
+     * Exception Safety: Strong
+     * @param amount Amount of elements to remove.
+     * @throws std::length_error If `amount > size()`.
+     */
+    void skip(const size_t amount = 1) {
+        _checkSize(amount);
+        for (size_t i = 0; i < amount; ++i) {
+            _rollingHash.removeFirst(_elementHash(_contents[i]));
+        }
+        _contents.skip(amount);
+    }
+
+    /**
+     * Removes `amount` elements from the back of `*this`.
+     * Runtime: `O(amount)`
+     * Exception Safety: Strong
+     * @param amount Amount of elements to remove.
+     * @throws std::length_error If `amount > size()`.
+     */
+    void skipLast(const size_t amount = 1) {
+        _checkSize(amount);
+        for (size_t i = 0; i < amount; ++i) {
+            _rollingHash.removeLast(_elementHash(_contents.fromBack(i)));
+        }
+        _contents.skipLast(amount);
+    }
+};
+
+#endif
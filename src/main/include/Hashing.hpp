@@ -0,0 +1,228 @@
+#ifndef HASHING_HPP
+#define HASHING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * `StreamingHasher` computes a 64-bit hash over a stream of bytes fed in arbitrarily sized pieces.
+ * The result depends only on the concatenation of the bytes fed, not on how they were split up, which makes it
+ * suitable for hashing the (up to) two contiguous segments of a `VectorDeque` without first linearizing them.
+ * Bytes are consumed a 64-bit word at a time using multiply-rotate rounds in the style of xxHash.
+ */
+class StreamingHasher {
+    private:
+    static const uint64_t PRIME_1 = 0x9E3779B185EBCA87ULL;
+    static const uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    static const uint64_t PRIME_3 = 0x165667B19E3779F9ULL;
+    static const uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+    static const uint64_t PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+    // Running state.
+    uint64_t _state;
+
+    // Total number of bytes fed.
+    uint64_t _length;
+
+    // Bytes which have been fed but do not yet make up a full word.
+    unsigned char _pending[8];
+
+    // Number of valid bytes in `_pending`.
+    size_t _numPending;
+
+    static uint64_t _rotateLeft(const uint64_t value, const unsigned amount) noexcept {
+        return (value << amount) | (value >> (64 - amount));
+    }
+
+    static uint64_t _load(const unsigned char* const bytes) noexcept {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+
+    // Mix a full word into the state.
+    void _round(const uint64_t word) noexcept {
+        _state ^= _rotateLeft(word * PRIME_2, 31) * PRIME_1;
+        _state = _rotateLeft(_state, 27) * PRIME_1 + PRIME_4;
+    }
+
+    public:
+    /**
+     * Constructs a `StreamingHasher` with the given seed.
+     * Runtime: `O(1)`
+     * @param seed Seed to start hashing with.
+     */
+    explicit StreamingHasher(const uint64_t seed = 0) noexcept:
+            _state(seed + PRIME_5), _length(0), _numPending(0) {}
+
+    /**
+     * Feed `length` bytes starting at `data`.
+     * Runtime: `O(length)`
+     * @param data Bytes to feed.
+     * @param length Number of bytes to feed.
+     */
+    void update(const void* const data, size_t length) noexcept {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        _length += length;
+        if (_numPending != 0) {
+            // Complete the word left over from the previous call first.
+            const size_t numToFill = length < 8 - _numPending ? length : 8 - _numPending;
+            std::memcpy(_pending + _numPending, bytes, numToFill);
+            _numPending += numToFill;
+            bytes += numToFill;
+            length -= numToFill;
+            if (_numPending < 8) {
+                return;
+            }
+            _round(_load(_pending));
+            _numPending = 0;
+        }
+        const unsigned char* const end = bytes + (length & ~static_cast<size_t>(7));
+        for (; bytes != end; bytes += 8) {
+            _round(_load(bytes));
+        }
+        _numPending = length & 7;
+        std::memcpy(_pending, bytes, _numPending);
+    }
+
+    /**
+     * Feed a single 64-bit word. Equivalent to feeding its 8 bytes.
+     * Runtime: `O(1)`
+     * @param word Word to feed.
+     */
+    void updateWord(const uint64_t word) noexcept {
+        if (_numPending == 0) {
+            _length += 8;
+            _round(word);
+        } else {
+            update(&word, sizeof(word));
+        }
+    }
+
+    /**
+     * Compute the hash of every byte fed so far. This does not modify the state, so more bytes may be fed after.
+     * Runtime: `O(1)`
+     * @return The hash.
+     */
+    uint64_t digest() const noexcept {
+        uint64_t result = _state + _length;
+        for (size_t i = 0; i < _numPending; ++i) {
+            result ^= _pending[i] * PRIME_5;
+            result = _rotateLeft(result, 11) * PRIME_1;
+        }
+        // Final avalanche.
+        result ^= result >> 33;
+        result *= PRIME_2;
+        result ^= result >> 29;
+        result *= PRIME_3;
+        result ^= result >> 32;
+        return result;
+    }
+
+    /**
+     * Scramble a 64-bit value so that every input bit affects every output bit. Used to spread weak element hashes
+     * (such as the identity hash of `std::hash<int>`) before they are combined.
+     * Runtime: `O(1)`
+     * @param value Value to scramble.
+     * @return The scrambled value.
+     */
+    static uint64_t mix(uint64_t value) noexcept {
+        value ^= value >> 33;
+        value *= PRIME_2;
+        value ^= value >> 29;
+        value *= PRIME_3;
+        value ^= value >> 32;
+        return value;
+    }
+};
+
+/**
+ * `PolynomialRollingHash` maintains the polynomial hash `h[0] * B^(n - 1) + h[1] * B^(n - 2) + ... + h[n - 1]`
+ * (modulo `2^64`) of a sequence of `n` element hashes, and supports adding and removing element hashes at either
+ * end in `O(1)`. Since `B` is odd, it is invertible modulo `2^64`, which is what allows removal from the back.
+ * The value only depends on the current sequence, not on the order of operations which produced it.
+ */
+class PolynomialRollingHash {
+    private:
+    static const uint64_t BASE = 0x100000001B3ULL;
+
+    // Multiplicative inverse of `BASE` modulo `2^64`, so that removals cost a multiplication.
+    static const uint64_t BASE_INVERSE = 0xCE965057AFF6957BULL;
+    static_assert(BASE * BASE_INVERSE == 1, "BASE_INVERSE is not the inverse of BASE");
+
+    // Current hash.
+    uint64_t _hash;
+
+    // `BASE` raised to the number of elements currently hashed.
+    uint64_t _power;
+
+    public:
+    /**
+     * Constructs a `PolynomialRollingHash` of the empty sequence.
+     * Runtime: `O(1)`
+     */
+    PolynomialRollingHash() noexcept: _hash(0), _power(1) {}
+
+    /**
+     * Append `elementHash` to the back of the sequence.
+     * Runtime: `O(1)`
+     * @param elementHash Hash of the element to append.
+     */
+    void addLast(const uint64_t elementHash) noexcept {
+        _hash = _hash * BASE + StreamingHasher::mix(elementHash);
+        _power *= BASE;
+    }
+
+    /**
+     * Prepend `elementHash` to the front of the sequence.
+     * Runtime: `O(1)`
+     * @param elementHash Hash of the element to prepend.
+     */
+    void addFirst(const uint64_t elementHash) noexcept {
+        _hash += StreamingHasher::mix(elementHash) * _power;
+        _power *= BASE;
+    }
+
+    /**
+     * Remove `elementHash` from the front of the sequence.
+     * The result is meaningless unless `elementHash` is the hash of the current first element.
+     * Runtime: `O(1)`
+     * @param elementHash Hash of the first element.
+     */
+    void removeFirst(const uint64_t elementHash) noexcept {
+        _power *= BASE_INVERSE;
+        _hash -= StreamingHasher::mix(elementHash) * _power;
+    }
+
+    /**
+     * Remove `elementHash` from the back of the sequence.
+     * The result is meaningless unless `elementHash` is the hash of the current last element.
+     * Runtime: `O(1)`
+     * @param elementHash Hash of the last element.
+     */
+    void removeLast(const uint64_t elementHash) noexcept {
+        _hash = (_hash - StreamingHasher::mix(elementHash)) * BASE_INVERSE;
+        _power *= BASE_INVERSE;
+    }
+
+    /**
+     * Reset to the hash of the empty sequence.
+     * Runtime: `O(1)`
+     */
+    void clear() noexcept {
+        _hash = 0;
+        _power = 1;
+    }
+
+    /**
+     * Get the hash of the current sequence.
+     * Runtime: `O(1)`
+     * @return The hash.
+     */
+    uint64_t value() const noexcept {
+        return _hash;
+    }
+};
+
+#endif
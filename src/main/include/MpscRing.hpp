@@ -0,0 +1,230 @@
+#ifndef MPSC_RING_HPP
+#define MPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "VectorDeque.hpp"
+
+/**
+ * `MpscRing` is a fixed capacity ring buffer which any number of producer threads add to and a single consumer thread
+ * drains, such as the buffer behind a logger.
+ * A producer reserves its slots with a single `fetch_add` on the tail, writes its elements and then marks each slot
+ * as committed through a per-slot sequence number, so producers never take a lock and never wait for each other.
+ * The consumer takes the run of committed slots at the head as at most two contiguous segments, like those of a
+ * `VectorDeque`. A producer which stalls between reserving and committing only holds back the slots after its own:
+ * the consumer still drains everything before them.
+ * @param DataType The type of the data to contain. Must be default constructible and assignable, since every slot
+ * holds an element.
+ */
+template <class DataType>
+class MpscRing {
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class MpscRingTest;
+
+    // Size of a cache line, used to keep the fields written by producers apart from those written by the consumer.
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    // Number of slots, a power of two.
+    const size_t _capacity;
+
+    // `_capacity - 1`, to wrap tickets into slot indices.
+    const size_t _mask;
+
+    // The stored data.
+    DataType* const _data;
+
+    // Sequence number of each slot. For the slot of ticket `t`, it is `t` while the slot is free for the producer of
+    // `t`, and `t + 1` once that producer has committed it. Releasing it makes it `t + _capacity`, the ticket of the
+    // next producer to use it.
+    std::atomic<size_t>* const _sequences;
+
+    char _padding1[CACHE_LINE_SIZE];
+
+    // Ticket of the next slot to reserve. Written by producers.
+    std::atomic<size_t> _tail;
+
+    char _padding2[CACHE_LINE_SIZE];
+
+    // Ticket of the first unreleased slot. Only accessed by the consumer.
+    size_t _head;
+
+    // Compute the capacity to use for `capacity` slots: the next power of two, and at least 2 so that the free and
+    // committed sequence numbers of a slot differ.
+    static size_t _roundCapacity(const size_t capacity) {
+        if (capacity > (~static_cast<size_t>(0) >> 1) + 1) {
+            throw std::length_error("MpscRing capacity too large: " + std::to_string(capacity));
+        }
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    static std::atomic<size_t>* _newSequences(const size_t capacity) {
+        std::atomic<size_t>* const sequences = new std::atomic<size_t>[capacity];
+        for (size_t i = 0; i < capacity; ++i) {
+            sequences[i].store(i, std::memory_order_relaxed);
+        }
+        return sequences;
+    }
+
+    // Write `value` to the slot of `ticket` once it is free, and commit it.
+    template <class Value>
+    void _write(const size_t ticket, Value&& value) {
+        const size_t index = ticket & _mask;
+        while (_sequences[index].load(std::memory_order_acquire) != ticket) {
+            // The ring is full: wait for the consumer to release the slot.
+            std::this_thread::yield();
+        }
+        _data[index] = std::forward<Value>(value);
+        _sequences[index].store(ticket + 1, std::memory_order_release);
+    }
+
+    public:
+    /**
+     * Constructs an empty `MpscRing` with at least `capacity` slots.
+     * Runtime: `O(capacity)`
+     * @param capacity The minimum number of slots. Rounded up to a power of two, and to at least 2.
+     * @throws std::length_error If `capacity` is larger than the largest power of two a `size_t` can hold.
+     */
+    explicit MpscRing(const size_t capacity): _capacity(_roundCapacity(capacity)), _mask(_capacity - 1),
+            _data(new DataType[_capacity]), _sequences(_newSequences(_capacity)), _tail(0), _head(0) {}
+
+    MpscRing(const MpscRing&) = delete;
+
+    MpscRing& operator =(const MpscRing&) = delete;
+
+    /**
+     * Destructs this `MpscRing`. No producer may be using it.
+     * Runtime: `O(capacity)`
+     */
+    ~MpscRing() {
+        delete[] _sequences;
+        delete[] _data;
+    }
+
+    /**
+     * Returns the number of slots.
+     * Runtime: `O(1)`
+     * @return The number of slots.
+     */
+    size_t capacity() const noexcept {
+        return _capacity;
+    }
+
+    /**
+     * Get the run of committed slots at the head as at most two contiguous segments, without releasing them. The run
+     * ends at the first slot which is free or still being written. Must only be called by the consumer.
+     * Runtime: `O(number of committed slots)`
+     * @return The committed elements, in the order their slots were reserved. They may be moved from.
+     */
+    VectorDequeSegments<DataType> committed() noexcept {
+        size_t length = 0;
+        while (length < _capacity
+                && _sequences[(_head + length) & _mask].load(std::memory_order_acquire) == _head + length + 1) {
+            ++length;
+        }
+        const size_t index = _head & _mask;
+        const size_t firstLength = length < _capacity - index ? length : _capacity - index;
+        VectorDequeSegments<DataType> segments;
+        segments.first.data = _data + index;
+        segments.first.length = firstLength;
+        segments.second.data = _data;
+        segments.second.length = length - firstLength;
+        return segments;
+    }
+
+    /**
+     * Pass the run of committed slots at the head to `consumer`, one contiguous segment at a time, then release them.
+     * Must only be called by the consumer.
+     * Runtime: `O(number of committed slots)` plus that of `consumer`
+     * @param consumer Function called with a `DataType*` to the first element and the number of elements of each
+     * non-empty segment. The elements may be moved from.
+     * @return The number of elements drained.
+     */
+    template <class Consumer>
+    size_t drain(Consumer&& consumer) {
+        const VectorDequeSegments<DataType> segments = committed();
+        if (segments.first.size() > 0) {
+            consumer(segments.first.data, segments.first.size());
+        }
+        if (segments.second.size() > 0) {
+            consumer(segments.second.data, segments.second.size());
+        }
+        const size_t length = segments.first.size() + segments.second.size();
+        release(length);
+        return length;
+    }
+
+    /**
+     * Adds `value` to this. If the ring is full, waits for the consumer to release the reserved slot.
+     * Runtime: `O(1)` if the ring is not full
+     * @param value Element to add.
+     */
+    template <class Value>
+    void push(Value&& value) {
+        _write(_tail.fetch_add(1, std::memory_order_relaxed), std::forward<Value>(value));
+    }
+
+    /**
+     * Adds `amount` elements from `array` to this in one contiguous run of slots, reserved with a single `fetch_add`.
+     * The elements are committed one by one, so the consumer can drain the first ones while the rest are written.
+     * If the ring is full, waits for the consumer to release the slots needed.
+     * Runtime: `O(amount)` if the ring has room for `amount` elements
+     * @param array Array of elements to add.
+     * @param amount The number of elements to add.
+     */
+    void pushAll(const DataType* const array, const size_t amount) {
+        const size_t ticket = _tail.fetch_add(amount, std::memory_order_relaxed);
+        for (size_t i = 0; i < amount; ++i) {
+            _write(ticket + i, array[i]);
+        }
+    }
+
+    /**
+     * Release the first `amount` committed slots, making them available to producers again. Must only be called by
+     * the consumer.
+     * Runtime: `O(amount)`
+     * @param amount The number of slots to release.
+     * @throws std::invalid_argument If fewer than `amount` slots at the head are committed.
+     */
+    void release(const size_t amount) {
+        for (size_t i = 0; i < amount; ++i) {
+            if (_sequences[(_head + i) & _mask].load(std::memory_order_relaxed) != _head + i + 1) {
+                throw std::invalid_argument("Cannot release " + std::to_string(amount) + " slots: only "
+                        + std::to_string(i) + " are committed");
+            }
+        }
+        for (size_t i = 0; i < amount; ++i) {
+            _sequences[(_head + i) & _mask].store(_head + i + _capacity, std::memory_order_release);
+        }
+        _head += amount;
+    }
+
+    /**
+     * Adds `value` to this if the ring has room for it. Unlike `push`, this reserves the slot with a compare and
+     * exchange rather than a `fetch_add`, so that a failed attempt reserves nothing.
+     * Runtime: `O(1)` if uncontended
+     * @param value Element to add.
+     * @return `true` If `value` was added, `false` if the ring was full.
+     */
+    template <class Value>
+    bool tryPush(Value&& value) {
+        size_t ticket = _tail.load(std::memory_order_relaxed);
+        do {
+            if (_sequences[ticket & _mask].load(std::memory_order_acquire) != ticket) {
+                return false;
+            }
+        } while (!_tail.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed));
+        _write(ticket, std::forward<Value>(value));
+        return true;
+    }
+};
+
+#endif
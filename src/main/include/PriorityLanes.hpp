@@ -0,0 +1,219 @@
+#ifndef PRIORITY_LANES_HPP
+#define PRIORITY_LANES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "VectorDeque.hpp"
+
+/**
+ * `PriorityLanes` is a queue of `NUM_LANES` priority levels, such as the run queue of a scheduler. Each lane is a
+ * `VectorDeque` in FIFO order, and a bitmap with one bit per lane records which lanes are non-empty. Removals always
+ * take from the highest non-empty lane, which is found from the bitmap with a single count-leading-zeros instruction
+ * instead of scanning the lanes.
+ * @param DataType The type of the data to contain.
+ * @param NUM_LANES The number of priority levels, at most 64. Lane `NUM_LANES - 1` has the highest priority.
+ */
+template <class DataType, size_t NUM_LANES>
+class PriorityLanes {
+    static_assert(NUM_LANES >= 1 && NUM_LANES <= 64, "PriorityLanes supports from 1 to 64 lanes");
+
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class PriorityLanesTest;
+
+    VectorDeque<DataType> _lanes[NUM_LANES];
+
+    // Bit `i` is set if and only if lane `i` is non-empty.
+    uint64_t _nonEmpty;
+
+    // Total number of elements in all lanes.
+    size_t _size;
+
+    // Index of the highest set bit of `bits`, which must not be zero.
+    static size_t _highestBit(const uint64_t bits) noexcept {
+#if defined(__GNUC__)
+        return 63 - static_cast<size_t>(__builtin_clzll(bits));
+#else
+        size_t bit = 0;
+        for (uint64_t rest = bits >> 1; rest != 0; rest >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static void _checkLane(const size_t lane) {
+        if (lane >= NUM_LANES) {
+            throw std::length_error("Lane " + std::to_string(lane) + " does not exist");
+        }
+    }
+
+    // Check to see if there are at least `required` elements.
+    // If not, throw `length_error`.
+    void _checkSize(const size_t required) const {
+        if (required > _size) {
+            throw std::length_error("Cannot remove " + std::to_string(required) + " elements from PriorityLanes of size "
+                    + std::to_string(_size));
+        }
+    }
+
+    // Pop the first element of the non-empty `lane`, keeping the bitmap up to date.
+    DataType _popFrom(const size_t lane) {
+        const DataType element = _lanes[lane].pop();
+        --_size;
+        if (_lanes[lane].isEmpty()) {
+            _nonEmpty &= ~(static_cast<uint64_t>(1) << lane);
+        }
+        return element;
+    }
+
+    public:
+    /**
+     * Constructs an empty `PriorityLanes`.
+     * Runtime: `O(NUM_LANES)`
+     */
+    PriorityLanes(): _nonEmpty(0), _size(0) {}
+
+    /**
+     * Add `element` to the back of `lane`.
+     * Runtime: Amortized `O(1)`
+     * @param element Element to add.
+     * @param lane The priority of the element.
+     * @throws std::length_error If `lane >= NUM_LANES`.
+     */
+    void add(const DataType& element, const size_t lane) {
+        _checkLane(lane);
+        _lanes[lane].add(element);
+        ++_size;
+        _nonEmpty |= static_cast<uint64_t>(1) << lane;
+    }
+
+    /**
+     * Add an array of elements to the back of `lane`.
+     * Runtime: Amortized `O(length)`
+     * @param elements Elements to add.
+     * @param length Amount of elements to add.
+     * @param lane The priority of the elements.
+     * @throws std::length_error If `lane >= NUM_LANES`.
+     */
+    void addAll(const DataType* const elements, const size_t length, const size_t lane) {
+        _checkLane(lane);
+        if (length == 0) {
+            return;
+        }
+        _lanes[lane].addAll(elements, length);
+        _size += length;
+        _nonEmpty |= static_cast<uint64_t>(1) << lane;
+    }
+
+    /**
+     * Remove every element from every lane.
+     * Runtime: `O(NUM_LANES)`
+     */
+    void clear() noexcept {
+        for (size_t i = 0; i < NUM_LANES; ++i) {
+            _lanes[i].clear();
+        }
+        _nonEmpty = 0;
+        _size = 0;
+    }
+
+    /**
+     * Returns the highest non-empty lane.
+     * Runtime: `O(1)`
+     * @return Index of the highest non-empty lane.
+     * @throws std::length_error If every lane is empty.
+     */
+    size_t highestLane() const {
+        _checkSize(1);
+        return _highestBit(_nonEmpty);
+    }
+
+    /**
+     * Returns whether every lane is empty.
+     * Runtime: `O(1)`
+     * @return `true` If there are no elements, `false` otherwise.
+     */
+    bool isEmpty() const noexcept {
+        return _size == 0;
+    }
+
+    /**
+     * Get the deque of lane `lane`.
+     * Runtime: `O(1)`
+     * @param lane Index of the lane.
+     * @return The elements of the lane, from first to last.
+     * @throws std::length_error If `lane >= NUM_LANES`.
+     */
+    const VectorDeque<DataType>& lane(const size_t lane) const {
+        _checkLane(lane);
+        return _lanes[lane];
+    }
+
+    /**
+     * Returns the bitmap of non-empty lanes, whose bit `i` is set if and only if lane `i` is non-empty.
+     * Runtime: `O(1)`
+     * @return The bitmap.
+     */
+    uint64_t nonEmptyLanes() const noexcept {
+        return _nonEmpty;
+    }
+
+    /**
+     * Get the first element of the highest non-empty lane without removing it.
+     * Runtime: `O(1)`
+     * @return The element which `pop` would return.
+     * @throws std::length_error If every lane is empty.
+     */
+    DataType peek() const {
+        return _lanes[highestLane()].peek();
+    }
+
+    /**
+     * Remove and return the first element of the highest non-empty lane.
+     * Runtime: `O(1)`
+     * @return The removed element.
+     * @throws std::length_error If every lane is empty.
+     */
+    DataType pop() {
+        return _popFrom(highestLane());
+    }
+
+    /**
+     * Remove `amount` elements and put them into `target`, as if by `amount` calls to `pop`: the highest lane is
+     * emptied first, and the batch continues into lower lanes as needed. Each lane's elements are moved in bulk.
+     * Runtime: `O(amount + number of lanes spanned)`
+     * @param target Array to put removed elements into.
+     * @param amount Number of elements to remove.
+     * @throws std::length_error If `size() < amount`.
+     */
+    void popSome(DataType* target, size_t amount) {
+        _checkSize(amount);
+        while (amount > 0) {
+            const size_t lane = _highestBit(_nonEmpty);
+            VectorDeque<DataType>& deque = _lanes[lane];
+            const size_t numTaken = amount < deque.size() ? amount : deque.size();
+            deque.popSome(target, numTaken);
+            if (deque.isEmpty()) {
+                _nonEmpty &= ~(static_cast<uint64_t>(1) << lane);
+            }
+            target += numTaken;
+            amount -= numTaken;
+            _size -= numTaken;
+        }
+    }
+
+    /**
+     * Returns the total number of elements in all lanes.
+     * Runtime: `O(1)`
+     * @return The number of elements.
+     */
+    size_t size() const noexcept {
+        return _size;
+    }
+};
+
+#endif
@@ -0,0 +1,228 @@
+#ifndef ROLLING_HASH_DEQUE_HPP
+#define ROLLING_HASH_DEQUE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "VectorDeque.hpp"
+
+/**
+ * `RollingHashDeque` keeps a window of the most recent bytes of a stream together with a Buzhash (cyclic polynomial)
+ * rolling hash of that window, which is updated in `O(1)` whenever a byte enters or leaves the window.
+ * It also performs content-defined chunking: `feed` processes whole blocks of input and reports the stream offsets at
+ * which the window hash marks a chunk boundary. Since boundaries only depend on the bytes of the stream, the same
+ * boundaries are found no matter how the stream is split into blocks.
+ */
+class RollingHashDeque {
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class RollingHashDequeTest;
+
+    // The window of most recent bytes, oldest first.
+    VectorDeque<uint8_t> _window;
+
+    // Maximum number of bytes in `_window`.
+    size_t _windowSize;
+
+    // Hash of `_window`.
+    uint64_t _hash;
+
+    // A boundary may be declared when the low bits selected by this mask are all zero.
+    uint64_t _boundaryMask;
+
+    // Chunks are never shorter than this, except possibly the last one.
+    size_t _minChunkSize;
+
+    // Chunks are never longer than this.
+    size_t _maxChunkSize;
+
+    // Number of bytes passed to `feed` since construction or the last `clear`.
+    uint64_t _bytesFed;
+
+    // Number of bytes fed since the last boundary.
+    size_t _chunkLength;
+
+    static uint64_t _rotateLeft(const uint64_t value, const size_t amount) noexcept {
+        const unsigned shift = amount & 63;
+        return shift == 0 ? value : (value << shift) | (value >> (64 - shift));
+    }
+
+    // Random value assigned to each byte, generated once with splitmix64.
+    static const uint64_t* _table() noexcept {
+        struct Table {
+            uint64_t values[256];
+
+            Table() noexcept {
+                uint64_t state = 0;
+                for (size_t i = 0; i < 256; ++i) {
+                    state += 0x9E3779B97F4A7C15ULL;
+                    uint64_t value = state;
+                    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+                    values[i] = value ^ (value >> 31);
+                }
+            }
+        };
+        static const Table table;
+        return table.values;
+    }
+
+    // Account for one more fed byte and record a boundary after it if the hash calls for one.
+    void _advanceChunk(const uint64_t offset, std::vector<uint64_t>& boundaries) {
+        ++_chunkLength;
+        if (_chunkLength >= _maxChunkSize || (_chunkLength >= _minChunkSize && (_hash & _boundaryMask) == 0)) {
+            boundaries.push_back(offset);
+            _chunkLength = 0;
+        }
+    }
+
+    public:
+    /**
+     * Constructs an empty `RollingHashDeque`.
+     * Runtime: `O(windowSize)`
+     * @param windowSize Number of bytes the rolling hash covers.
+     * @param boundaryBits Number of low hash bits which must be zero for a boundary. Chunks average about
+     *                     `2^boundaryBits` bytes.
+     * @param minChunkSize Minimum length of a chunk.
+     * @param maxChunkSize Maximum length of a chunk.
+     * @throws std::invalid_argument If `windowSize == 0`, `boundaryBits > 63`, `minChunkSize == 0` or
+     *         `minChunkSize > maxChunkSize`.
+     */
+    explicit RollingHashDeque(const size_t windowSize = 48, const unsigned boundaryBits = 13,
+            const size_t minChunkSize = 2048, const size_t maxChunkSize = 65536):
+            _window(windowSize), _windowSize(windowSize), _hash(0),
+            _boundaryMask((static_cast<uint64_t>(1) << (boundaryBits & 63)) - 1), _minChunkSize(minChunkSize),
+            _maxChunkSize(maxChunkSize), _bytesFed(0), _chunkLength(0) {
+        if (windowSize == 0 || boundaryBits > 63 || minChunkSize == 0 || minChunkSize > maxChunkSize) {
+            throw std::invalid_argument("Bad chunking parameters");
+        }
+    }
+
+    /**
+     * Add `byte` to the window, evicting the oldest byte if the window is full.
+     * Bytes added this way are not part of the stream used for chunking.
+     * Runtime: `O(1)`
+     * @param byte Byte to add.
+     */
+    void add(const uint8_t byte) noexcept {
+        if (_window.size() == _windowSize) {
+            pop();
+        }
+        _hash = _rotateLeft(_hash, 1) ^ _table()[byte];
+        _window.add(byte);
+    }
+
+    /**
+     * Empty the window and restart the stream, so that the next fed byte has offset `0`.
+     * Runtime: `O(1)`
+     */
+    void clear() noexcept {
+        _window.clear();
+        _hash = 0;
+        _bytesFed = 0;
+        _chunkLength = 0;
+    }
+
+    /**
+     * Feed a block of the stream, sliding each byte through the window and recording chunk boundaries.
+     * A boundary is recorded as the stream offset just past the last byte of a chunk.
+     * Runtime: `O(length)`
+     * @param data Bytes to feed.
+     * @param length Number of bytes to feed.
+     * @param boundaries Vector to append the boundaries found to.
+     * @return The number of boundaries found.
+     */
+    size_t feed(const uint8_t* const data, const size_t length, std::vector<uint64_t>& boundaries) {
+        const size_t numBoundariesBefore = boundaries.size();
+        const uint64_t* const table = _table();
+        size_t i = 0;
+        // Until the window is full, bytes only enter.
+        for (; i < length && _window.size() < _windowSize; ++i) {
+            _hash = _rotateLeft(_hash, 1) ^ table[data[i]];
+            _window.add(data[i]);
+            _advanceChunk(_bytesFed + i + 1, boundaries);
+        }
+        const size_t start = i;
+        // Once full, each entering byte evicts the byte `_windowSize` positions before it. Those bytes are first found
+        // in the ring and then in `data` itself, so the ring only has to be updated once at the end.
+        for (; i < length; ++i) {
+            const size_t numSlid = i - start;
+            const uint8_t evicted = numSlid < _windowSize ? _window[numSlid] : data[i - _windowSize];
+            _hash = _rotateLeft(_hash, 1) ^ _rotateLeft(table[evicted], _windowSize) ^ table[data[i]];
+            _advanceChunk(_bytesFed + i + 1, boundaries);
+        }
+        const size_t numSlid = length - start;
+        if (numSlid >= _windowSize) {
+            _window.clear();
+            _window.addAll(data + length - _windowSize, _windowSize);
+        } else {
+            _window.skip(numSlid);
+            _window.addAll(data + start, numSlid);
+        }
+        _bytesFed += length;
+        return boundaries.size() - numBoundariesBefore;
+    }
+
+    /**
+     * Get the hash of the current window.
+     * Runtime: `O(1)`
+     * @return The hash.
+     */
+    uint64_t hash() const noexcept {
+        return _hash;
+    }
+
+    /**
+     * Checks whether the window holds `windowSize()` bytes.
+     * Runtime: `O(1)`
+     * @return `true` If the window is full, `false` otherwise.
+     */
+    bool isFull() const noexcept {
+        return _window.size() == _windowSize;
+    }
+
+    /**
+     * Remove and return the oldest byte in the window.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @return The oldest byte.
+     * @throws std::length_error If the window is empty.
+     */
+    uint8_t pop() {
+        const uint8_t popped = _window.pop();
+        // The oldest byte has been rotated once for every byte after it.
+        _hash ^= _rotateLeft(_table()[popped], _window.size());
+        return popped;
+    }
+
+    /**
+     * Returns the number of bytes in the window.
+     * Runtime: `O(1)`
+     * @return The number of bytes in the window.
+     */
+    size_t size() const noexcept {
+        return _window.size();
+    }
+
+    /**
+     * Get read-only access to the bytes in the window, oldest first.
+     * Runtime: `O(1)`
+     * @return The window.
+     */
+    const VectorDeque<uint8_t>& window() const noexcept {
+        return _window;
+    }
+
+    /**
+     * Returns the maximum number of bytes in the window.
+     * Runtime: `O(1)`
+     * @return The window size.
+     */
+    size_t windowSize() const noexcept {
+        return _windowSize;
+    }
+};
+
+#endif
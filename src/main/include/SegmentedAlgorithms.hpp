@@ -0,0 +1,1103 @@
+#ifndef SEGMENTED_ALGORITHMS_HPP
+#define SEGMENTED_ALGORITHMS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * Algorithms which recognize segmented iterators: iterators whose ranges are made up of a few contiguous segments,
+ * such as those of `VectorDeque`. For these, each segment is processed with a plain pointer loop (which the standard
+ * library lowers to `memmove`, `memset` or a vectorized search where it can) instead of stepping through the iterator,
+ * which has to wrap its index on every access. Any other iterator falls back to the corresponding `std::` algorithm.
+ *
+ * The scans (prefix sums) carry the running total from one segment into the next, and use SSE2 kernels for segments of
+ * 32 and 64 bit integers, `float` and `double` where available. Like `std::inclusive_scan`, the SIMD kernels add in a
+ * different order than a sequential loop, so floating point results may differ in rounding.
+ *
+ * The stream compactions (`segmentedCopyIf`, `segmentedPartition` and `segmentedRemoveIf`) work on blocks of
+ * arithmetic elements without branching on the predicate, which is slow to predict when elements are selected at
+ * random. A `Comparison` predicate is evaluated a vector at a time, and the selected lanes are stored with `vpcompress`
+ * under AVX-512 or with a permutation table under AVX2. Which kernels are used is decided at compile time.
+ */
+
+/**
+ * Whether `IteratorType` is segmented, meaning `it.segmentsUntil(end)` gives the contiguous segments of the range
+ * `[it, end)` as `first` and `second` members which have `begin()`, `end()` and `size()`.
+ * @param IteratorType The type of iterator to check.
+ */
+template <class IteratorType>
+class IsSegmentedIterator {
+    private:
+    template <class Type>
+    static std::true_type _check(decltype(std::declval<const Type&>().segmentsUntil(std::declval<const Type&>()))*);
+
+    template <class Type>
+    static std::false_type _check(...);
+
+    public:
+    static const bool value = decltype(_check<IteratorType>(nullptr))::value;
+};
+
+/**
+ * The comparison made by a `Comparison` predicate.
+ */
+enum ComparisonOperator {
+    COMPARE_EQUAL = 0,
+    COMPARE_NOT_EQUAL = 1,
+    COMPARE_LESS = 2,
+    COMPARE_LESS_EQUAL = 3,
+    COMPARE_GREATER = 4,
+    COMPARE_GREATER_EQUAL = 5
+};
+
+/**
+ * Predicate comparing elements to a value, such as `element < 10`. `segmentedCopyIf`, `segmentedPartition` and
+ * `segmentedRemoveIf` recognize it and evaluate it on whole vectors of arithmetic elements when SIMD kernels are
+ * available, where any other predicate has to be called element by element.
+ * @param DataType The type of the elements compared.
+ */
+template <class DataType>
+struct Comparison {
+    ComparisonOperator op;
+
+    // The value the elements are compared to, on the right hand side.
+    DataType value;
+
+    Comparison(const ComparisonOperator op, const DataType& value): op(op), value(value) {}
+
+    bool operator ()(const DataType& element) const {
+        switch (op) {
+            case COMPARE_EQUAL:
+                return element == value;
+            case COMPARE_NOT_EQUAL:
+                return element != value;
+            case COMPARE_LESS:
+                return element < value;
+            case COMPARE_LESS_EQUAL:
+                return element <= value;
+            case COMPARE_GREATER:
+                return element > value;
+            default:
+                return element >= value;
+        }
+    }
+};
+
+namespace vector_deque_detail {
+    template <class InputIterator, class OutputIterator>
+    OutputIterator segmentedCopy(InputIterator begin, InputIterator end, OutputIterator out, std::true_type) {
+        const auto segments = begin.segmentsUntil(end);
+        out = std::copy(segments.first.begin(), segments.first.end(), out);
+        return std::copy(segments.second.begin(), segments.second.end(), out);
+    }
+
+    template <class InputIterator, class OutputIterator>
+    OutputIterator segmentedCopy(InputIterator begin, InputIterator end, OutputIterator out, std::false_type) {
+        return std::copy(begin, end, out);
+    }
+
+    template <class ForwardIterator, class DataType>
+    void segmentedFill(ForwardIterator begin, ForwardIterator end, const DataType& value, std::true_type) {
+        const auto segments = begin.segmentsUntil(end);
+        std::fill(segments.first.begin(), segments.first.end(), value);
+        std::fill(segments.second.begin(), segments.second.end(), value);
+    }
+
+    template <class ForwardIterator, class DataType>
+    void segmentedFill(ForwardIterator begin, ForwardIterator end, const DataType& value, std::false_type) {
+        std::fill(begin, end, value);
+    }
+
+    template <class InputIterator, class DataType>
+    InputIterator segmentedFind(InputIterator begin, InputIterator end, const DataType& value, std::true_type) {
+        const auto segments = begin.segmentsUntil(end);
+        const auto inFirst = std::find(segments.first.begin(), segments.first.end(), value);
+        if (inFirst != segments.first.end()) {
+            return begin + (inFirst - segments.first.begin());
+        }
+        const auto inSecond = std::find(segments.second.begin(), segments.second.end(), value);
+        return begin + segments.first.size() + (inSecond - segments.second.begin());
+    }
+
+    template <class InputIterator, class DataType>
+    InputIterator segmentedFind(InputIterator begin, InputIterator end, const DataType& value, std::false_type) {
+        return std::find(begin, end, value);
+    }
+}
+
+namespace vector_deque_detail {
+    // Minimum number of elements given to each thread by the parallel scans, below which the cost of starting a thread
+    // outweighs the gain.
+    const size_t PARALLEL_SCAN_MIN_CHUNK = 1 << 14;
+
+    // Scan `length` elements from `in` to `out` one at a time, adding to `total`. `in` and `out` may be the same.
+    template <bool INCLUSIVE, class DataType, class OutputIterator>
+    OutputIterator scalarScan(const DataType* in, const size_t length, OutputIterator out, DataType& total) {
+        for (size_t i = 0; i < length; ++i, ++out) {
+            if (INCLUSIVE) {
+                total = total + in[i];
+                *out = total;
+            } else {
+                // Copied first, since writing to `out` may overwrite it.
+                const DataType element = in[i];
+                *out = total;
+                total = total + element;
+            }
+        }
+        return out;
+    }
+
+#if defined(__SSE2__)
+    // Lane operations used by `simdScan`, one struct per kind of lane. `prefix` gives the prefix sum of the lanes of a
+    // vector, `shiftOne` moves every lane up by one shifting in zero, and `broadcastLast` copies the last lane to all.
+    template <class DataType>
+    struct Sse2Int32Lanes {
+        typedef __m128i Vector;
+        static const size_t LANES = 4;
+
+        static Vector add(const Vector a, const Vector b) { return _mm_add_epi32(a, b); }
+        static Vector broadcastLast(const Vector v) { return _mm_shuffle_epi32(v, 0xFF); }
+        static Vector load(const DataType* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static Vector prefix(Vector v) {
+            v = add(v, _mm_slli_si128(v, 4));
+            return add(v, _mm_slli_si128(v, 8));
+        }
+        static Vector shiftOne(const Vector v) { return _mm_slli_si128(v, 4); }
+        static void store(DataType* p, const Vector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static Vector splat(const DataType value) {
+            int32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return _mm_set1_epi32(bits);
+        }
+    };
+
+    template <class DataType>
+    struct Sse2Int64Lanes {
+        typedef __m128i Vector;
+        static const size_t LANES = 2;
+
+        static Vector add(const Vector a, const Vector b) { return _mm_add_epi64(a, b); }
+        static Vector broadcastLast(const Vector v) { return _mm_shuffle_epi32(v, 0xEE); }
+        static Vector load(const DataType* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        static Vector prefix(const Vector v) { return add(v, _mm_slli_si128(v, 8)); }
+        static Vector shiftOne(const Vector v) { return _mm_slli_si128(v, 8); }
+        static void store(DataType* p, const Vector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+        static Vector splat(const DataType value) {
+            int64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return _mm_set1_epi64x(bits);
+        }
+    };
+
+    struct Sse2FloatLanes {
+        typedef __m128 Vector;
+        static const size_t LANES = 4;
+
+        static Vector add(const Vector a, const Vector b) { return _mm_add_ps(a, b); }
+        static Vector broadcastLast(const Vector v) { return _mm_shuffle_ps(v, v, 0xFF); }
+        static Vector load(const float* p) { return _mm_loadu_ps(p); }
+        static Vector prefix(Vector v) {
+            v = add(v, shiftOne(v));
+            return add(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+        }
+        static Vector shiftOne(const Vector v) { return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)); }
+        static void store(float* p, const Vector v) { _mm_storeu_ps(p, v); }
+        static Vector splat(const float value) { return _mm_set1_ps(value); }
+    };
+
+    struct Sse2DoubleLanes {
+        typedef __m128d Vector;
+        static const size_t LANES = 2;
+
+        static Vector add(const Vector a, const Vector b) { return _mm_add_pd(a, b); }
+        static Vector broadcastLast(const Vector v) { return _mm_unpackhi_pd(v, v); }
+        static Vector load(const double* p) { return _mm_loadu_pd(p); }
+        static Vector prefix(const Vector v) { return add(v, shiftOne(v)); }
+        static Vector shiftOne(const Vector v) { return _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(v), 8)); }
+        static void store(double* p, const Vector v) { _mm_storeu_pd(p, v); }
+        static Vector splat(const double value) { return _mm_set1_pd(value); }
+    };
+
+    // The lane operations to scan `DataType` with, or `void` if it is scanned one element at a time.
+    template <class DataType, class Enable = void>
+    struct ScanLanes {
+        typedef void Type;
+    };
+
+    template <class DataType>
+    struct ScanLanes<DataType, typename std::enable_if<std::is_integral<DataType>::value
+            && !std::is_same<DataType, bool>::value && sizeof(DataType) == 4>::type> {
+        typedef Sse2Int32Lanes<DataType> Type;
+    };
+
+    template <class DataType>
+    struct ScanLanes<DataType, typename std::enable_if<std::is_integral<DataType>::value
+            && sizeof(DataType) == 8>::type> {
+        typedef Sse2Int64Lanes<DataType> Type;
+    };
+
+    template <>
+    struct ScanLanes<float> {
+        typedef Sse2FloatLanes Type;
+    };
+
+    template <>
+    struct ScanLanes<double> {
+        typedef Sse2DoubleLanes Type;
+    };
+
+    // Scan whole vectors of `length` elements from `in` to `out`, adding to `total`, and return the number of
+    // elements scanned.
+    template <bool INCLUSIVE, class DataType, class Lanes>
+    size_t simdScan(const DataType* in, const size_t length, DataType* out, DataType& total, Lanes*) {
+        typedef typename Lanes::Vector Vector;
+        Vector carry = Lanes::splat(total);
+        size_t i = 0;
+        for (; i + Lanes::LANES <= length; i += Lanes::LANES) {
+            const Vector prefix = Lanes::prefix(Lanes::load(in + i));
+            Lanes::store(out + i, Lanes::add(INCLUSIVE ? prefix : Lanes::shiftOne(prefix), carry));
+            carry = Lanes::broadcastLast(Lanes::add(prefix, carry));
+        }
+        DataType lanes[Lanes::LANES];
+        Lanes::store(lanes, carry);
+        total = lanes[0];
+        return i;
+    }
+#else
+    template <class DataType, class Enable = void>
+    struct ScanLanes {
+        typedef void Type;
+    };
+#endif
+
+    template <bool INCLUSIVE, class DataType>
+    size_t simdScan(const DataType*, size_t, DataType*, DataType&, void*) {
+        return 0;
+    }
+
+    // Scan a contiguous segment of `length` elements from `in` to `out`, adding to `total`.
+    template <bool INCLUSIVE, class DataType, class OutputIterator>
+    OutputIterator scanSegment(const DataType* in, const size_t length, OutputIterator out, DataType& total) {
+        return scalarScan<INCLUSIVE>(in, length, out, total);
+    }
+
+    template <bool INCLUSIVE, class DataType>
+    DataType* scanSegment(const DataType* in, const size_t length, DataType* out, DataType& total) {
+        const size_t scanned = simdScan<INCLUSIVE>(in, length, out, total,
+                static_cast<typename ScanLanes<DataType>::Type*>(nullptr));
+        return scalarScan<INCLUSIVE>(in + scanned, length - scanned, out + scanned, total);
+    }
+
+    // Scan a contiguous segment into a segmented output, one output segment at a time.
+    template <bool INCLUSIVE, class DataType, class OutputIterator>
+    OutputIterator scanInto(const DataType* in, const size_t length, OutputIterator out, DataType& total,
+            std::true_type) {
+        const OutputIterator outEnd = out + length;
+        const auto segments = out.segmentsUntil(outEnd);
+        scanSegment<INCLUSIVE>(in, segments.first.size(), segments.first.begin(), total);
+        scanSegment<INCLUSIVE>(in + segments.first.size(), segments.second.size(), segments.second.begin(), total);
+        return outEnd;
+    }
+
+    template <bool INCLUSIVE, class DataType, class OutputIterator>
+    OutputIterator scanInto(const DataType* in, const size_t length, OutputIterator out, DataType& total,
+            std::false_type) {
+        return scanSegment<INCLUSIVE>(in, length, out, total);
+    }
+
+    template <bool INCLUSIVE, class InputIterator, class OutputIterator, class DataType>
+    OutputIterator segmentedScan(InputIterator begin, InputIterator end, OutputIterator out, DataType total,
+            std::true_type) {
+        typedef std::integral_constant<bool, IsSegmentedIterator<OutputIterator>::value> OutputSegmented;
+        const auto segments = begin.segmentsUntil(end);
+        out = scanInto<INCLUSIVE>(segments.first.begin(), segments.first.size(), out, total, OutputSegmented());
+        return scanInto<INCLUSIVE>(segments.second.begin(), segments.second.size(), out, total, OutputSegmented());
+    }
+
+    template <bool INCLUSIVE, class InputIterator, class OutputIterator, class DataType>
+    OutputIterator segmentedScan(InputIterator begin, InputIterator end, OutputIterator out, DataType total,
+            std::false_type) {
+        for (; begin != end; ++begin, ++out) {
+            const DataType element = *begin;
+            if (INCLUSIVE) {
+                total = total + element;
+                *out = total;
+            } else {
+                *out = total;
+                total = total + element;
+            }
+        }
+        return out;
+    }
+
+    template <bool INCLUSIVE, class InputIterator, class OutputIterator, class DataType>
+    OutputIterator segmentedScan(InputIterator begin, InputIterator end, OutputIterator out, const DataType& total) {
+        return segmentedScan<INCLUSIVE>(begin, end, out, total,
+                std::integral_constant<bool, IsSegmentedIterator<InputIterator>::value>());
+    }
+
+    template <class InputIterator, class DataType>
+    DataType segmentedSum(InputIterator begin, InputIterator end, DataType total, std::true_type) {
+        const auto segments = begin.segmentsUntil(end);
+        total = std::accumulate(segments.first.begin(), segments.first.end(), total);
+        return std::accumulate(segments.second.begin(), segments.second.end(), total);
+    }
+
+    template <class InputIterator, class DataType>
+    DataType segmentedSum(InputIterator begin, InputIterator end, const DataType& total, std::false_type) {
+        return std::accumulate(begin, end, total);
+    }
+
+    // Run `task(0)` to `task(numTasks - 1)` in parallel, the first on the calling thread.
+    template <class Task>
+    void runParallel(const size_t numTasks, const Task& task) {
+        std::vector<std::thread> threads;
+        threads.reserve(numTasks - 1);
+        try {
+            for (size_t i = 1; i < numTasks; ++i) {
+                threads.push_back(std::thread(task, i));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < threads.size(); ++i) {
+                threads[i].join();
+            }
+            throw;
+        }
+        task(0);
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+    }
+
+    // Two-pass parallel scan: each thread sums its chunk, the sums are scanned to give the total before each chunk,
+    // then each thread scans its chunk starting from that total.
+    template <bool INCLUSIVE, class InputIterator, class OutputIterator, class DataType>
+    OutputIterator parallelScan(InputIterator begin, InputIterator end, OutputIterator out, const DataType& initial,
+            size_t numThreads) {
+        typedef std::integral_constant<bool, IsSegmentedIterator<InputIterator>::value> InputSegmented;
+        const size_t length = static_cast<size_t>(end - begin);
+        if (numThreads == 0) {
+            numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+        }
+        const size_t numChunks = std::min(numThreads, length / PARALLEL_SCAN_MIN_CHUNK);
+        if (numChunks <= 1) {
+            return segmentedScan<INCLUSIVE>(begin, end, out, initial);
+        }
+        // totals[i] is first the sum of chunk i - 1, then the total before chunk i.
+        std::vector<DataType> totals(numChunks, DataType());
+        runParallel(numChunks - 1, [&](const size_t chunk) {
+            totals[chunk + 1] = segmentedSum(begin + length * chunk / numChunks,
+                    begin + length * (chunk + 1) / numChunks, DataType(), InputSegmented());
+        });
+        totals[0] = initial;
+        for (size_t i = 1; i < numChunks; ++i) {
+            totals[i] = totals[i - 1] + totals[i];
+        }
+        runParallel(numChunks, [&](const size_t chunk) {
+            const size_t from = length * chunk / numChunks;
+            segmentedScan<INCLUSIVE>(begin + from, begin + length * (chunk + 1) / numChunks, out + from,
+                    totals[chunk]);
+        });
+        return out + length;
+    }
+}
+
+namespace vector_deque_detail {
+    // Number of elements compacted into a buffer at a time by the stream compaction algorithms.
+    const size_t COMPACT_BLOCK = 256;
+
+    // Room the SIMD kernels may write past the compacted elements: one vector of the widest lanes.
+    const size_t COMPACT_SLACK = 16;
+
+    inline unsigned countBits(const uint32_t bits) noexcept {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_popcount(bits));
+#else
+        unsigned count = 0;
+        for (uint32_t rest = bits; rest != 0; rest &= rest - 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // Copy the `length` elements from `in` for which `pred` is `keep` to `out`, and return how many there are. `out`
+    // must have room for `length` elements. Branchless: every element is written, and the output only advances past
+    // those kept.
+    template <class DataType, class Predicate>
+    size_t scalarCompact(const DataType* in, const size_t length, DataType* out, const Predicate& pred,
+            const bool keep) {
+        size_t numKept = 0;
+        for (size_t i = 0; i < length; ++i) {
+            out[numKept] = in[i];
+            numKept += static_cast<size_t>(static_cast<bool>(pred(in[i])) == keep);
+        }
+        return numKept;
+    }
+
+#if defined(__AVX512F__)
+    // Immediates of the AVX-512 comparisons for `OP`.
+    template <ComparisonOperator OP>
+    struct Avx512Comparison;
+
+    template <>
+    struct Avx512Comparison<COMPARE_EQUAL> {
+        static const int INTEGER = _MM_CMPINT_EQ;
+        static const int FLOATING = _CMP_EQ_OQ;
+    };
+
+    template <>
+    struct Avx512Comparison<COMPARE_NOT_EQUAL> {
+        static const int INTEGER = _MM_CMPINT_NE;
+        static const int FLOATING = _CMP_NEQ_UQ;
+    };
+
+    template <>
+    struct Avx512Comparison<COMPARE_LESS> {
+        static const int INTEGER = _MM_CMPINT_LT;
+        static const int FLOATING = _CMP_LT_OQ;
+    };
+
+    template <>
+    struct Avx512Comparison<COMPARE_LESS_EQUAL> {
+        static const int INTEGER = _MM_CMPINT_LE;
+        static const int FLOATING = _CMP_LE_OQ;
+    };
+
+    template <>
+    struct Avx512Comparison<COMPARE_GREATER> {
+        static const int INTEGER = _MM_CMPINT_NLE;
+        static const int FLOATING = _CMP_GT_OQ;
+    };
+
+    template <>
+    struct Avx512Comparison<COMPARE_GREATER_EQUAL> {
+        static const int INTEGER = _MM_CMPINT_NLT;
+        static const int FLOATING = _CMP_GE_OQ;
+    };
+
+    // Lane operations used by `simdCompact`, one struct per kind of lane. `compare` gives the bit mask of the lanes
+    // for which the comparison holds, and `compress` stores the selected lanes contiguously, returning their number.
+    // With AVX-512, `vpcompress` stores exactly the selected lanes.
+    template <class DataType>
+    struct Avx512Int32CompactLanes {
+        typedef __m512i Vector;
+        typedef uint32_t Mask;
+        static const size_t LANES = 16;
+
+        static Vector load(const DataType* p) { return _mm512_loadu_si512(p); }
+        static Vector splat(const DataType value) { return _mm512_set1_epi32(static_cast<int32_t>(value)); }
+        template <ComparisonOperator OP>
+        static Mask compare(const Vector v, const Vector x) {
+            return std::is_signed<DataType>::value ? _mm512_cmp_epi32_mask(v, x, Avx512Comparison<OP>::INTEGER)
+                    : _mm512_cmp_epu32_mask(v, x, Avx512Comparison<OP>::INTEGER);
+        }
+        static size_t compress(DataType* out, const Vector v, const Mask mask) {
+            _mm512_mask_compressstoreu_epi32(out, static_cast<__mmask16>(mask), v);
+            return countBits(mask);
+        }
+    };
+
+    template <class DataType>
+    struct Avx512Int64CompactLanes {
+        typedef __m512i Vector;
+        typedef uint32_t Mask;
+        static const size_t LANES = 8;
+
+        static Vector load(const DataType* p) { return _mm512_loadu_si512(p); }
+        static Vector splat(const DataType value) { return _mm512_set1_epi64(static_cast<long long>(value)); }
+        template <ComparisonOperator OP>
+        static Mask compare(const Vector v, const Vector x) {
+            return std::is_signed<DataType>::value ? _mm512_cmp_epi64_mask(v, x, Avx512Comparison<OP>::INTEGER)
+                    : _mm512_cmp_epu64_mask(v, x, Avx512Comparison<OP>::INTEGER);
+        }
+        static size_t compress(DataType* out, const Vector v, const Mask mask) {
+            _mm512_mask_compressstoreu_epi64(out, static_cast<__mmask8>(mask), v);
+            return countBits(mask);
+        }
+    };
+
+    struct Avx512FloatCompactLanes {
+        typedef __m512 Vector;
+        typedef uint32_t Mask;
+        static const size_t LANES = 16;
+
+        static Vector load(const float* p) { return _mm512_loadu_ps(p); }
+        static Vector splat(const float value) { return _mm512_set1_ps(value); }
+        template <ComparisonOperator OP>
+        static Mask compare(const Vector v, const Vector x) {
+            return _mm512_cmp_ps_mask(v, x, Avx512Comparison<OP>::FLOATING);
+        }
+        static size_t compress(float* out, const Vector v, const Mask mask) {
+            _mm512_mask_compressstoreu_ps(out, static_cast<__mmask16>(mask), v);
+            return countBits(mask);
+        }
+    };
+
+    struct Avx512DoubleCompactLanes {
+        typedef __m512d Vector;
+        typedef uint32_t Mask;
+        static const size_t LANES = 8;
+
+        static Vector load(const double* p) { return _mm512_loadu_pd(p); }
+        static Vector splat(const double value) { return _mm512_set1_pd(value); }
+        template <ComparisonOperator OP>
+        static Mask compare(const Vector v, const Vector x) {
+            return _mm512_cmp_pd_mask(v, x, Avx512Comparison<OP>::FLOATING);
+        }
+        static size_t compress(double* out, const Vector v, const Mask mask) {
+            _mm512_mask_compressstoreu_pd(out, static_cast<__mmask8>(mask), v);
+            return countBits(mask);
+        }
+    };
+
+    template <class DataType>
+    struct CompactLanesBySize {
+        typedef typename std::conditional<sizeof(DataType) == 4, Avx512Int32CompactLanes<DataType>,
+                Avx512Int64CompactLanes<DataType> >::type Type;
+    };
+
+    typedef Avx512FloatCompactLanes FloatCompactLanes;
+    typedef Avx512DoubleCompactLanes DoubleCompactLanes;
+#elif defined(__AVX2__)
+    // Permutations moving the lanes selected by each mask to the front, for 8 lanes of 32 bits and for 4 lanes of 64
+    // bits (as pairs of 32 bit lanes). AVX2 has no compress instruction, so it is done with `vpermd` and these tables.
+    struct Avx2CompressTables {
+        alignas(32) uint32_t lanes32[256][8];
+        alignas(32) uint32_t lanes64[16][8];
+
+        Avx2CompressTables() {
+            for (uint32_t mask = 0; mask < 256; ++mask) {
+                uint32_t numSelected = 0;
+                for (uint32_t lane = 0; lane < 8; ++lane) {
+                    if ((mask >> lane & 1) != 0) {
+                        lanes32[mask][numSelected++] = lane;
+                    }
+                }
+                for (; numSelected < 8; ++numSelected) {
+                    lanes32[mask][numSelected] = 0;
+                }
+            }
+            for (uint32_t mask = 0; mask < 16; ++mask) {
+                uint32_t numSelected = 0;
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    if ((mask >> lane & 1) != 0) {
+                        lanes64[mask][numSelected++] = 2 * lane;
+                        lanes64[mask][numSelected++] = 2 * lane + 1;
+                    }
+                }
+                for (; numSelected < 8; ++numSelected) {
+                    lanes64[mask][numSelected] = 0;
+                }
+            }
+        }
+    };
+
+    inline const Avx2CompressTables& avx2CompressTables() {
+        static const Avx2CompressTables tables;
+        return tables;
+    }
+
+    // Bit mask of the lanes of the integer comparison `OP` of `v` and `x`, given lanes where `v > x` and `v == x`.
+    template <ComparisonOperator OP>
+    inline __m256i avx2Compare(const __m256i greater, const __m256i less, const __m256i equal) {
+        const __m256i ones = _mm256_set1_epi32(-1);
+        switch (OP) {
+            case COMPARE_EQUAL:
+                return equal;
+            case COMPARE_NOT_EQUAL:
+                return _mm256_xor_si256(equal, ones);
+            case COMPARE_LESS:
+                return less;
+            case COMPARE_LESS_EQUAL:
+                return _mm256_xor_si256(greater, ones);
+            case COMPARE_GREATER:
+                return greater;
+            default:
+                return _mm256_xor_si256(less, ones);
+        }
+    }
+
+    // Immediates of the AVX floating point comparisons for `OP`.
+    template <ComparisonOperator OP>
+    struct AvxFloatComparison {
+        static const int VALUE = OP == COMPARE_EQUAL ? _CMP_EQ_OQ : OP == COMPARE_NOT_EQUAL ? _CMP_NEQ_UQ
+                : OP == COMPARE_LESS ? _CMP_LT_OQ : OP == COMPARE_LESS_EQUAL ? _CMP_LE_OQ
+                : OP == COMPARE_GREATER ? _CMP_GT_OQ : _CMP_GE_OQ;
+    };
+
+    // Lane operations used by `simdCompact`, one struct per kind of lane. `compare` gives the bit mask of the lanes
+    // for which the comparison holds, and `compress` stores the selected lanes contiguously, returning their number.
+    // With AVX2, `compress` stores a whole vector, so `out` must have room for `LANES` elements.
+    template <class DataType>
+    struct Avx2Int32CompactLanes {
+        typedef __m256i Vector;
+        typedef uint32_t Mask;
+        static const size_t LANES = 8;
+
+        // Unsigned lanes are compared as signed ones with their top bit flipped.
+        static Vector bias(const Vector v) {
+            return std::is_signed<DataType>::value ? v
+                    : _mm256_xor_si256(v, _mm256_set1_epi32(static_cast<int32_t>(0x80000000u)));
+        }
+        static Vector load(const DataType* p) {
+            return bias(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+        }
+        static Vector splat(const DataType value) { return bias(_mm256_set1_epi32(static_cast<int32_t>(value))); }
+        template <ComparisonOperator OP>
+        static Mask compare(const Vector v, const Vector x) {
+            const __m256i result = avx2Compare<OP>(_mm256_cmpgt_epi32(v, x), _mm256_cmpgt_epi32(x, v),
+                    _mm256_cmpeq_epi32(v, x));
+            return static_cast<Mask>(_mm256_movemask_ps(_mm256_castsi256_ps(result)));
+        }
+        static size_t compress(DataType* out, const Vector v, const Mask mask) {
+            const __m256i permutation = _mm256_load_si256(
+                    reinterpret_cast<const __m256i*>(avx2CompressTables().lanes32[mask]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bias(_mm256_permutevar8x32_epi32(v, permutation)));
+            return countBits(mask);
+        }
+    };
+
+    template <class DataType>
+    struct Avx2Int64CompactLanes {
+        typedef __m256i Vector;
+        typedef uint32_t Mask;
+        static const size_t LANES = 4;
+
+        static Vector bias(const Vector v) {
+            return std::is_signed<DataType>::value ? v
+                    : _mm256_xor_si256(v, _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull)));
+        }
+        static Vector load(const DataType* p) {
+            return bias(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+        }
+        static Vector splat(const DataType value) {
+            return bias(_mm256_set1_epi64x(static_cast<long long>(value)));
+        }
+        template <ComparisonOperator OP>
+        static Mask compare(const Vector v, const Vector x) {
+            const __m256i result = avx2Compare<OP>(_mm256_cmpgt_epi64(v, x), _mm256_cmpgt_epi64(x, v),
+                    _mm256_cmpeq_epi64(v, x));
+            return static_cast<Mask>(_mm256_movemask_pd(_mm256_castsi256_pd(result)));
+        }
+        static size_t compress(DataType* out, const Vector v, const Mask mask) {
+            const __m256i permutation = _mm256_load_si256(
+                    reinterpret_cast<const __m256i*>(avx2CompressTables().lanes64[mask]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bias(_mm256_permutevar8x32_epi32(v, permutation)));
+            return countBits(mask);
+        }
+    };
+
+    struct Avx2FloatCompactLanes {
+        typedef __m256 Vector;
+        typedef uint32_t Mask;
+        static const size_t LANES = 8;
+
+        static Vector load(const float* p) { return _mm256_loadu_ps(p); }
+        static Vector splat(const float value) { return _mm256_set1_ps(value); }
+        template <ComparisonOperator OP>
+        static Mask compare(const Vector v, const Vector x) {
+            return static_cast<Mask>(_mm256_movemask_ps(_mm256_cmp_ps(v, x, AvxFloatComparison<OP>::VALUE)));
+        }
+        static size_t compress(float* out, const Vector v, const Mask mask) {
+            const __m256i permutation = _mm256_load_si256(
+                    reinterpret_cast<const __m256i*>(avx2CompressTables().lanes32[mask]));
+            _mm256_storeu_ps(out, _mm256_permutevar8x32_ps(v, permutation));
+            return countBits(mask);
+        }
+    };
+
+    struct Avx2DoubleCompactLanes {
+        typedef __m256d Vector;
+        typedef uint32_t Mask;
+        static const size_t LANES = 4;
+
+        static Vector load(const double* p) { return _mm256_loadu_pd(p); }
+        static Vector splat(const double value) { return _mm256_set1_pd(value); }
+        template <ComparisonOperator OP>
+        static Mask compare(const Vector v, const Vector x) {
+            return static_cast<Mask>(_mm256_movemask_pd(_mm256_cmp_pd(v, x, AvxFloatComparison<OP>::VALUE)));
+        }
+        static size_t compress(double* out, const Vector v, const Mask mask) {
+            const __m256i permutation = _mm256_load_si256(
+                    reinterpret_cast<const __m256i*>(avx2CompressTables().lanes64[mask]));
+            _mm256_storeu_pd(out, _mm256_castsi256_pd(
+                    _mm256_permutevar8x32_epi32(_mm256_castpd_si256(v), permutation)));
+            return countBits(mask);
+        }
+    };
+
+    template <class DataType>
+    struct CompactLanesBySize {
+        typedef typename std::conditional<sizeof(DataType) == 4, Avx2Int32CompactLanes<DataType>,
+                Avx2Int64CompactLanes<DataType> >::type Type;
+    };
+
+    typedef Avx2FloatCompactLanes FloatCompactLanes;
+    typedef Avx2DoubleCompactLanes DoubleCompactLanes;
+#endif
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+    // The lane operations to compact `DataType` with, or `void` if it is compacted one element at a time.
+    template <class DataType, class Enable = void>
+    struct CompactLanes {
+        typedef void Type;
+    };
+
+    template <class DataType>
+    struct CompactLanes<DataType, typename std::enable_if<std::is_integral<DataType>::value
+            && !std::is_same<DataType, bool>::value && (sizeof(DataType) == 4 || sizeof(DataType) == 8)>::type> {
+        typedef typename CompactLanesBySize<DataType>::Type Type;
+    };
+
+    template <>
+    struct CompactLanes<float> {
+        typedef FloatCompactLanes Type;
+    };
+
+    template <>
+    struct CompactLanes<double> {
+        typedef DoubleCompactLanes Type;
+    };
+
+    // Compact whole vectors with the comparison `OP`, then the remaining elements one at a time.
+    template <ComparisonOperator OP, class DataType, class Lanes>
+    size_t simdCompact(const DataType* in, const size_t length, DataType* out, const DataType& value,
+            const bool keep) {
+        typedef typename Lanes::Vector Vector;
+        typedef typename Lanes::Mask Mask;
+        const Vector x = Lanes::splat(value);
+        const Mask flip = keep ? 0 : static_cast<Mask>((static_cast<uint64_t>(1) << Lanes::LANES) - 1);
+        size_t numKept = 0;
+        size_t i = 0;
+        for (; i + Lanes::LANES <= length; i += Lanes::LANES) {
+            const Vector v = Lanes::load(in + i);
+            numKept += Lanes::compress(out + numKept, v, Lanes::template compare<OP>(v, x) ^ flip);
+        }
+        return numKept + scalarCompact(in + i, length - i, out + numKept, Comparison<DataType>(OP, value), keep);
+    }
+
+    template <class DataType, class Lanes>
+    size_t simdCompact(const DataType* in, const size_t length, DataType* out, const Comparison<DataType>& pred,
+            const bool keep, Lanes*) {
+        switch (pred.op) {
+            case COMPARE_EQUAL:
+                return simdCompact<COMPARE_EQUAL, DataType, Lanes>(in, length, out, pred.value, keep);
+            case COMPARE_NOT_EQUAL:
+                return simdCompact<COMPARE_NOT_EQUAL, DataType, Lanes>(in, length, out, pred.value, keep);
+            case COMPARE_LESS:
+                return simdCompact<COMPARE_LESS, DataType, Lanes>(in, length, out, pred.value, keep);
+            case COMPARE_LESS_EQUAL:
+                return simdCompact<COMPARE_LESS_EQUAL, DataType, Lanes>(in, length, out, pred.value, keep);
+            case COMPARE_GREATER:
+                return simdCompact<COMPARE_GREATER, DataType, Lanes>(in, length, out, pred.value, keep);
+            default:
+                return simdCompact<COMPARE_GREATER_EQUAL, DataType, Lanes>(in, length, out, pred.value, keep);
+        }
+    }
+#else
+    template <class DataType, class Enable = void>
+    struct CompactLanes {
+        typedef void Type;
+    };
+#endif
+
+    template <class DataType>
+    size_t simdCompact(const DataType* in, const size_t length, DataType* out, const Comparison<DataType>& pred,
+            const bool keep, void*) {
+        return scalarCompact(in, length, out, pred, keep);
+    }
+
+    // Copy the `length` elements from `in` for which `pred` is `keep` to `out`, which must have room for
+    // `length + COMPACT_SLACK` elements, and return how many there are.
+    template <class DataType, class Predicate>
+    size_t compactBlock(const DataType* in, const size_t length, DataType* out, const Predicate& pred,
+            const bool keep) {
+        return scalarCompact(in, length, out, pred, keep);
+    }
+
+    template <class DataType>
+    size_t compactBlock(const DataType* in, const size_t length, DataType* out, const Comparison<DataType>& pred,
+            const bool keep) {
+        return simdCompact(in, length, out, pred, keep, static_cast<typename CompactLanes<DataType>::Type*>(nullptr));
+    }
+
+    // Write the `length` elements of `in` to the segmented range starting at `out`.
+    template <class DataType, class OutputIterator>
+    void copyIntoSegments(const DataType* in, const size_t length, const OutputIterator out) {
+        const auto segments = out.segmentsUntil(out + length);
+        std::copy(in, in + segments.first.size(), segments.first.begin());
+        std::copy(in + segments.first.size(), in + length, segments.second.begin());
+    }
+
+    // Whether a range of `IteratorType` is compacted block by block through a buffer: its segments must be contiguous
+    // and its elements arithmetic, so that copying them through the buffer is cheap.
+    template <class IteratorType>
+    struct IsCompactable {
+        static const bool value = IsSegmentedIterator<IteratorType>::value
+                && std::is_arithmetic<typename std::iterator_traits<IteratorType>::value_type>::value;
+    };
+
+    template <class InputIterator, class OutputIterator, class Predicate>
+    OutputIterator segmentedCopyIf(InputIterator begin, InputIterator end, OutputIterator out, const Predicate& pred,
+            std::true_type) {
+        typedef typename std::iterator_traits<InputIterator>::value_type DataType;
+        DataType buffer[COMPACT_BLOCK + COMPACT_SLACK];
+        const auto segments = begin.segmentsUntil(end);
+        const auto parts = {segments.first, segments.second};
+        for (const auto& part: parts) {
+            for (size_t i = 0; i < part.size(); i += COMPACT_BLOCK) {
+                const size_t length = std::min(COMPACT_BLOCK, part.size() - i);
+                const size_t numKept = compactBlock(part.begin() + i, length, buffer, pred, true);
+                out = std::copy(buffer, buffer + numKept, out);
+            }
+        }
+        return out;
+    }
+
+    template <class InputIterator, class OutputIterator, class Predicate>
+    OutputIterator segmentedCopyIf(InputIterator begin, InputIterator end, OutputIterator out, const Predicate& pred,
+            std::false_type) {
+        return std::copy_if(begin, end, out, pred);
+    }
+
+    // Compact the elements of `[begin, end)` for which `pred` is `keep` to the front, keeping their order, and return
+    // how many there are. If `PARTITION`, the others are passed in order to `reject(const DataType*, size_t)`.
+    template <bool PARTITION, class ForwardIterator, class Predicate, class Reject>
+    size_t compactInPlace(ForwardIterator begin, ForwardIterator end, const Predicate& pred, const bool keep,
+            Reject&& reject) {
+        typedef typename std::iterator_traits<ForwardIterator>::value_type DataType;
+        DataType kept[COMPACT_BLOCK + COMPACT_SLACK];
+        DataType rejected[COMPACT_BLOCK + COMPACT_SLACK];
+        const auto segments = begin.segmentsUntil(end);
+        const auto parts = {segments.first, segments.second};
+        size_t numKept = 0;
+        for (const auto& part: parts) {
+            for (size_t i = 0; i < part.size(); i += COMPACT_BLOCK) {
+                const size_t length = std::min(COMPACT_BLOCK, part.size() - i);
+                // The block is fully compacted before any of it is overwritten, and the kept elements are written back
+                // no further than its end.
+                const size_t numBlockKept = compactBlock(part.begin() + i, length, kept, pred, keep);
+                if (PARTITION) {
+                    reject(rejected, compactBlock(part.begin() + i, length, rejected, pred, !keep));
+                }
+                copyIntoSegments(kept, numBlockKept, begin + numKept);
+                numKept += numBlockKept;
+            }
+        }
+        return numKept;
+    }
+
+    template <class ForwardIterator, class Predicate>
+    ForwardIterator segmentedPartition(ForwardIterator begin, ForwardIterator end, const Predicate& pred,
+            std::true_type) {
+        typedef typename std::iterator_traits<ForwardIterator>::value_type DataType;
+        std::vector<DataType> rejected;
+        const size_t numKept = compactInPlace<true>(begin, end, pred, true,
+                [&rejected](const DataType* const elements, const size_t length) {
+                    rejected.insert(rejected.end(), elements, elements + length);
+                });
+        const ForwardIterator middle = begin + numKept;
+        copyIntoSegments(rejected.data(), rejected.size(), middle);
+        return middle;
+    }
+
+    template <class ForwardIterator, class Predicate>
+    ForwardIterator segmentedPartition(ForwardIterator begin, ForwardIterator end, const Predicate& pred,
+            std::false_type) {
+        return std::stable_partition(begin, end, pred);
+    }
+
+    template <class ForwardIterator, class Predicate>
+    ForwardIterator segmentedRemoveIf(ForwardIterator begin, ForwardIterator end, const Predicate& pred,
+            std::true_type) {
+        typedef typename std::iterator_traits<ForwardIterator>::value_type DataType;
+        return begin + compactInPlace<false>(begin, end, pred, false, [](const DataType*, size_t) {});
+    }
+
+    template <class ForwardIterator, class Predicate>
+    ForwardIterator segmentedRemoveIf(ForwardIterator begin, ForwardIterator end, const Predicate& pred,
+            std::false_type) {
+        return std::remove_if(begin, end, pred);
+    }
+}
+
+/**
+ * Like `segmentedExclusiveScan`, but splits the range into chunks scanned by separate threads in two passes. Only
+ * ranges of more than `vector_deque_detail::PARALLEL_SCAN_MIN_CHUNK` elements per thread are split, so this is for
+ * very large ranges.
+ * Runtime: `O((end - begin) / numThreads)`
+ * @param begin Random access iterator to the first element to scan.
+ * @param end Random access iterator past the last element to scan.
+ * @param out Random access iterator to write the sums to.
+ * @param initial Value to start the sums from.
+ * @param numThreads Maximum number of threads to use, or `0` to use the number of hardware threads.
+ * @return Iterator past the last sum written.
+ * @throws std::system_error If a thread cannot be started.
+ */
+template <class InputIterator, class OutputIterator>
+OutputIterator parallelExclusiveScan(InputIterator begin, InputIterator end, OutputIterator out,
+        const typename std::iterator_traits<InputIterator>::value_type& initial, const size_t numThreads = 0) {
+    return vector_deque_detail::parallelScan<false>(begin, end, out, initial, numThreads);
+}
+
+/**
+ * Like `segmentedInclusiveScan`, but splits the range into chunks scanned by separate threads in two passes. Only
+ * ranges of more than `vector_deque_detail::PARALLEL_SCAN_MIN_CHUNK` elements per thread are split, so this is for
+ * very large ranges.
+ * Runtime: `O((end - begin) / numThreads)`
+ * @param begin Random access iterator to the first element to scan.
+ * @param end Random access iterator past the last element to scan.
+ * @param out Random access iterator to write the sums to.
+ * @param numThreads Maximum number of threads to use, or `0` to use the number of hardware threads.
+ * @return Iterator past the last sum written.
+ * @throws std::system_error If a thread cannot be started.
+ */
+template <class InputIterator, class OutputIterator>
+OutputIterator parallelInclusiveScan(InputIterator begin, InputIterator end, OutputIterator out,
+        const size_t numThreads = 0) {
+    return vector_deque_detail::parallelScan<true>(begin, end, out,
+            typename std::iterator_traits<InputIterator>::value_type(), numThreads);
+}
+
+/**
+ * Copy the elements of `[begin, end)` to `out`, one contiguous segment at a time if the range is segmented.
+ * Runtime: `O(end - begin)`
+ * @param begin Iterator to the first element to copy.
+ * @param end Iterator past the last element to copy.
+ * @param out Iterator to copy to.
+ * @return Iterator past the last element copied to.
+ */
+template <class InputIterator, class OutputIterator>
+OutputIterator segmentedCopy(InputIterator begin, InputIterator end, OutputIterator out) {
+    return vector_deque_detail::segmentedCopy(begin, end, out,
+            std::integral_constant<bool, IsSegmentedIterator<InputIterator>::value>());
+}
+
+/**
+ * Copy the elements of `[begin, end)` for which `pred` is `true` to `out`, keeping their order. Segmented ranges of
+ * arithmetic types are compacted a block at a time through a buffer without branching on `pred`, and if `pred` is a
+ * `Comparison`, with SIMD compress kernels where available.
+ * Runtime: `O(end - begin)`
+ * @param begin Iterator to the first element to test.
+ * @param end Iterator past the last element to test.
+ * @param out Iterator to copy to.
+ * @param pred Predicate selecting the elements to copy.
+ * @return Iterator past the last element copied to.
+ */
+template <class InputIterator, class OutputIterator, class Predicate>
+OutputIterator segmentedCopyIf(InputIterator begin, InputIterator end, OutputIterator out, const Predicate& pred) {
+    return vector_deque_detail::segmentedCopyIf(begin, end, out, pred,
+            std::integral_constant<bool, vector_deque_detail::IsCompactable<InputIterator>::value>());
+}
+
+/**
+ * Compute the exclusive prefix sums of `[begin, end)` into `out`: the `i`th output is `initial` plus the sum of the
+ * first `i` elements. The running total is carried across segments, and segments of arithmetic types are scanned
+ * with SIMD kernels where available. `out` may be `begin`, to scan in place.
+ * Runtime: `O(end - begin)`
+ * @param begin Iterator to the first element to scan.
+ * @param end Iterator past the last element to scan.
+ * @param out Iterator to write the sums to.
+ * @param initial Value to start the sums from.
+ * @return Iterator past the last sum written.
+ */
+template <class InputIterator, class OutputIterator>
+OutputIterator segmentedExclusiveScan(InputIterator begin, InputIterator end, OutputIterator out,
+        const typename std::iterator_traits<InputIterator>::value_type& initial) {
+    return vector_deque_detail::segmentedScan<false>(begin, end, out, initial);
+}
+
+/**
+ * Assign `value` to every element of `[begin, end)`, one contiguous segment at a time if the range is segmented.
+ * Runtime: `O(end - begin)`
+ * @param begin Iterator to the first element to assign.
+ * @param end Iterator past the last element to assign.
+ * @param value Value to assign.
+ */
+template <class ForwardIterator, class DataType>
+void segmentedFill(ForwardIterator begin, ForwardIterator end, const DataType& value) {
+    vector_deque_detail::segmentedFill(begin, end, value,
+            std::integral_constant<bool, IsSegmentedIterator<ForwardIterator>::value>());
+}
+
+/**
+ * Find the first element of `[begin, end)` equal to `value`, one contiguous segment at a time if the range is
+ * segmented.
+ * Runtime: `O(end - begin)`
+ * @param begin Iterator to the first element to search.
+ * @param end Iterator past the last element to search.
+ * @param value Value to search for.
+ * @return Iterator to the first element equal to `value`, or `end` if there is none.
+ */
+template <class InputIterator, class DataType>
+InputIterator segmentedFind(InputIterator begin, InputIterator end, const DataType& value) {
+    return vector_deque_detail::segmentedFind(begin, end, value,
+            std::integral_constant<bool, IsSegmentedIterator<InputIterator>::value>());
+}
+
+/**
+ * Compute the inclusive prefix sums of `[begin, end)` into `out`: the `i`th output is the sum of the first `i + 1`
+ * elements, starting from a value-initialized element. The running total is carried across segments, and segments
+ * of arithmetic types are scanned with SIMD kernels where available. `out` may be `begin`, to scan in place.
+ * Runtime: `O(end - begin)`
+ * @param begin Iterator to the first element to scan.
+ * @param end Iterator past the last element to scan.
+ * @param out Iterator to write the sums to.
+ * @return Iterator past the last sum written.
+ */
+template <class InputIterator, class OutputIterator>
+OutputIterator segmentedInclusiveScan(InputIterator begin, InputIterator end, OutputIterator out) {
+    return vector_deque_detail::segmentedScan<true>(begin, end, out,
+            typename std::iterator_traits<InputIterator>::value_type());
+}
+
+/**
+ * Reorder `[begin, end)` so that the elements for which `pred` is `true` come before those for which it is `false`,
+ * keeping the order within each group, like `std::stable_partition`. Segmented ranges of arithmetic types are compacted
+ * in place like in `segmentedRemoveIf`, with the other elements gathered into a buffer and written back after them.
+ * Runtime: `O(end - begin)`
+ * @param begin Iterator to the first element to partition.
+ * @param end Iterator past the last element to partition.
+ * @param pred Predicate selecting the elements to put first.
+ * @return Iterator to the first element for which `pred` is `false`, or `end` if there is none.
+ */
+template <class ForwardIterator, class Predicate>
+ForwardIterator segmentedPartition(ForwardIterator begin, ForwardIterator end, const Predicate& pred) {
+    return vector_deque_detail::segmentedPartition(begin, end, pred,
+            std::integral_constant<bool, vector_deque_detail::IsCompactable<ForwardIterator>::value>());
+}
+
+/**
+ * Remove the elements of `[begin, end)` for which `pred` is `true` by moving the others to the front, keeping their
+ * order, like `std::remove_if`. The elements from the returned iterator to `end` are left in an unspecified state: to
+ * remove them from a deque, call `deque.skipLast(deque.end() - newEnd)`. Segmented ranges of arithmetic types are
+ * compacted a block at a time without branching on `pred`, and if `pred` is a `Comparison`, with SIMD compress kernels
+ * where available.
+ * Runtime: `O(end - begin)`
+ * @param begin Iterator to the first element to test.
+ * @param end Iterator past the last element to test.
+ * @param pred Predicate selecting the elements to remove.
+ * @return Iterator past the last element kept.
+ */
+template <class ForwardIterator, class Predicate>
+ForwardIterator segmentedRemoveIf(ForwardIterator begin, ForwardIterator end, const Predicate& pred) {
+    return vector_deque_detail::segmentedRemoveIf(begin, end, pred,
+            std::integral_constant<bool, vector_deque_detail::IsCompactable<ForwardIterator>::value>());
+}
+
+#endif
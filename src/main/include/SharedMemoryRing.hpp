@@ -0,0 +1,497 @@
+#ifndef SHARED_MEMORY_RING_HPP
+#define SHARED_MEMORY_RING_HPP
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "VectorDeque.hpp"
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+        "SharedMemoryRing needs lock-free atomics, which are address-free and so work across processes");
+
+/**
+ * The header at the start of the shared memory of a `SharedMemoryRing`. Its layout is part of the format identified by
+ * `version`, so fields may only be changed together with `SharedMemoryRing::VERSION`.
+ * As in a `VectorDeque`, the contents are the `size` bytes starting at `position` in a circular array: here
+ * `position` is `head % capacity` and `size` is `tail - head`. `head` and `tail` only ever increase, so that each is
+ * written by one process only. The fields written by each process are on their own cache line.
+ */
+struct SharedMemoryRingHeader {
+    // `SharedMemoryRing::MAGIC`.
+    uint32_t magic;
+
+    // `SharedMemoryRing::VERSION`.
+    uint32_t version;
+
+    // Number of data bytes following the header, a power of two.
+    uint64_t capacity;
+
+    char padding1[48];
+
+    // Total number of bytes written. Written by the producer.
+    std::atomic<uint64_t> tail;
+
+    // Incremented after each write, for the consumer to wait on with a futex.
+    std::atomic<uint32_t> dataSignal;
+
+    // Whether the consumer is waiting on `dataSignal`, so that writes only make a system call when it is.
+    std::atomic<uint32_t> consumerWaiting;
+
+    char padding2[48];
+
+    // Total number of bytes read. Written by the consumer.
+    std::atomic<uint64_t> head;
+
+    // Incremented after each read, for the producer to wait on with a futex.
+    std::atomic<uint32_t> spaceSignal;
+
+    // Whether the producer is waiting on `spaceSignal`.
+    std::atomic<uint32_t> producerWaiting;
+
+    char padding3[48];
+};
+
+/**
+ * `SharedMemoryRing` is a single-producer single-consumer ring of length-prefixed byte records which lives in shared
+ * memory, so that two processes exchange records without copying them through the kernel. Each record is copied once
+ * into the ring by the producer and can be read in place by the consumer (see `peek`). Waiting for data or for room
+ * is done with futexes, and only makes a system call when the other side is actually waiting.
+ * The memory is either a named POSIX shared memory object (`create` and `open`) or an anonymous `memfd`
+ * (`createAnonymous`) shared by forking or by passing its descriptor. Each `SharedMemoryRing` is a mapping of it, and
+ * one process writes to its mapping while the other reads from its own. Only available on Linux.
+ */
+class SharedMemoryRing {
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class SharedMemoryRingTest;
+
+    // Records start at multiples of this, so that their length prefix is never split at the end of the data.
+    static const size_t ALIGNMENT = sizeof(uint32_t);
+
+    // Descriptor of the shared memory.
+    int _fd;
+
+    // The mapping of the shared memory: the header followed by the data.
+    SharedMemoryRingHeader* _header;
+
+    char* _data;
+
+    // `_header->capacity - 1`, to wrap offsets into indices.
+    size_t _mask;
+
+    // Number of bytes taken by a record of `length` bytes, including its prefix and padding.
+    static size_t _footprint(const size_t length) noexcept {
+        return ALIGNMENT + (length + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    static size_t _roundCapacity(const size_t capacity) {
+        if (capacity > static_cast<size_t>(1) << 40) {
+            throw std::length_error("SharedMemoryRing capacity too large: " + std::to_string(capacity));
+        }
+        size_t rounded = 2 * ALIGNMENT;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    // Wait until `word` no longer holds `expected`, `timeout` passes, or a spurious wakeup. Returns `false` on timeout.
+    static bool _futexWait(std::atomic<uint32_t>& word, const uint32_t expected, const timespec* const timeout) {
+        if (::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, timeout, NULL, 0) == 0) {
+            return true;
+        }
+        if (errno == ETIMEDOUT) {
+            return false;
+        }
+        if (errno != EAGAIN && errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(), "futex wait failed");
+        }
+        return true;
+    }
+
+    static void _futexWake(std::atomic<uint32_t>& word) {
+        ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, NULL, NULL, 0);
+    }
+
+    // Signal the other side through `signal`, waking it if it is waiting.
+    static void _signal(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiting) {
+        signal.fetch_add(1);
+        if (waiting.exchange(0) != 0) {
+            _futexWake(signal);
+        }
+    }
+
+    // Wait until `ready` returns `true`, using `signal` and `waiting` to sleep, or until `timeout` passes.
+    // A negative timeout waits forever. Returns the result of the last call to `ready`.
+    template <class Ready>
+    static bool _wait(std::atomic<uint32_t>& signal, std::atomic<uint32_t>& waiting, const std::chrono::nanoseconds
+            timeout, const Ready& ready) {
+        if (ready()) {
+            return true;
+        }
+        const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            const uint32_t expected = signal.load();
+            waiting.store(1);
+            // Checked after announcing that this side is waiting, so that a signal in between is not missed: either
+            // this sees its effect, or it sees `waiting` and changes `signal` before waking.
+            if (ready()) {
+                waiting.store(0);
+                return true;
+            }
+            if (timeout.count() < 0) {
+                _futexWait(signal, expected, NULL);
+                continue;
+            }
+            const std::chrono::nanoseconds remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining.count() <= 0) {
+                return ready();
+            }
+            timespec relative;
+            relative.tv_sec = static_cast<time_t>(remaining.count() / 1000000000);
+            relative.tv_nsec = static_cast<long>(remaining.count() % 1000000000);
+            if (!_futexWait(signal, expected, &relative)) {
+                return ready();
+            }
+        }
+    }
+
+    // Map the shared memory of `fd`, taking ownership of `fd`. Checks the header unless `initialize`, in which case
+    // the memory is sized for `capacity` bytes of data and the header is written.
+    SharedMemoryRing(const int fd, const bool initialize, const size_t capacity = 0): _fd(fd), _header(NULL),
+            _data(NULL), _mask(0) {
+        size_t size = sizeof(SharedMemoryRingHeader) + capacity;
+        try {
+            if (initialize) {
+                if (::ftruncate(_fd, static_cast<off_t>(size)) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "Cannot size shared memory");
+                }
+            } else {
+                struct stat status;
+                if (::fstat(_fd, &status) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "Cannot stat shared memory");
+                }
+                size = static_cast<size_t>(status.st_size);
+                if (size < sizeof(SharedMemoryRingHeader)) {
+                    throw std::runtime_error("Shared memory is too small to be a SharedMemoryRing");
+                }
+            }
+            void* const mapping = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+            if (mapping == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "Cannot map shared memory");
+            }
+            _header = static_cast<SharedMemoryRingHeader*>(mapping);
+            if (initialize) {
+                // The memory is zeroed by `ftruncate`, which is a valid state for the atomics.
+                _header->magic = MAGIC;
+                _header->version = VERSION;
+                _header->capacity = capacity;
+            } else if (_header->magic != MAGIC) {
+                throw std::runtime_error("Shared memory is not a SharedMemoryRing");
+            } else if (_header->version != VERSION) {
+                throw std::runtime_error("Unsupported SharedMemoryRing version " + std::to_string(_header->version));
+            } else if (_header->capacity + sizeof(SharedMemoryRingHeader) != size
+                    || (_header->capacity & (_header->capacity - 1)) != 0) {
+                throw std::runtime_error("Corrupt SharedMemoryRing header");
+            }
+            _data = reinterpret_cast<char*>(_header + 1);
+            _mask = static_cast<size_t>(_header->capacity) - 1;
+        } catch (...) {
+            if (_header != NULL) {
+                ::munmap(_header, size);
+                _header = NULL;
+            }
+            _close();
+            throw;
+        }
+    }
+
+    void _close() noexcept {
+        if (_header != NULL) {
+            ::munmap(_header, sizeof(SharedMemoryRingHeader) + _mask + 1);
+            _header = NULL;
+        }
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    // Copy `length` bytes from `source` to the data starting at offset `offset`, wrapping around its end.
+    void _copyIn(const uint64_t offset, const char* const source, const size_t length) noexcept {
+        const size_t index = static_cast<size_t>(offset) & _mask;
+        const size_t firstLength = length < _mask + 1 - index ? length : _mask + 1 - index;
+        std::memcpy(_data + index, source, firstLength);
+        std::memcpy(_data, source + firstLength, length - firstLength);
+    }
+
+    public:
+    /**
+     * Identifies the shared memory of a `SharedMemoryRing`: `VDQS` in little endian.
+     */
+    static const uint32_t MAGIC = 0x53514456;
+
+    /**
+     * Version of the layout of the shared memory.
+     */
+    static const uint32_t VERSION = 1;
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+
+    SharedMemoryRing& operator =(const SharedMemoryRing&) = delete;
+
+    /**
+     * Constructs a `SharedMemoryRing` from `that`, leaving `that` unusable.
+     * Runtime: `O(1)`
+     * @param that The ring to move.
+     */
+    SharedMemoryRing(SharedMemoryRing&& that) noexcept: _fd(that._fd), _header(that._header), _data(that._data),
+            _mask(that._mask) {
+        that._fd = -1;
+        that._header = NULL;
+    }
+
+    /**
+     * Unmaps the shared memory and closes its descriptor. The shared memory itself lives on while other processes
+     * map it (and, when named, until `unlink` is called).
+     * Runtime: `O(1)`
+     */
+    ~SharedMemoryRing() {
+        _close();
+    }
+
+    /**
+     * Returns the number of data bytes of the ring.
+     * Runtime: `O(1)`
+     * @return The capacity in bytes.
+     */
+    size_t capacity() const noexcept {
+        return _mask + 1;
+    }
+
+    /**
+     * Creates a named POSIX shared memory object holding an empty ring and maps it.
+     * Runtime: `O(capacity)`
+     * @param name Name of the shared memory object, such as `/telemetry`.
+     * @param capacity The minimum number of data bytes. Rounded up to a power of two.
+     * @return The ring.
+     * @throws std::length_error If `capacity` is too large.
+     * @throws std::system_error If the object already exists or cannot be created or mapped.
+     */
+    static SharedMemoryRing create(const std::string& name, const size_t capacity) {
+        const size_t rounded = _roundCapacity(capacity);
+        const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot create shared memory " + name);
+        }
+        return SharedMemoryRing(fd, true, rounded);
+    }
+
+    /**
+     * Creates an anonymous shared memory file holding an empty ring and maps it. Share it with another process by
+     * forking, or by passing `fd()` over a Unix socket to be opened with `fromFd`.
+     * Runtime: `O(capacity)`
+     * @param capacity The minimum number of data bytes. Rounded up to a power of two.
+     * @return The ring.
+     * @throws std::length_error If `capacity` is too large.
+     * @throws std::system_error If the file cannot be created or mapped.
+     */
+    static SharedMemoryRing createAnonymous(const size_t capacity) {
+        const size_t rounded = _roundCapacity(capacity);
+        const int fd = ::memfd_create("SharedMemoryRing", MFD_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot create shared memory");
+        }
+        return SharedMemoryRing(fd, true, rounded);
+    }
+
+    /**
+     * Returns the descriptor of the shared memory.
+     * Runtime: `O(1)`
+     * @return The descriptor.
+     */
+    int fd() const noexcept {
+        return _fd;
+    }
+
+    /**
+     * Maps the ring in the shared memory of `fd`, taking ownership of `fd`.
+     * Runtime: `O(1)`
+     * @param fd Descriptor of shared memory created by `create` or `createAnonymous`.
+     * @return The ring.
+     * @throws std::runtime_error If the memory does not hold a ring of this version.
+     * @throws std::system_error If the memory cannot be mapped.
+     */
+    static SharedMemoryRing fromFd(const int fd) {
+        return SharedMemoryRing(fd, false);
+    }
+
+    /**
+     * Maps the ring in the named POSIX shared memory object `name`.
+     * Runtime: `O(1)`
+     * @param name Name of the shared memory object.
+     * @return The ring.
+     * @throws std::runtime_error If the object does not hold a ring of this version.
+     * @throws std::system_error If the object does not exist or cannot be mapped.
+     */
+    static SharedMemoryRing open(const std::string& name) {
+        const int fd = ::shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open shared memory " + name);
+        }
+        return fromFd(fd);
+    }
+
+    /**
+     * Get the next record without consuming it. Its bytes are in the shared memory, as at most two contiguous
+     * segments, and stay valid until `skip` is called. Must only be called by the consumer.
+     * Runtime: `O(1)`
+     * @param record Set to the segments of the record, if there is one.
+     * @return `true` If there was a record, `false` otherwise.
+     */
+    bool peek(VectorDequeSegments<const char>& record) const noexcept {
+        const uint64_t head = _header->head.load(std::memory_order_relaxed);
+        if (_header->tail.load(std::memory_order_acquire) == head) {
+            return false;
+        }
+        uint32_t length;
+        std::memcpy(&length, _data + (static_cast<size_t>(head) & _mask), sizeof(length));
+        const size_t index = static_cast<size_t>(head + ALIGNMENT) & _mask;
+        const size_t firstLength = length < _mask + 1 - index ? length : _mask + 1 - index;
+        record.first.data = _data + index;
+        record.first.length = firstLength;
+        record.second.data = _data;
+        record.second.length = length - firstLength;
+        return true;
+    }
+
+    /**
+     * Read the next record into `record`, waiting up to `timeout` for one. Must only be called by the consumer.
+     * Runtime: `O(length of the record)` once there is one
+     * @param record String to read into.
+     * @param timeout How long to wait for a record. Negative to wait for ever.
+     * @return `true` If a record was read, `false` if none arrived in time.
+     * @throws std::system_error If waiting fails.
+     */
+    bool read(std::string& record, const std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1)) {
+        return _wait(_header->dataSignal, _header->consumerWaiting, timeout, [&]() {
+            return tryRead(record);
+        });
+    }
+
+    /**
+     * Consume the next record, making its room available to the producer. Must only be called by the consumer.
+     * Runtime: `O(1)`
+     * @throws std::length_error If there is no record.
+     */
+    void skip() {
+        const uint64_t head = _header->head.load(std::memory_order_relaxed);
+        if (_header->tail.load(std::memory_order_acquire) == head) {
+            throw std::length_error("SharedMemoryRing is empty");
+        }
+        uint32_t length;
+        std::memcpy(&length, _data + (static_cast<size_t>(head) & _mask), sizeof(length));
+        _header->head.store(head + _footprint(length), std::memory_order_release);
+        _signal(_header->spaceSignal, _header->producerWaiting);
+    }
+
+    /**
+     * Read the next record into `record` if there is one. Must only be called by the consumer.
+     * Runtime: `O(length of the record)`
+     * @param record String to read into.
+     * @return `true` If a record was read, `false` if there was none.
+     */
+    bool tryRead(std::string& record) {
+        VectorDequeSegments<const char> segments;
+        if (!peek(segments)) {
+            return false;
+        }
+        record.assign(segments.first.begin(), segments.first.end());
+        record.append(segments.second.begin(), segments.second.end());
+        skip();
+        return true;
+    }
+
+    /**
+     * Write the record `data` of `length` bytes if the ring has room for it. Must only be called by the producer.
+     * Runtime: `O(length)`
+     * @param data The bytes of the record.
+     * @param length The number of bytes.
+     * @return `true` If the record was written, `false` if the ring was full.
+     * @throws std::length_error If the record can never fit in the ring.
+     */
+    bool tryWrite(const char* const data, const size_t length) {
+        const size_t footprint = _footprint(length);
+        if (footprint > capacity() || length > UINT32_MAX) {
+            throw std::length_error("Record of " + std::to_string(length) + " bytes does not fit in the ring");
+        }
+        const uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+        if (tail + footprint - _header->head.load(std::memory_order_acquire) > capacity()) {
+            return false;
+        }
+        const uint32_t prefix = static_cast<uint32_t>(length);
+        std::memcpy(_data + (static_cast<size_t>(tail) & _mask), &prefix, sizeof(prefix));
+        _copyIn(tail + ALIGNMENT, data, length);
+        _header->tail.store(tail + footprint, std::memory_order_release);
+        _signal(_header->dataSignal, _header->consumerWaiting);
+        return true;
+    }
+
+    /**
+     * Removes the named POSIX shared memory object `name`. Existing mappings stay valid.
+     * Runtime: `O(1)`
+     * @param name Name of the shared memory object.
+     * @throws std::system_error If the object cannot be removed.
+     */
+    static void unlink(const std::string& name) {
+        if (::shm_unlink(name.c_str()) != 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot unlink shared memory " + name);
+        }
+    }
+
+    /**
+     * Write the record `data` of `length` bytes, waiting up to `timeout` for room. Must only be called by the
+     * producer.
+     * Runtime: `O(length)` once there is room
+     * @param data The bytes of the record.
+     * @param length The number of bytes.
+     * @param timeout How long to wait for room. Negative to wait for ever.
+     * @return `true` If the record was written, `false` if there was no room in time.
+     * @throws std::length_error If the record can never fit in the ring.
+     * @throws std::system_error If waiting fails.
+     */
+    bool write(const char* const data, const size_t length,
+            const std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1)) {
+        return _wait(_header->spaceSignal, _header->producerWaiting, timeout, [&]() {
+            return tryWrite(data, length);
+        });
+    }
+
+    /**
+     * Write the record `record`. See `write(const char*, size_t, std::chrono::nanoseconds)`.
+     * Runtime: `O(record.size())` once there is room
+     * @param record The record.
+     * @param timeout How long to wait for room. Negative to wait for ever.
+     * @return `true` If the record was written, `false` if there was no room in time.
+     */
+    bool write(const std::string& record, const std::chrono::nanoseconds timeout = std::chrono::nanoseconds(-1)) {
+        return write(record.data(), record.size(), timeout);
+    }
+};
+
+#endif
@@ -0,0 +1,312 @@
+#ifndef SLIDING_QUANTILES_HPP
+#define SLIDING_QUANTILES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "VectorDeque.hpp"
+
+/**
+ * `SlidingQuantiles` tracks quantiles (median, p90, p99, ...) of a sliding window of samples. The window itself is kept
+ * in a `VectorDeque`, which gives the order samples are evicted in, and the same samples are kept in order of value in
+ * an indexable skiplist: a skiplist whose links also record how many elements they skip, so the element of any rank is
+ * found by walking down the levels. Adding, evicting and querying are all `O(log(size()))` expected, where sorting the
+ * window for each query is `O(size() * log(size()))`.
+ * Skiplist nodes live in a single pool of links and are reused after being evicted, so a window that slides at a
+ * steady size stops allocating once it is full. Each link also holds a copy of the sample it leads to, which makes a
+ * step of a search one load rather than two dependent ones; searches over large windows are bound by these loads.
+ * @param DataType The type of the samples.
+ * @param Compare Strict weak ordering of the samples.
+ */
+template <class DataType, class Compare = std::less<DataType> >
+class SlidingQuantiles {
+    public:
+    /**
+     * Maximum height of a skiplist node, enough for windows of up to `2^MAX_LEVELS` samples.
+     */
+    static const size_t MAX_LEVELS = 32;
+
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class SlidingQuantilesTest;
+
+    // Offset of the end of every level of the skiplist.
+    static const size_t NIL = SIZE_MAX;
+
+    // Offset of the head node, which precedes every sample and has every level.
+    static const size_t HEAD = 0;
+
+    struct Link {
+        // Offset of the next node on this level.
+        size_t next;
+        // Number of positions on the bottom level from this node to `next`, counting the end as position `size()`.
+        size_t width;
+        // Sample of the next node, so that searches compare without loading it.
+        DataType nextValue;
+    };
+
+    const Compare _cmp;
+
+    // Maximum number of samples in the window, or `0` for no maximum.
+    const size_t _windowSize;
+
+    // The samples, from oldest to newest.
+    VectorDeque<DataType> _window;
+
+    // Links of every skiplist node. A node of height `h` is `h` consecutive links from its offset, one per level, so
+    // each step of a search is a single load.
+    std::vector<Link> _links;
+
+    // Offsets of the free nodes of each height, `_freeNodes[h - 1]` holding those of height `h`.
+    VectorDeque<size_t> _freeNodes[MAX_LEVELS];
+
+    // State of the generator of node heights.
+    uint64_t _random;
+
+    // Check to see if there is at least one sample.
+    // If not, throw `length_error`.
+    void _checkNotEmpty() const {
+        if (_window.isEmpty()) {
+            throw std::length_error("SlidingQuantiles is empty");
+        }
+    }
+
+    // Insert `value` into the skiplist.
+    void _insert(const DataType& value) {
+        size_t chain[MAX_LEVELS];
+        size_t stepsAtLevel[MAX_LEVELS];
+        size_t node = HEAD;
+        // Find the last node at each level which is not greater than `value`, so equivalent samples stay in the order
+        // they were added.
+        for (size_t level = MAX_LEVELS; level-- > 0;) {
+            stepsAtLevel[level] = 0;
+            for (const Link* link = &_links[node + level]; link->next != NIL && !_cmp(value, link->nextValue);
+                    link = &_links[node + level]) {
+                stepsAtLevel[level] += link->width;
+                node = link->next;
+            }
+            chain[level] = node;
+        }
+        const size_t height = _randomHeight();
+        const size_t offset = _newNode(height);
+        size_t steps = 0;
+        for (size_t level = 0; level < height; ++level) {
+            Link& previous = _links[chain[level] + level];
+            Link& link = _links[offset + level];
+            link.next = previous.next;
+            link.width = previous.width - steps;
+            link.nextValue = previous.nextValue;
+            previous.next = offset;
+            previous.width = steps + 1;
+            previous.nextValue = value;
+            steps += stepsAtLevel[level];
+        }
+        for (size_t level = height; level < MAX_LEVELS; ++level) {
+            ++_links[chain[level] + level].width;
+        }
+    }
+
+    // Take a node of height `height` from the pool, returning its offset.
+    size_t _newNode(const size_t height) {
+        VectorDeque<size_t>& freeNodes = _freeNodes[height - 1];
+        if (!freeNodes.isEmpty()) {
+            return freeNodes.popLast();
+        }
+        const size_t offset = _links.size();
+        _links.resize(offset + height, Link{NIL, 0, DataType()});
+        return offset;
+    }
+
+    // Height of a new node: `h` with probability `2^-h`, so each level has about half the nodes of the one below.
+    size_t _randomHeight() noexcept {
+        // xorshift64
+        _random ^= _random << 13;
+        _random ^= _random >> 7;
+        _random ^= _random << 17;
+        size_t height = 1;
+        for (uint64_t bits = _random; (bits & 1) != 0 && height < MAX_LEVELS; bits >>= 1) {
+            ++height;
+        }
+        return height;
+    }
+
+    // Remove the oldest sample equivalent to `value` from the skiplist, where there must be one. Equivalent samples are
+    // kept in the order they were added, so this is the first of them.
+    void _remove(const DataType& value) {
+        size_t chain[MAX_LEVELS];
+        size_t node = HEAD;
+        for (size_t level = MAX_LEVELS; level-- > 0;) {
+            for (const Link* link = &_links[node + level]; link->next != NIL && _cmp(link->nextValue, value);
+                    link = &_links[node + level]) {
+                node = link->next;
+            }
+            chain[level] = node;
+        }
+        // The first sample not less than `value` follows the chain on exactly the levels it has.
+        const size_t offset = _links[chain[0]].next;
+        size_t height = 0;
+        for (; height < MAX_LEVELS && _links[chain[height] + height].next == offset; ++height) {
+            Link& previous = _links[chain[height] + height];
+            Link& link = _links[offset + height];
+            previous.width += link.width - 1;
+            previous.next = link.next;
+            previous.nextValue = link.nextValue;
+            link.nextValue = DataType();
+        }
+        for (size_t level = height; level < MAX_LEVELS; ++level) {
+            --_links[chain[level] + level].width;
+        }
+        _freeNodes[height - 1].add(offset);
+    }
+
+    // Reset the skiplist to just the head.
+    void _reset() {
+        _links.assign(MAX_LEVELS, Link{NIL, 1, DataType()});
+        for (size_t height = 1; height <= MAX_LEVELS; ++height) {
+            _freeNodes[height - 1].clear();
+        }
+    }
+
+    public:
+    /**
+     * Constructs an empty `SlidingQuantiles`.
+     * Runtime: `O(MAX_LEVELS)`
+     * @param windowSize Number of samples in the window, after which each new sample evicts the oldest, or `0` to only
+     * evict with `pop`.
+     * @param cmp Strict weak ordering of the samples.
+     */
+    explicit SlidingQuantiles(const size_t windowSize = 0, const Compare& cmp = Compare()): _cmp(cmp),
+            _windowSize(windowSize), _random(0x9E3779B97F4A7C15ull) {
+        for (size_t height = 1; height <= MAX_LEVELS; ++height) {
+            // Most heights are rare, so only allocate on first use.
+            _freeNodes[height - 1] = VectorDeque<size_t>(0);
+        }
+        _reset();
+    }
+
+    /**
+     * Add `sample` to the window. If the window is full, the oldest sample is evicted first.
+     * Runtime: `O(log(size()))` expected
+     * @param sample Sample to add.
+     * @return `true` If a sample was evicted, `false` otherwise.
+     */
+    bool add(const DataType& sample) {
+        const bool evicting = _windowSize != 0 && _window.size() >= _windowSize;
+        if (evicting) {
+            pop();
+        }
+        _window.add(sample);
+        _insert(sample);
+        return evicting;
+    }
+
+    /**
+     * Remove every sample.
+     * Runtime: `O(size())`
+     */
+    void clear() {
+        _window.clear();
+        _reset();
+    }
+
+    /**
+     * Checks whether the window is empty.
+     * Runtime: `O(1)`
+     * @return `true` If `size() == 0`, `false` otherwise.
+     */
+    bool isEmpty() const noexcept {
+        return _window.isEmpty();
+    }
+
+    /**
+     * Get the median of the window. For an even number of samples, this is the lower of the two middle samples.
+     * Runtime: `O(log(size()))` expected
+     * @return The `(size() - 1) / 2`th smallest sample.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    DataType median() const {
+        _checkNotEmpty();
+        return select((_window.size() - 1) / 2);
+    }
+
+    /**
+     * Evict the oldest sample from the window.
+     * Runtime: `O(log(size()))` expected
+     * @return The evicted sample.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    DataType pop() {
+        _checkNotEmpty();
+        const DataType sample = _window.pop();
+        _remove(sample);
+        return sample;
+    }
+
+    /**
+     * Get the `q` quantile of the window: the sample of rank `floor(q * (size() - 1))`, so `0` gives the smallest,
+     * `0.5` the (lower) median and `1` the greatest.
+     * Runtime: `O(log(size()))` expected
+     * @param q Quantile to get, from `0` to `1`.
+     * @return The sample at that quantile.
+     * @throws std::invalid_argument If `q` is not between `0` and `1`.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    DataType quantile(const double q) const {
+        if (!(q >= 0 && q <= 1)) {
+            throw std::invalid_argument("Quantile " + std::to_string(q) + " is not between 0 and 1");
+        }
+        _checkNotEmpty();
+        return select(static_cast<size_t>(q * static_cast<double>(_window.size() - 1)));
+    }
+
+    /**
+     * Get the sample which would be at index `rank` if the window were sorted.
+     * Runtime: `O(log(size()))` expected
+     * @param rank Number of samples before the one to get in sorted order.
+     * @return The `rank`th smallest sample.
+     * @throws std::length_error If `rank >= size()`.
+     */
+    DataType select(const size_t rank) const {
+        if (rank >= _window.size()) {
+            throw std::length_error("Cannot select rank " + std::to_string(rank) + " of " + std::to_string(
+                    _window.size()) + " samples");
+        }
+        size_t node = HEAD;
+        // Number of positions left to advance, where the head is position 0 and the sample of rank `r` is `r + 1`.
+        size_t remaining = rank + 1;
+        const DataType* value = nullptr;
+        for (size_t level = MAX_LEVELS; level-- > 0;) {
+            for (const Link* link = &_links[node + level]; link->width <= remaining; link = &_links[node + level]) {
+                remaining -= link->width;
+                value = &link->nextValue;
+                node = link->next;
+            }
+        }
+        // `rank + 1 >= 1` positions were advanced, so `value` was set.
+        return *value;
+    }
+
+    /**
+     * Returns the number of samples in the window.
+     * Runtime: `O(1)`
+     * @return The number of samples.
+     */
+    size_t size() const noexcept {
+        return _window.size();
+    }
+
+    /**
+     * Get the samples of the window, from oldest to newest.
+     * Runtime: `O(1)`
+     * @return The window.
+     */
+    const VectorDeque<DataType>& window() const noexcept {
+        return _window;
+    }
+};
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef STATIC_VECTOR_DEQUE_HPP
+#define STATIC_VECTOR_DEQUE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+// `StaticVectorDeque` only needs relaxed constexpr (C++14) to be usable in constant expressions.
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+#define STATIC_VECTOR_DEQUE_CONSTEXPR constexpr
+#else
+#define STATIC_VECTOR_DEQUE_CONSTEXPR
+#endif
+
+/**
+ * `StaticVectorDeque` is a deque with a fixed capacity whose elements are stored inline rather than on the heap.
+ * It has the same `O(1)` access, append and prepend as `VectorDeque`, but it never resizes: adding to a full
+ * `StaticVectorDeque` throws instead.
+ * Since it never allocates, it is usable in constant expressions from C++14 on (provided `DataType` is a literal type),
+ * so queues such as BFS frontiers over static graphs can be computed entirely at compile time.
+ * @param DataType The type of the data to contain.
+ * @param CAPACITY The maximum number of elements.
+ */
+template <class DataType, size_t CAPACITY>
+class StaticVectorDeque {
+    static_assert(CAPACITY > 0, "StaticVectorDeque must have a positive capacity");
+
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class StaticVectorDequeTest;
+
+    // The stored data.
+    DataType _data[CAPACITY];
+
+    // Index in `_data` of the first element.
+    size_t _position;
+
+    // Total number of elements currently contained.
+    size_t _size;
+
+    // Check to see if `index` is valid.
+    // If not, throw `length_error`.
+    STATIC_VECTOR_DEQUE_CONSTEXPR void _checkIndex(const size_t index) const {
+        if (index >= _size) {
+            throw std::length_error(std::to_string(index));
+        }
+    }
+
+    // Check to see if this has at least `required` elements.
+    // If not, throw `length_error`.
+    STATIC_VECTOR_DEQUE_CONSTEXPR void _checkSize(const size_t required = 1) const {
+        if (required > 0) {
+            _checkIndex(required - 1);
+        }
+    }
+
+    // Check to see if `amount` more elements can fit in `*this`.
+    // If not, throw `length_error`.
+    STATIC_VECTOR_DEQUE_CONSTEXPR void _checkCanFit(const size_t amount = 1) const {
+        if (_size + amount > CAPACITY) {
+            throw std::length_error("StaticVectorDeque is full: capacity = " + std::to_string(CAPACITY));
+        }
+    }
+
+    // Compute the internal index for the offset `offset`.
+    STATIC_VECTOR_DEQUE_CONSTEXPR size_t _internalIndex(const size_t offset) const noexcept {
+        if (_position + offset < CAPACITY) {
+            return _position + offset;
+        }
+        return _position + offset - CAPACITY;
+    }
+
+    public:
+    /**
+     * Constructs an empty `StaticVectorDeque`.
+     * Runtime: `O(CAPACITY)`
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR StaticVectorDeque() noexcept: _data(), _position(0), _size(0) {}
+
+    /**
+     * Access the element at `index`.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @param index Index to get an element at.
+     * @return A reference to the element.
+     * @throws std::length_error If `index >= size()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR DataType& operator [](const size_t index) {
+        _checkIndex(index);
+        return _data[_internalIndex(index)];
+    }
+
+    /**
+     * Access the element at `index`.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @param index Index to get an element at.
+     * @return A constant reference to the element.
+     * @throws std::length_error If `index >= size()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR const DataType& operator [](const size_t index) const {
+        _checkIndex(index);
+        return _data[_internalIndex(index)];
+    }
+
+    /**
+     * Add `element` to the back of `*this`.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @param element Element to add.
+     * @throws std::length_error If `isFull()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR void add(const DataType& element) {
+        _checkCanFit();
+        _data[_internalIndex(_size)] = element;
+        ++_size;
+    }
+
+    /**
+     * Add `element` to the front of `*this`.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @param element Element to add.
+     * @throws std::length_error If `isFull()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR void addFirst(const DataType& element) {
+        _checkCanFit();
+        _position = _position == 0 ? CAPACITY - 1 : _position - 1;
+        _data[_position] = element;
+        ++_size;
+    }
+
+    /**
+     * Returns the maximum number of elements `*this` can contain.
+     * Runtime: `O(1)`
+     * @return `CAPACITY`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR size_t capacity() const noexcept {
+        return CAPACITY;
+    }
+
+    /**
+     * Remove all elements from `*this`.
+     * Runtime: `O(1)`
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR void clear() noexcept {
+        _size = 0;
+    }
+
+    /**
+     * Check to see where `element` is located in `*this`.
+     * Runtime: `O(size())`
+     * @param element Element to check for.
+     * @returns The first `i` such that `(*this)[i] == element` or `-1` if no such element exists.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR ptrdiff_t find(const DataType& element) const noexcept {
+        for (size_t i = 0; i < _size; ++i) {
+            if (element == _data[_internalIndex(i)]) {
+                return static_cast<ptrdiff_t>(i);
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Checks whether `*this` is empty.
+     * Runtime: `O(1)`
+     * @returns `true` If `size() == 0`, `false` otherwise.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR bool isEmpty() const noexcept {
+        return _size == 0;
+    }
+
+    /**
+     * Checks whether `*this` is full.
+     * Runtime: `O(1)`
+     * @returns `true` If `size() == capacity()`, `false` otherwise.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR bool isFull() const noexcept {
+        return _size == CAPACITY;
+    }
+
+    /**
+     * Get the first element of `*this`.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @return The first element of `*this`.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR DataType peek() const {
+        return (*this)[0];
+    }
+
+    /**
+     * Get the last element of `*this`.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @return The last element of `*this`.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR DataType peekLast() const {
+        _checkSize();
+        return (*this)[_size - 1];
+    }
+
+    /**
+     * Remove and return the first element.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @return The first element.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR DataType pop() {
+        const DataType popped = peek();
+        skip();
+        return popped;
+    }
+
+    /**
+     * Remove and return the last element.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @return The last element.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR DataType popLast() {
+        const DataType popped = peekLast();
+        skipLast();
+        return popped;
+    }
+
+    /**
+     * Returns the number of elements in `*this`.
+     * Runtime: `O(1)`
+     * @return The number of elements in `*this`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR size_t size() const noexcept {
+        return _size;
+    }
+
+    /**
+     * Removes `amount` elements from the front of `*this`.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @param amount Amount of elements to remove.
+     * @throws std::length_error If `amount > size()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR void skip(const size_t amount = 1) {
+        _checkSize(amount);
+        _position = _internalIndex(amount);
+        _size -= amount;
+    }
+
+    /**
+     * Removes `amount` elements from the back of `*this`.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @param amount Amount of elements to remove.
+     * @throws std::length_error If `amount > size()`.
+     */
+    STATIC_VECTOR_DEQUE_CONSTEXPR void skipLast(const size_t amount = 1) {
+        _checkSize(amount);
+        _size -= amount;
+    }
+};
+
+#endif
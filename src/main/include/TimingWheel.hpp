@@ -0,0 +1,291 @@
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "VectorDeque.hpp"
+
+/**
+ * Identifies a timer scheduled on a `TimingWheel`, for cancelling it. Handles of timers which have expired or been
+ * cancelled stay safe to use: they just no longer match any timer.
+ */
+struct TimerHandle {
+    // Index of the timer's node.
+    size_t node;
+
+    // Generation of the node when the timer was scheduled. Nodes are reused with a new generation.
+    uint64_t generation;
+};
+
+/**
+ * `TimingWheel` is a hierarchical timing wheel: a timer service where scheduling and cancelling are `O(1)` regardless
+ * of the number of timers. Time is counted in integer ticks of whatever unit the caller chooses.
+ * The wheel has `NUM_LEVELS` levels of `SLOTS_PER_LEVEL` slots, and each slot is a `VectorDeque` of timers. Level `L`
+ * slots each cover `SLOTS_PER_LEVEL^L` ticks, so a timer is placed at the lowest level whose slots can tell its
+ * deadline apart from the current time. As time advances, the slots of higher levels are reached and their timers
+ * cascade down to lower levels, until they reach level 0 and expire. Expiring and cascading drain a whole slot deque at
+ * once, and a bitmap of the occupied slots of each level lets `advance` jump straight to the next slot with timers
+ * instead of stepping through every tick.
+ * Timers live in a pool of reusable nodes, and the slots only hold node indices, so cascading moves indices rather than
+ * values. Cancelling only marks the node: it is reclaimed when its slot is next drained.
+ * @param DataType The type of the value carried by each timer, handed back when it expires.
+ */
+template <class DataType>
+class TimingWheel {
+    public:
+    /**
+     * Base 2 logarithm of the number of slots per level.
+     */
+    static const unsigned SLOT_BITS = 6;
+
+    /**
+     * Number of slots in each level.
+     */
+    static const size_t SLOTS_PER_LEVEL = static_cast<size_t>(1) << SLOT_BITS;
+
+    /**
+     * Number of levels, enough for the levels to cover every 64-bit deadline.
+     */
+    static const size_t NUM_LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS;
+
+    private:
+    // Allow testing class to access private methods and fields.
+    friend class TimingWheelTest;
+
+    struct Node {
+        DataType value;
+        uint64_t deadline;
+        uint64_t generation;
+        // Whether the timer is still scheduled, as opposed to cancelled. Expired and free nodes are never in a slot.
+        bool pending;
+    };
+
+    // Pool of timer nodes, and the indices of the free ones.
+    std::vector<Node> _nodes;
+    VectorDeque<size_t> _freeNodes;
+
+    // Node indices of the timers in each slot of each level.
+    VectorDeque<size_t> _slots[NUM_LEVELS][SLOTS_PER_LEVEL];
+
+    // Bit `s` of `_occupied[L]` is set if and only if slot `s` of level `L` is non-empty.
+    uint64_t _occupied[NUM_LEVELS];
+
+    // Current time. Every timer with a deadline at or before it has expired.
+    uint64_t _now;
+
+    // Number of scheduled timers which have not been cancelled.
+    size_t _size;
+
+    static unsigned _highestBit(const uint64_t bits) noexcept {
+#if defined(__GNUC__)
+        return 63 - static_cast<unsigned>(__builtin_clzll(bits));
+#else
+        unsigned bit = 0;
+        for (uint64_t rest = bits >> 1; rest != 0; rest >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static unsigned _lowestBit(const uint64_t bits) noexcept {
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+        unsigned bit = 0;
+        for (uint64_t rest = bits; (rest & 1) == 0; rest >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    // Index of the slot of level `level` containing `time`.
+    static size_t _slotOf(const uint64_t time, const size_t level) noexcept {
+        return static_cast<size_t>((time >> (level * SLOT_BITS)) & (SLOTS_PER_LEVEL - 1));
+    }
+
+    // Drain slot `slot` of level `level`: expired timers are added to `expired`, cancelled ones are reclaimed and any
+    // others are placed again relative to the current time. Returns the number of timers expired.
+    size_t _drain(const size_t level, const size_t slot, VectorDeque<DataType>& expired) {
+        VectorDeque<size_t>& deque = _slots[level][slot];
+        _occupied[level] &= ~(static_cast<uint64_t>(1) << slot);
+        size_t numExpired = 0;
+        const VectorDequeSegments<size_t> segments = deque.segments();
+        const VectorDequeSegment<size_t> parts[] = {segments.first, segments.second};
+        for (const VectorDequeSegment<size_t>& part: parts) {
+            for (const size_t index: part) {
+                Node& node = _nodes[index];
+                if (!node.pending) {
+                    _free(index);
+                } else if (node.deadline <= _now) {
+                    expired.add(node.value);
+                    --_size;
+                    _free(index);
+                    ++numExpired;
+                } else {
+                    // Placed at a lower level, so never into `deque` itself.
+                    _place(index);
+                }
+            }
+        }
+        deque.clear();
+        return numExpired;
+    }
+
+    void _free(const size_t index) {
+        Node& node = _nodes[index];
+        node.value = DataType();
+        node.pending = false;
+        ++node.generation;
+        _freeNodes.add(index);
+    }
+
+    // Smallest time after the current one at which a slot has to be drained, or `limit` if that is later.
+    uint64_t _nextEvent(const uint64_t limit) const noexcept {
+        uint64_t next = limit;
+        for (size_t level = 0; level < NUM_LEVELS; ++level) {
+            // Every occupied slot of a level comes after the current one: the slot containing the current time has
+            // already been drained.
+            const size_t current = _slotOf(_now, level);
+            const uint64_t later = current + 1 == SLOTS_PER_LEVEL ? 0
+                    : _occupied[level] & (~static_cast<uint64_t>(0) << (current + 1));
+            if (later == 0) {
+                continue;
+            }
+            const unsigned shift = static_cast<unsigned>(level * SLOT_BITS);
+            const unsigned aboveShift = shift + SLOT_BITS;
+            const uint64_t base = aboveShift >= 64 ? 0 : (_now >> aboveShift) << aboveShift;
+            const uint64_t time = base + (static_cast<uint64_t>(_lowestBit(later)) << shift);
+            next = time < next ? time : next;
+        }
+        return next;
+    }
+
+    // Put the node at `index` in the slot for its deadline, which must not be before the current time.
+    void _place(const size_t index) {
+        const uint64_t deadline = _nodes[index].deadline;
+        const uint64_t differing = deadline ^ _now;
+        const size_t level = differing == 0 ? 0 : _highestBit(differing) / SLOT_BITS;
+        const size_t slot = _slotOf(deadline, level);
+        _slots[level][slot].add(index);
+        _occupied[level] |= static_cast<uint64_t>(1) << slot;
+    }
+
+    public:
+    /**
+     * Constructs an empty `TimingWheel`.
+     * Runtime: `O(NUM_LEVELS * SLOTS_PER_LEVEL)`
+     * @param now The current time.
+     */
+    explicit TimingWheel(const uint64_t now = 0): _occupied(), _now(now), _size(0) {
+        for (size_t level = 0; level < NUM_LEVELS; ++level) {
+            for (size_t slot = 0; slot < SLOTS_PER_LEVEL; ++slot) {
+                // Most slots are never used, so only allocate on first use.
+                _slots[level][slot] = VectorDeque<size_t>(0);
+            }
+        }
+    }
+
+    /**
+     * Advance the current time to `now`, expiring every timer whose deadline is at or before it. Timers are expired in
+     * order of deadline, and timers with the same deadline in the order they were scheduled unless some of them were
+     * scheduled further ahead than others.
+     * Runtime: `O(number of timers expired or cascaded + NUM_LEVELS * number of slots drained)`
+     * @param now The new current time. Times before the current one are ignored.
+     * @param expired Deque the values of the expired timers are added to.
+     * @return The number of timers expired.
+     */
+    size_t advance(const uint64_t now, VectorDeque<DataType>& expired) {
+        size_t numExpired = 0;
+        while (_now < now) {
+            _now = _nextEvent(now);
+            // Cascade from the highest level reached down, so that timers can fall through several levels at once.
+            for (size_t level = NUM_LEVELS - 1; level > 0; --level) {
+                const unsigned shift = static_cast<unsigned>(level * SLOT_BITS);
+                const size_t slot = _slotOf(_now, level);
+                if ((_now & ((static_cast<uint64_t>(1) << shift) - 1)) == 0
+                        && (_occupied[level] >> slot & 1) != 0) {
+                    numExpired += _drain(level, slot, expired);
+                }
+            }
+            const size_t slot = _slotOf(_now, 0);
+            if ((_occupied[0] >> slot & 1) != 0) {
+                numExpired += _drain(0, slot, expired);
+            }
+        }
+        return numExpired;
+    }
+
+    /**
+     * Cancel the timer of `handle` so that it never expires.
+     * Runtime: `O(1)`
+     * @param handle Handle of the timer.
+     * @return `true` If the timer was cancelled, `false` if it had already expired or been cancelled.
+     */
+    bool cancel(const TimerHandle& handle) noexcept {
+        if (!isPending(handle)) {
+            return false;
+        }
+        _nodes[handle.node].pending = false;
+        --_size;
+        return true;
+    }
+
+    /**
+     * Returns whether the timer of `handle` is still scheduled.
+     * Runtime: `O(1)`
+     * @param handle Handle of the timer.
+     * @return `true` If the timer has neither expired nor been cancelled.
+     */
+    bool isPending(const TimerHandle& handle) const noexcept {
+        return handle.node < _nodes.size() && _nodes[handle.node].generation == handle.generation
+                && _nodes[handle.node].pending;
+    }
+
+    /**
+     * Returns the current time.
+     * Runtime: `O(1)`
+     * @return The current time.
+     */
+    uint64_t now() const noexcept {
+        return _now;
+    }
+
+    /**
+     * Schedule a timer carrying `value` to expire at `deadline`.
+     * Runtime: Amortized `O(1)`
+     * @param value The value to hand back when the timer expires.
+     * @param deadline The time to expire at. Deadlines at or before the current time expire on the next advance.
+     * @return Handle of the timer, for cancelling it.
+     */
+    TimerHandle schedule(const DataType& value, const uint64_t deadline) {
+        size_t index;
+        if (_freeNodes.isEmpty()) {
+            index = _nodes.size();
+            _nodes.push_back(Node{value, 0, 0, true});
+        } else {
+            index = _freeNodes.popLast();
+            _nodes[index].value = value;
+            _nodes[index].pending = true;
+        }
+        // A deadline which has passed could not be told apart from the current time, whose slot is already drained.
+        _nodes[index].deadline = deadline > _now ? deadline : _now + 1;
+        _place(index);
+        ++_size;
+        return TimerHandle{index, _nodes[index].generation};
+    }
+
+    /**
+     * Returns the number of scheduled timers, not counting cancelled ones.
+     * Runtime: `O(1)`
+     * @return The number of timers.
+     */
+    size_t size() const noexcept {
+        return _size;
+    }
+};
+
+#endif
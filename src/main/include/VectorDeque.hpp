@@ -1,8 +1,72 @@
+#ifndef VECTOR_DEQUE_HPP
+#define VECTOR_DEQUE_HPP
+
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <cstring>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Hashing.hpp"
+#include "VectorDequePolicies.hpp"
+
+/**
+ * A run of elements which are contiguous in the backing array of a `VectorDeque`.
+ * Since `begin()` and `end()` are pointers, a segment is itself a contiguous range, so loops and algorithms over it
+ * compile down to plain array code.
+ * @param MemberType The type of the elements, `const`-qualified for read-only segments.
+ */
+template <class MemberType>
+struct VectorDequeSegment {
+    // First element of the segment.
+    MemberType* data;
+
+    // Number of elements in the segment.
+    size_t length;
+
+    VECTOR_DEQUE_CONSTEXPR MemberType* begin() const noexcept {
+        return data;
+    }
+
+    VECTOR_DEQUE_CONSTEXPR MemberType* end() const noexcept {
+        return data + length;
+    }
+
+    VECTOR_DEQUE_CONSTEXPR size_t size() const noexcept {
+        return length;
+    }
+};
+
+/**
+ * The (up to) two contiguous segments making up a range of a `VectorDeque`, in order. If the range does not wrap
+ * around the end of the backing array, `second` is empty.
+ * @param MemberType The type of the elements, `const`-qualified for read-only segments.
+ */
+template <class MemberType>
+struct VectorDequeSegments {
+    VectorDequeSegment<MemberType> first;
+    VectorDequeSegment<MemberType> second;
+};
+
+/**
+ * A backing array handed out by `VectorDeque::release`: `size` elements from index `0` of an array of `capacity`
+ * elements, which the receiver owns and frees with `delete[]`.
+ * @param DataType The type of the elements.
+ */
+template <class DataType>
+struct VectorDequeBuffer {
+    DataType* data;
+    size_t size;
+    size_t capacity;
+};
 
 /**
  * `VectorDeque` satisfies the resource constraints typically expected of both Vectors and Deques. In particular, it has
@@ -16,29 +80,54 @@
  * to the `VectorDeque` will not change that index. For example, suppose an element is added to the front of the
  * `VectorDeque` while an iterator is pointing to the third element. That iterator will now be pointing to what was
  * previously the second element, since that element is now the third element and the iterator's index did not change.
+ *
+ * `VectorDeque<DataType>` is `BasicVectorDeque<DataType>` with the default policies. Other policies (see
+ * `VectorDequePolicies.hpp`) can change how bounds are checked, how capacity grows, how indices wrap, where the
+ * backing array is stored, whether the size is bounded and who is notified of modifications, without any overhead for
+ * the policies not in use. Observers are reached through `observer()`.
  * @param DataType The type of the data to contain.
+ * @param Policies The policies to use, in any order.
  */
-template <class DataType>
-class VectorDeque {
+template <class DataType, class... Policies>
+class BasicVectorDeque: private vector_deque_detail::ResolvePolicies<DataType, Policies...>::Storage,
+        public vector_deque_detail::ResolvePolicies<DataType, Policies...>::Overflow,
+        private vector_deque_detail::ResolvePolicies<DataType, Policies...>::Observers::template
+                ObserverSet<BasicVectorDeque<DataType, Policies...> > {
     private:
-    // Allow testing class to access private methods and fields.
+    // Allow testing classes to access private methods and fields.
+    friend class BasicVectorDequeTest;
     friend class VectorDequeTest;
+    friend struct vector_deque_detail::ObserverAccess;
+
+    // Allow transfers between deques with different policies.
+    template <class, class...> friend class BasicVectorDeque;
+
+    typedef vector_deque_detail::ResolvePolicies<DataType, Policies...> Resolved;
+    typedef typename Resolved::BoundsChecking BoundsChecking;
+    typedef typename Resolved::Growth Growth;
+    typedef typename Resolved::Index Index;
+    typedef typename Resolved::Observers::template ObserverSet<BasicVectorDeque> Observers;
+    typedef typename Resolved::Overflow Overflow;
+    typedef typename Resolved::Storage Storage;
+    typedef typename Resolved::Wrapping Wrapping;
 
     // Base class for the mutable and immutable iterator implementations.
     template <class VectorDequeType, class MemberType, bool IS_REVERSE>
     class IteratorBase {
-        typedef IteratorBase<VectorDeque, DataType, IS_REVERSE> Iterator;
-        typedef IteratorBase<const VectorDeque, const DataType, IS_REVERSE> ConstIterator;
-        friend VectorDeque;
+        typedef IteratorBase<BasicVectorDeque, DataType, IS_REVERSE> Iterator;
+        typedef IteratorBase<const BasicVectorDeque, const DataType, IS_REVERSE> ConstIterator;
+        friend BasicVectorDeque;
+        template <class, class, bool> friend class IteratorBase;
 
         private:
         // Position in the VectorDeque this iterator is pointing to.
         size_t _position;
 
         // Pointer to VectorDeque this iterator is iterating on.
-        VectorDequeType* const _vectorDequePtr;
+        VectorDequeType* _vectorDequePtr;
 
-        static MemberType& dereferenceAt(VectorDequeType* const vectorDequePtr, const ptrdiff_t position) throw() {
+        VECTOR_DEQUE_CONSTEXPR static MemberType& dereferenceAt(VectorDequeType* const vectorDequePtr,
+                const ptrdiff_t position) {
             if (IS_REVERSE) {
                 return (*vectorDequePtr)[vectorDequePtr->size() - position - 1];
             }
@@ -46,25 +135,37 @@ class VectorDeque {
         }
 
         public:
+        // Standard iterator typedefs, which make these random access iterators for `std::iterator_traits`, and for
+        // the `std::random_access_iterator` concept from C++20 on.
+        typedef std::random_access_iterator_tag iterator_category;
+#if defined(__cpp_lib_concepts)
+        typedef std::random_access_iterator_tag iterator_concept;
+#endif
+        typedef typename std::remove_const<MemberType>::type value_type;
+        typedef ptrdiff_t difference_type;
+        typedef MemberType* pointer;
+        typedef MemberType& reference;
+
         // Constructs an Iterator from a VectorDeque pointer and a position.
-        IteratorBase(VectorDequeType* const vectorDequePtr, const size_t position) throw():
+        VECTOR_DEQUE_CONSTEXPR IteratorBase(VectorDequeType* const vectorDequePtr, const size_t position) noexcept:
                 _vectorDequePtr(vectorDequePtr), _position(position) {}
 
         // Constructs an Iterator from a VectorDeque pointer.
-        IteratorBase(VectorDequeType* const vectorDequePtr) throw(): _vectorDequePtr(vectorDequePtr), _position(0) {}
+        VECTOR_DEQUE_CONSTEXPR IteratorBase(VectorDequeType* const vectorDequePtr) noexcept:
+                _vectorDequePtr(vectorDequePtr), _position(0) {}
 
         /**
          * Construct an iterator which is not pointing to anything.
          * Runtime: `O(1)`
          */
-        IteratorBase() throw(): _position(0), _vectorDequePtr(NULL) {}
+        VECTOR_DEQUE_CONSTEXPR IteratorBase() noexcept: _position(0), _vectorDequePtr(NULL) {}
 
         /**
          * Construct an iterator by copying the state of another iterator.
          * Runtime: `O(1)`
          * @param that Iterator to copy the state from.
          */
-        IteratorBase(const Iterator& that) throw(): _position(that._position), 
+        VECTOR_DEQUE_CONSTEXPR IteratorBase(const Iterator& that) noexcept: _position(that._position), 
         _vectorDequePtr(that._vectorDequePtr) {}
 
         /**
@@ -72,7 +173,7 @@ class VectorDeque {
          * Runtime: `O(1)`
          * @param that Iterator to copy the state from.
          */
-        IteratorBase(const ConstIterator& that) throw(): _position(that._position), 
+        VECTOR_DEQUE_CONSTEXPR IteratorBase(const ConstIterator& that) noexcept: _position(that._position), 
                 _vectorDequePtr(that._vectorDequePtr) {}
 
         /**
@@ -81,9 +182,9 @@ class VectorDeque {
          * @param that Iterator to copy the state from.
          * @return A reference to `*this`.
          */
-        IteratorBase& operator =(const Iterator& that) throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase& operator =(const Iterator& that) noexcept {
             _position = that._position;
-            _vectorDequePtr = that._vectorDequePointer;
+            _vectorDequePtr = that._vectorDequePtr;
             return *this;
         }
 
@@ -93,9 +194,9 @@ class VectorDeque {
          * @param that Iterator to copy the state from.
          * @return A reference to `*this`.
          */
-        IteratorBase& operator =(const ConstIterator& that) throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase& operator =(const ConstIterator& that) noexcept {
             _position = that._position;
-            _vectorDequePtr = that._vectorDequePointer;
+            _vectorDequePtr = that._vectorDequePtr;
             return *this;
         }
 
@@ -104,7 +205,7 @@ class VectorDeque {
          * Runtime: `O(1)`
          * @return An immutable copy of `*this`.
          *
-        operator ConstIterator() const throw() {
+        operator ConstIterator() const noexcept {
             return ConstIterator(*this);
         }
         */
@@ -116,7 +217,7 @@ class VectorDeque {
          * @return `true` If `*this` and `that` are iterating over the same object at the same position and 
          *          direction, `false` otherwise.
          */
-        bool operator ==(const ConstIterator& that) const throw() {
+        VECTOR_DEQUE_CONSTEXPR bool operator ==(const ConstIterator& that) const noexcept {
             return _position == that._position && _vectorDequePtr == that._vectorDequePtr;
         }
 
@@ -127,7 +228,7 @@ class VectorDeque {
          * @return `true` If `*this` and `that` are iterating over different objects or at different positions, 
          *         `false` otherwise.
          */
-        bool operator !=(const ConstIterator& that) const throw() {
+        VECTOR_DEQUE_CONSTEXPR bool operator !=(const ConstIterator& that) const noexcept {
             return !(*this == that);
         }
 
@@ -138,7 +239,7 @@ class VectorDeque {
          * @return `true` If `*this` points to an earlier element than `that` and `*this != that`, `false` 
          *         otherwise.
          */
-        bool operator <(const ConstIterator& that) const throw() {
+        VECTOR_DEQUE_CONSTEXPR bool operator <(const ConstIterator& that) const noexcept {
             return _position < that._position;
         }
 
@@ -149,7 +250,7 @@ class VectorDeque {
          * @return `true` If `*this` points to a later element than `that` and `*this != that`, `false` 
          *         otherwise.
          */
-        bool operator >(const ConstIterator& that) const throw() {
+        VECTOR_DEQUE_CONSTEXPR bool operator >(const ConstIterator& that) const noexcept {
             return _position > that._position;
         }
 
@@ -161,7 +262,7 @@ class VectorDeque {
          * @return `true` If `*this` points to an earlier element than `that` or `*this == that`, `false` 
          *         otherwise.
          */
-        bool operator <=(const ConstIterator& that) const throw() {
+        VECTOR_DEQUE_CONSTEXPR bool operator <=(const ConstIterator& that) const noexcept {
             return *this == that || *this < that;
         }
 
@@ -173,7 +274,7 @@ class VectorDeque {
          * @return `true` If `*this` points to a later element than `that` or `*this == that`, `false` 
          *         otherwise.
          */
-        bool operator >=(const ConstIterator& that) const throw() {
+        VECTOR_DEQUE_CONSTEXPR bool operator >=(const ConstIterator& that) const noexcept {
             return *this == that || *this > that;
         }
 
@@ -182,7 +283,7 @@ class VectorDeque {
          * Runtime: `O(1)`
          * @return A reference to `*this`.
          */
-        IteratorBase& operator ++() throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase& operator ++() noexcept {
             ++_position;
             return *this;
         }
@@ -192,7 +293,7 @@ class VectorDeque {
          * Runtime: `O(1)`
          * @return A copy of `*this` before incrementation.
          */
-        IteratorBase operator ++(int) throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase operator ++(int) noexcept {
             const IteratorBase copy(*this);
             ++_position;
             return copy;
@@ -203,7 +304,7 @@ class VectorDeque {
          * Runtime: `O(1)`
          * @return A reference to `*this`.
          */
-        IteratorBase& operator --() throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase& operator --() noexcept {
             --_position;
             return *this;
         }
@@ -213,7 +314,7 @@ class VectorDeque {
          * Runtime: `O(1)`
          * @return A copy of `*this` before decrementation.
          */
-        IteratorBase operator --(int) throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase operator --(int) noexcept {
             const IteratorBase copy(*this);
             --_position;
             return copy;
@@ -225,7 +326,7 @@ class VectorDeque {
          * @param amount Amount to advance by.
          * @return A reference to `*this`.
          */
-        IteratorBase& operator +=(const ptrdiff_t amount) throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase& operator +=(const ptrdiff_t amount) noexcept {
             _position += amount;
             return *this;
         }
@@ -236,7 +337,7 @@ class VectorDeque {
          * @param amount Amount to regress by.
          * @return A reference to `*this`.
          */
-        IteratorBase& operator -=(const ptrdiff_t amount) throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase& operator -=(const ptrdiff_t amount) noexcept {
             _position -= amount;
             return *this;
         }
@@ -248,7 +349,7 @@ class VectorDeque {
          * @param amount Amount to advance by.
          * @return The resulting iterator.
          */
-        IteratorBase operator +(const ptrdiff_t amount) const throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase operator +(const ptrdiff_t amount) const noexcept {
             return IteratorBase(*this) += amount;
         }
         
@@ -259,7 +360,7 @@ class VectorDeque {
          * @param it Iterator to compute advancement for.
          * @return The resulting iterator.
          */
-        friend IteratorBase operator +(const ptrdiff_t amount, const IteratorBase& it) throw() {
+        VECTOR_DEQUE_CONSTEXPR friend IteratorBase operator +(const ptrdiff_t amount, const IteratorBase& it) noexcept {
             return it + amount;            
         }
 
@@ -270,7 +371,7 @@ class VectorDeque {
          * @param amount Amount to advance by.
          * @return The resulting iterator.
          */
-        IteratorBase operator -(const ptrdiff_t amount) const throw() {
+        VECTOR_DEQUE_CONSTEXPR IteratorBase operator -(const ptrdiff_t amount) const noexcept {
             return IteratorBase(*this) -= amount;
         }
 
@@ -283,7 +384,7 @@ class VectorDeque {
          * @param that Iterator to compute difference for.
          * @return Difference between positional offsets of `*this` and `that`.
          */
-        ptrdiff_t operator -(const ConstIterator& that) const throw() {
+        VECTOR_DEQUE_CONSTEXPR ptrdiff_t operator -(const ConstIterator& that) const noexcept {
             return static_cast<ptrdiff_t>(_position) - that._position;
         }
         
@@ -294,7 +395,7 @@ class VectorDeque {
          * @return A reference to the value pointed to by `*this`.
          * @throws std::length_error If `*this` is pointing to an out-of-bounds element.
          */
-        MemberType& operator *() const {
+        VECTOR_DEQUE_CONSTEXPR MemberType& operator *() const {
             return dereferenceAt(_vectorDequePtr, static_cast<ptrdiff_t>(_position));
         }
 
@@ -304,7 +405,7 @@ class VectorDeque {
          * @return Member of the value pointed to by `*this`.
          * @throws std::length_error If `*this` is pointing to an out-of-bounds element.
          */
-        MemberType* operator ->() const throw() {
+        VECTOR_DEQUE_CONSTEXPR MemberType* operator ->() const noexcept {
             return &(**this);
         }
 
@@ -315,184 +416,437 @@ class VectorDeque {
          * @return The member resulting from offsetting `*this` by `offset`.
          * @throws std::length_error If the offset position is out-of-bounds.
          */
-        MemberType& operator [](const ptrdiff_t offset) const {
+        VECTOR_DEQUE_CONSTEXPR MemberType& operator [](const ptrdiff_t offset) const {
             return dereferenceAt(_vectorDequePtr, static_cast<ptrdiff_t>(_position) + offset);
         }
+
+        /**
+         * Get the contiguous segments of the elements from `*this` until `end`. Algorithms can detect this method to
+         * process each segment with a plain array loop instead of going through the iterator (see
+         * `SegmentedAlgorithms.hpp`). Only forward iterators have segments.
+         * Runtime: `O(1)`
+         * Exception Safety: Strong
+         * @param end Iterator past the last element of the range.
+         * @return The segments of the range.
+         * @throws std::length_error If `end` points past the end of the `VectorDeque`.
+         * @throws std::invalid_argument If `end` comes before `*this`.
+         */
+        template <bool FORWARD = !IS_REVERSE>
+        VECTOR_DEQUE_CONSTEXPR typename std::enable_if<FORWARD, VectorDequeSegments<MemberType> >::type segmentsUntil(
+                const IteratorBase& end) const {
+            return _vectorDequePtr->template _segments<MemberType>(_position, end._position);
+        }
     };
     
-    // Length of current backing array.
-    size_t _capacity;
-
     // The stored data.
     DataType* _data;
 
+    // Length of current backing array.
+    Index _capacity;
+
     // Index in the backing array of the first element.
-    size_t _position;
+    Index _position;
 
     // Total number of elements currently contained.
-    size_t _size;
+    Index _size;
+
+    // Add `element` to the back, regardless of the maximum size.
+    VECTOR_DEQUE_CONSTEXPR void _add(const DataType& element) {
+        _ensureCanFit();
+        _data[_writePosition()] = element;
+        ++_size;
+        Observers::notifyAdd(*this, 1);
+    }
+
+    // Move `element` to the back, regardless of the maximum size.
+    VECTOR_DEQUE_CONSTEXPR void _add(DataType&& element) {
+        _ensureCanFit();
+        _data[_writePosition()] = std::move(element);
+        ++_size;
+        Observers::notifyAdd(*this, 1);
+    }
 
     // Add `length` elements from `elements` to the back.
     // Assumes length of internal array has already been verified.
-    void _addAll(const DataType* const elements, const size_t start, const size_t length) throw() {
+    VECTOR_DEQUE_CONSTEXPR void _addAll(const DataType* const elements, const size_t start,
+            const size_t length) {
         // Number of elements before wrapping around to beginning.
         const size_t numBeforeWrap = std::min(_capacity - start, length);
         const size_t numAfterWrap = length - numBeforeWrap;
-        std::memcpy(_data + start, elements, sizeof(DataType) * numBeforeWrap);
-        std::memcpy(_data, elements + numBeforeWrap, sizeof(DataType) * numAfterWrap);
+        _copy(_data + start, elements, numBeforeWrap);
+        _copy(_data, elements + numBeforeWrap, numAfterWrap);
+    }
+
+    // Add `element` to the front, regardless of the maximum size.
+    VECTOR_DEQUE_CONSTEXPR void _addFirst(const DataType& element) {
+        _ensureCanFit();
+        _position = Wrapping::wrapBackwards(_position, 1, _capacity);
+        // The position is now at the element which was added to the front.
+        _data[_position] = element;
+        ++_size;
+        Observers::notifyAddFirst(*this, 1);
+    }
+
+    // Move `element` to the front, regardless of the maximum size.
+    VECTOR_DEQUE_CONSTEXPR void _addFirst(DataType&& element) {
+        _ensureCanFit();
+        _position = Wrapping::wrapBackwards(_position, 1, _capacity);
+        _data[_position] = std::move(element);
+        ++_size;
+        Observers::notifyAddFirst(*this, 1);
+    }
+
+    // Decide which of a batch of `count` elements to add to the front if `atFront`, or else to the back. If they would
+    // exceed the maximum size, the overflow policy decides and makes room for them.
+    VECTOR_DEQUE_CONSTEXPR OverflowDecision _admit(const size_t count, const bool atFront) {
+        return _admit(count, atFront, std::integral_constant<bool, Overflow::BOUNDED>());
+    }
+
+    VECTOR_DEQUE_CONSTEXPR OverflowDecision _admit(const size_t count, const bool atFront, std::true_type) {
+        if (!_exceedsMaxSize(count)) {
+            return OverflowDecision{0, count};
+        }
+        return Overflow::overflow(*this, count, atFront);
+    }
+
+    VECTOR_DEQUE_CONSTEXPR OverflowDecision _admit(const size_t count, const bool, std::false_type) const noexcept {
+        return OverflowDecision{0, count};
     }
     
+    // Access the element at `index` without notifying observers, so that accesses made internally by other methods
+    // are not reported as accesses.
+    VECTOR_DEQUE_CONSTEXPR DataType& _at(const size_t index) const {
+        _checkIndex(index);
+        return _data[_internalIndex(index)];
+    }
+
+    // Check to see if a backing array of `capacity` elements can be indexed by `Index`.
+    // If not, throw `length_error`.
+    VECTOR_DEQUE_CONSTEXPR void _checkCapacity(const size_t capacity) const {
+        if (capacity > _maxCapacity()) {
+            throw std::length_error("Capacity " + std::to_string(capacity) + " exceeds the maximum of "
+                    + std::to_string(_maxCapacity()) + " for the index type");
+        }
+    }
+
     // Check to see if `index` is valid.
     // If not, throw `length_error`.
-    void _checkIndex(const size_t index) const {
-        if (index >= _size) {
-            throw std::length_error(std::to_string(index));
+    VECTOR_DEQUE_CONSTEXPR void _checkIndex(const size_t index) const {
+        if (BoundsChecking::ENABLED && index >= _size) {
+            BoundsChecking::template fail<std::length_error>(std::to_string(index));
         }
     }
 
     // Check to see if `it` iterates over `*this`.
     // If not, throw `invalid_argument`.
     template <class IteratorType>
-    void _checkIterator(const IteratorType& it) const {
+    VECTOR_DEQUE_CONSTEXPR void _checkIterator(const IteratorType& it) const {
         if (this != it._vectorDequePtr) {
             throw std::invalid_argument("Iterator is not iterating over this VectorDeque");
         }
     }
 
+    // Check to see if `amount` more elements fit within the maximum size.
+    // If not, throw `length_error`.
+    VECTOR_DEQUE_CONSTEXPR void _checkMaxSize(const size_t amount) const {
+        if (_exceedsMaxSize(amount)) {
+            throw std::length_error("Adding " + std::to_string(amount) + " elements would exceed the maximum size of "
+                    + std::to_string(Overflow::maxSize()));
+        }
+    }
+
     // Check to see if `[from, until)` is a valid range.
     // If not, throw `length_error`.
-    void _checkRange(const size_t from, const size_t until) const {
+    VECTOR_DEQUE_CONSTEXPR void _checkRange(const size_t from, const size_t until) const {
         _checkSize(until);
-        if (from > until) {
-            throw std::invalid_argument("Bad range: start = " + std::to_string(from) + ", end = " + 
-                    std::to_string(until));
+        if (BoundsChecking::ENABLED && from > until) {
+            BoundsChecking::template fail<std::invalid_argument>("Bad range: start = " + std::to_string(from) +
+                    ", end = " + std::to_string(until));
         }
     }
 
     // Check to see if this has at least `required` elements.
     // If not, throw `length_error`.
-    void _checkSize(const size_t required = 1) const {
+    VECTOR_DEQUE_CONSTEXPR void _checkSize(const size_t required = 1) const {
         if (required > 0) {
             _checkIndex(required - 1);
         }
     }
 
+    // Check to see if `target` is a different deque than `*this`.
+    // If not, throw `invalid_argument`.
+    template <class TargetDeque>
+    VECTOR_DEQUE_CONSTEXPR void _checkTransferTarget(const TargetDeque& target) const {
+        if (static_cast<const void*>(this) == static_cast<const void*>(&target)) {
+            throw std::invalid_argument("Cannot transfer elements of a VectorDeque to itself");
+        }
+    }
+
+    // Copy `length` elements from `source` to `target`.
+    // The ranges may overlap as long as `target` does not come after `source`.
+    VECTOR_DEQUE_CONSTEXPR static void _copy(DataType* const target, const DataType* const source,
+            const size_t length) {
+#if defined(__cpp_lib_is_constant_evaluated)
+        if (std::is_constant_evaluated()) {
+            // `memmove` may not be used during constant evaluation.
+            std::copy(source, source + length, target);
+            return;
+        }
+#endif
+        _copy(target, source, length, std::is_trivially_copyable<DataType>());
+    }
+
+    // Copy trivially copyable elements in bulk.
+    static void _copy(DataType* const target, const DataType* const source, const size_t length,
+            std::true_type) noexcept {
+        if (length != 0) {
+            // A moved-from deque has no backing array, which `memmove` does not accept even for 0 elements.
+            std::memmove(target, source, sizeof(DataType) * length);
+        }
+    }
+
+    // Copy any other elements one at a time, since their bytes may own resources that a bulk copy would share.
+    static void _copy(DataType* const target, const DataType* const source, const size_t length, std::false_type) {
+        std::copy(source, source + length, target);
+    }
+
+    // Forget the backing array, which has been freed or handed out, leaving `*this` empty with no backing array like a
+    // moved-from deque.
+    VECTOR_DEQUE_CONSTEXPR void _disown() noexcept {
+        const size_t numRemoved = _size;
+        const size_t oldCapacity = _capacity;
+        _init(0, NULL);
+        Observers::notifyRemove(*this, numRemoved);
+        Observers::notifyResize(*this, oldCapacity);
+    }
+
     // Check to see if the current backing array has length at least `required`.
     // If not, resize.
-    void _ensureCapacity(const size_t required) throw() {
+    VECTOR_DEQUE_CONSTEXPR void _ensureCapacity(const size_t required) {
         if (_capacity < required) {
-            const size_t newCapacity = required * 2 + 1;
-            DataType* const newData = new DataType[newCapacity];
-            copyToArray(newData);
-            _position = 0;
-            delete[] _data;
-            _data = newData;
-            _capacity = newCapacity;
+            size_t newCapacity = _grownCapacity(required);
+            DataType* const newData = Storage::allocate(newCapacity);
+            _moveSliceToArray(newData, 0, _size);
+            _replaceData(newData, newCapacity);
         }
     }
 
     // Check to see if `amount` more elements can fit in `*this`.
     // If not, resize.
-    void _ensureCanFit(const size_t amount = 1) throw() {
+    VECTOR_DEQUE_CONSTEXPR void _ensureCanFit(const size_t amount = 1) {
         _ensureCapacity(_size + amount);
     }
 
+    // Whether adding `amount` more elements would exceed the maximum size. Always `false` for unbounded deques.
+    VECTOR_DEQUE_CONSTEXPR bool _exceedsMaxSize(const size_t amount) const noexcept {
+        return Overflow::BOUNDED && (amount > Overflow::maxSize() || _size > Overflow::maxSize() - amount);
+    }
+
+    // Capacity to grow to when `required` elements are needed, limited to the maximum capacity.
+    VECTOR_DEQUE_CONSTEXPR size_t _grownCapacity(const size_t required) const {
+        _checkCapacity(required);
+        const size_t grown = std::min(Growth::grow(_capacity, required), _maxCapacity());
+        if (!Wrapping::REQUIRES_POWER_OF_TWO) {
+            return grown;
+        }
+        // Rounding the growth step up to a power of two would compound with it (doubling 16 would give 64), so round
+        // it down instead, to no less than the capacity needed for `required`. Every step below the maximum at least
+        // doubles.
+        size_t capacity = Wrapping::capacityFor(required);
+        while (capacity <= grown / 2) {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    // Hash the contents by feeding the bytes of each contiguous segment in bulk.
+    // Only used for types where equal values are guaranteed to have equal bytes.
+    size_t _hash(std::true_type) const noexcept {
+        StreamingHasher hasher(_size);
+        const size_t numBeforeWrap = _numBeforeWrap(_position, _size);
+        hasher.update(_data + _position, sizeof(DataType) * numBeforeWrap);
+        hasher.update(_data, sizeof(DataType) * (_size - numBeforeWrap));
+        return static_cast<size_t>(hasher.digest());
+    }
+
+    // Hash the contents by combining the `std::hash` of each element.
+    size_t _hash(std::false_type) const noexcept {
+        StreamingHasher hasher(_size);
+        const std::hash<DataType> elementHash;
+        const size_t numBeforeWrap = _numBeforeWrap(_position, _size);
+        for (size_t i = _position; i < _position + numBeforeWrap; ++i) {
+            hasher.updateWord(elementHash(_data[i]));
+        }
+        for (size_t i = 0; i < _size - numBeforeWrap; ++i) {
+            hasher.updateWord(elementHash(_data[i]));
+        }
+        return static_cast<size_t>(hasher.digest());
+    }
+
+    // Whether values of `DataType` which compare equal are guaranteed to have the same object representation, so
+    // that they can be hashed as raw bytes. Floating point types are excluded since `0.0 == -0.0`, and so are class
+    // types, whose `operator ==` may consider values with different bytes equal.
+    struct _HasUniqueBytes: std::integral_constant<bool,
+            std::is_integral<DataType>::value || std::is_enum<DataType>::value || std::is_pointer<DataType>::value> {};
+
     // Initialize the backing array and all fields.
-    void _init(const size_t capacity) throw() {
+    VECTOR_DEQUE_CONSTEXPR void _init(const size_t capacity) {
+        _checkCapacity(capacity);
+        size_t actualCapacity = Wrapping::capacityFor(capacity);
+        DataType* const data = Storage::allocate(actualCapacity);
+        _init(actualCapacity, data);
+    }
+
+    // Initialize all fields to be empty with the given backing array.
+    VECTOR_DEQUE_CONSTEXPR void _init(const size_t capacity, DataType* const data) noexcept {
         _capacity = capacity;
-        _data = new DataType[capacity];
+        _data = data;
         _position = 0;
         _size = 0;
     }
 
     // Optimization: Insert `element` and resize at the same time when _size == _capacity pre-insertion.
-    void _insertAndResize(const DataType& element, const size_t before) {
-        const size_t newCapacity = 2 * _capacity + 1;
-        DataType* const newData = new DataType[newCapacity];
-        sliceToArray(newData, 0, before);
+    VECTOR_DEQUE_CONSTEXPR void _insertAndResize(const DataType& element, const size_t before) {
+        size_t newCapacity = _grownCapacity(_capacity + 1);
+        DataType* const newData = Storage::allocate(newCapacity);
+        _moveSliceToArray(newData, 0, before);
         newData[before] = element;
-        if (before < _size) {
-            // `before == _size` would result in an exception.
-            sliceToArray(newData + before + 1, before, _size);
-        }
-        delete[] _data;
-        _data = newData;
-        _capacity = newCapacity;
+        _moveSliceToArray(newData + before + 1, before, _size);
         ++_size;
-        _position = 0;
+        _replaceData(newData, newCapacity);
     }
 
     // Compute the internal index for the offset `offset`.
-    size_t _internalIndex(const size_t offset) const throw() {
-        if (_position + offset < _capacity) {
-            return _position + offset;
-        }
-        // Target index is past the length of _data: wrap around to the beginning.
+    VECTOR_DEQUE_CONSTEXPR size_t _internalIndex(const size_t offset) const noexcept {
         // Note that if `_position + offset == _capacity`, the resulting index is 0.
-        return _position + offset - _capacity;
+        return Wrapping::wrap(_position + offset, _capacity);
     }
 
     // Determine the internal index offsetted by `offset` from `from` going backwards.
-    size_t _internalNegativeIndexFrom(const size_t from, const size_t offset) const throw() {
-        const size_t internal = _internalIndex(from);
-        if (internal >= offset) {
-            return internal - offset;
-        }
-        // Target index is before 0: wrap around to the end.
+    VECTOR_DEQUE_CONSTEXPR size_t _internalNegativeIndexFrom(const size_t from, const size_t offset) const noexcept {
         // Note that if `from == offset - 1`, the resulting index is `_capacity - 1`.
-        return _capacity - (offset - internal);
+        return Wrapping::wrapBackwards(_internalIndex(from), offset, _capacity);
+    }
+
+    // Largest capacity which `Index` can hold, and which is a power of two for `MaskWrapping`.
+    static VECTOR_DEQUE_CONSTEXPR size_t _maxCapacity() noexcept {
+        return Wrapping::REQUIRES_POWER_OF_TWO ? (static_cast<size_t>(std::numeric_limits<Index>::max()) >> 1) + 1
+                : static_cast<size_t>(std::numeric_limits<Index>::max());
+    }
+
+    // Move `length` elements from `source` to `target`, leaving those in `source` moved from.
+    // The ranges may overlap as long as `target` does not come after `source`.
+    VECTOR_DEQUE_CONSTEXPR static void _move(DataType* const target, DataType* const source, const size_t length) {
+#if defined(__cpp_lib_is_constant_evaluated)
+        if (std::is_constant_evaluated()) {
+            std::move(source, source + length, target);
+            return;
+        }
+#endif
+        _move(target, source, length, std::is_trivially_copyable<DataType>());
+    }
+
+    // Move trivially copyable elements in bulk.
+    static void _move(DataType* const target, DataType* const source, const size_t length, std::true_type) noexcept {
+        _copy(target, source, length, std::true_type());
+    }
+
+    // Move any other elements one at a time.
+    static void _move(DataType* const target, DataType* const source, const size_t length, std::false_type) {
+        std::move(source, source + length, target);
+    }
+
+    // Move the elements from `from` until `until` into `target`, like `sliceToArray`.
+    // Assumes the range has already been verified.
+    VECTOR_DEQUE_CONSTEXPR void _moveSliceToArray(DataType* const target, const size_t from, const size_t until) {
+        const size_t length = until - from;
+        const size_t start = _internalIndex(from);
+        const size_t numBeforeWrap = _numBeforeWrap(start, length);
+        _move(target, _data + start, numBeforeWrap);
+        _move(target + numBeforeWrap, _data, length - numBeforeWrap);
+    }
+
+    // Move the `length` elements starting at `from` into the backing array of `target`, starting at the internal index
+    // `targetStart` and wrapping around. Each of the (up to) two segments of the source is moved in at most two
+    // blocks, so at most four block moves are made.
+    template <class TargetDeque>
+    VECTOR_DEQUE_CONSTEXPR void _moveTo(TargetDeque& target, const size_t from, size_t targetStart,
+            const size_t length) {
+        const VectorDequeSegments<DataType> segments = _segments<DataType>(from, from + length);
+        const VectorDequeSegment<DataType> parts[2] = {segments.first, segments.second};
+        for (const VectorDequeSegment<DataType>& part: parts) {
+            const size_t numBeforeWrap = std::min(target._capacity - targetStart, part.length);
+            std::move(part.begin(), part.begin() + numBeforeWrap, target._data + targetStart);
+            std::move(part.begin() + numBeforeWrap, part.end(), target._data);
+            targetStart = numBeforeWrap < part.length ? part.length - numBeforeWrap : targetStart + numBeforeWrap;
+        }
     }
 
     // Compute the number of elements remaining before we need to wrap to the beginning starting from `start`
     // when `length` elements need to be added.
-    size_t _numBeforeWrap(const size_t start, const size_t length) const throw() {
+    VECTOR_DEQUE_CONSTEXPR size_t _numBeforeWrap(const size_t start, const size_t length) const noexcept {
         return std::min(_capacity - start, length);
     }
 
+    // Replace the backing array with `newData`, which already holds the contents starting at index 0.
+    VECTOR_DEQUE_CONSTEXPR void _replaceData(DataType* const newData, const size_t newCapacity) {
+        const size_t oldCapacity = _capacity;
+        Storage::deallocate(_data, _capacity);
+        _data = newData;
+        _capacity = newCapacity;
+        _position = 0;
+        Observers::notifyResize(*this, oldCapacity);
+    }
+
+    // Get the contiguous segments of the elements from `from` until `until`.
+    template <class MemberType>
+    VECTOR_DEQUE_CONSTEXPR VectorDequeSegments<MemberType> _segments(const size_t from, const size_t until) const {
+        _checkRange(from, until);
+        const size_t length = until - from;
+        const size_t start = _internalIndex(from);
+        const size_t numBeforeWrap = _numBeforeWrap(start, length);
+        const VectorDequeSegments<MemberType> segments = {{_data + start, numBeforeWrap},
+                {_data, length - numBeforeWrap}};
+        return segments;
+    }
+
     // Shift the elements down from `from` until `until`.
-    void _shiftDown(const size_t from, const size_t until) throw() {
-        // Since elements are overwritten before they are copied, it is safe to use `memcpy`.
+    VECTOR_DEQUE_CONSTEXPR void _shiftDown(const size_t from, const size_t until) {
+        // Since elements are overwritten before they are copied, it is safe to copy forwards.
         const size_t length = until - from;
-        // Start the `memcpy` 1 before the `from`.
+        // Start the copy 1 before the `from`.
         const size_t start = _internalNegativeIndexFrom(from, 1);
-        const size_t numBeforeWrap = _numBeforeWrap(start, length);
+        // The source is 1 ahead of the target, so it reaches the end of the backing array 1 element sooner.
+        const size_t numBeforeWrap = _numBeforeWrap(start + 1, length);
         const size_t numAfterWrap = length - numBeforeWrap;
-        std::memcpy(_data + start, _data + start + 1, sizeof(DataType) * numBeforeWrap);
+        _move(_data + start, _data + start + 1, numBeforeWrap);
         if (numAfterWrap != 0) {
             // First internal elements should be "shifted down" to the last position.
-            _data[_capacity - 1] = _data[0];
+            _data[_capacity - 1] = std::move(_data[0]);
             // Note numAfterWrap >= 1, so this is safe.
-            std::memcpy(_data, _data + 1, sizeof(DataType) * (numAfterWrap - 1));
+            _move(_data, _data + 1, numAfterWrap - 1);
         }
         if (from == 0) {
             // Update the position if we are shifting down the first element.
-            if (_position == 0) {
-                _position = _capacity - 1;
-            } else {
-                --_position;
-            }
+            _position = Wrapping::wrapBackwards(_position, 1, _capacity);
         }
     }
 
     // Shift the elements up from `from` until `until`.
-    void _shiftUp(const size_t from, const size_t until) {
+    VECTOR_DEQUE_CONSTEXPR void _shiftUp(const size_t from, const size_t until) {
         // Need to start from the end and go backwards, since otherwise elements will be overwritten before they are 
         // copied. Thus, we may not use `memcpy`.
         for (size_t i = 0; i < until - from; ++i) {
-            _data[_internalNegativeIndexFrom(until, i)] = _data[_internalNegativeIndexFrom(until, i + 1)];
+            _data[_internalNegativeIndexFrom(until, i)] = std::move(_data[_internalNegativeIndexFrom(until, i + 1)]);
         }
         if (from == 0) {
             // If we're shifting up the first element, we need to update `_position`.
-            if (_position == _capacity - 1) {
-                _position = 0;
-            } else {
-                ++_position;
-            }
+            _position = Wrapping::wrap(_position + 1, _capacity);
         }
     }
 
     // Compute the internal index for where the next element should be written.
-    size_t _writePosition() const throw() {
+    VECTOR_DEQUE_CONSTEXPR size_t _writePosition() const noexcept {
         // We write _size elements after the current position.
         return _internalIndex(_size);
     }      
@@ -501,22 +855,35 @@ class VectorDeque {
     /**
      * Mutable iterator for `VectorDeque`s.
      */
-    typedef IteratorBase<VectorDeque, DataType, false> Iterator;
+    typedef IteratorBase<BasicVectorDeque, DataType, false> Iterator;
 
     /**
      * Immutable iterator for `VectorDeque`s.
      */
-    typedef IteratorBase<const VectorDeque, const DataType, false> ConstIterator;
+    typedef IteratorBase<const BasicVectorDeque, const DataType, false> ConstIterator;
 
     /**
      * Mutable reverse iterator for `VectorDeque`s.
      */
-    typedef IteratorBase<VectorDeque, DataType, true> ReverseIterator;
+    typedef IteratorBase<BasicVectorDeque, DataType, true> ReverseIterator;
 
     /**
      * Immutable reverse iterator for `VectorDeque`s.
      */
-    typedef IteratorBase<const VectorDeque, const DataType, true> ConstReverseIterator;
+    typedef IteratorBase<const BasicVectorDeque, const DataType, true> ConstReverseIterator;
+
+    // Standard sequence container types, so that `VectorDeque` can back `std::queue` and `std::stack`.
+    typedef DataType value_type;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef DataType& reference;
+    typedef const DataType& const_reference;
+    typedef DataType* pointer;
+    typedef const DataType* const_pointer;
+    typedef Iterator iterator;
+    typedef ConstIterator const_iterator;
+    typedef ReverseIterator reverse_iterator;
+    typedef ConstReverseIterator const_reverse_iterator;
 
     /**
      * The capacity to initialize a `VectorDeque` to by default.
@@ -527,81 +894,140 @@ class VectorDeque {
      * Constructs a `VectorDeque` with a default initial capacity.
      * Runtime: `O(1)`
      */
-    VectorDeque() throw() {
-        _init(DEFAULT_INITIAL_CAPACITY);
+    VECTOR_DEQUE_CONSTEXPR BasicVectorDeque() {
+        _init(Storage::defaultCapacity(DEFAULT_INITIAL_CAPACITY));
     }
 
     /**
      * Constructs a `VectorDeque` with the given initial capacity.
      * Runtime: `O(1)`
      * @param capacity Initial capacity to construct with.
+     * @throws std::length_error If the storage policy cannot provide `capacity` elements.
      */
-    explicit VectorDeque(const size_t capacity) throw() {
+    VECTOR_DEQUE_CONSTEXPR explicit BasicVectorDeque(const size_t capacity) {
         _init(capacity);
     }
 
+    /**
+     * Constructs a `VectorDeque` from the elements of `vector`, in order, leaving `vector` empty. `std::vector` cannot
+     * hand its buffer over, so the elements are moved into a new backing array, and the memory of `vector` is freed.
+     * Runtime: `O(vector.size())`
+     * @param vector Vector to take the elements of.
+     * @throws std::length_error If the storage policy cannot provide `vector.size()` elements.
+     */
+    explicit BasicVectorDeque(std::vector<DataType>&& vector) {
+        _init(vector.size());
+        // `std::move` reduces to a bulk copy for trivially copyable types.
+        std::move(vector.begin(), vector.end(), _data);
+        _size = vector.size();
+        std::vector<DataType>().swap(vector);
+        Observers::notifyAssign(*this);
+    }
+
     /**
      * Non-temporary copy constructor.
      * Differs from the temporary copy constructor in that the underlying array is copied instead of moved.
+     * Observers start out fresh and are notified of the copied contents through `onAssign`. The maximum size and the
+     * overflow policy's settings are copied.
      * Runtime: `O(that.size())`
      * @param that `VectorDeque` to construct from.
      */
-    VectorDeque(const VectorDeque& that) throw() {
+    VECTOR_DEQUE_CONSTEXPR BasicVectorDeque(const BasicVectorDeque& that): Storage(), Overflow(that), Observers() {
         // Initialize backing array to be large enough to contain the contents of that.
         _init(that._size);
         that.copyToArray(_data);
         // Note that._position is still 0, and we are at capacity.
         _size = that._size;
+        Observers::notifyAssign(*this);
     }
 
     /**
      * Temporary copy constructor.
      * Differs from the non-temporary copy constructor in the the underlying array is moved instead of copied.
-     * Runtime: `O(1)`
+     * Observers and the overflow policy are moved along with the contents.
+     * Runtime: `O(1)`, or `O(that.size())` if `that` stores its elements inline
      * @param that Temporary `VectorDeque` to construct from.
      */
-    VectorDeque(VectorDeque&& that) throw() {
-        // Move contents of that with memcpy.
-        std::memcpy(this, &that, sizeof(VectorDeque));
-        // Allow safe destruction of that.
-        that._data = NULL;
+    VECTOR_DEQUE_CONSTEXPR BasicVectorDeque(BasicVectorDeque&& that) noexcept: Storage(), 
+            Overflow(std::move(static_cast<Overflow&>(that))), Observers(std::move(static_cast<Observers&>(that))),
+            _data(NULL), _capacity(0), _position(0), _size(0) {
+        if (that.Storage::isInline(that._data)) {
+            // An inline array cannot change owners, so move its elements into our own, which is at least as large.
+            _init(that._size);
+            that._moveSliceToArray(_data, 0, that._size);
+            _size = that._size;
+        } else {
+            _init(that._capacity, that._data);
+            _position = that._position;
+            _size = that._size;
+            // Allow safe destruction of that, leaving it empty.
+            that._init(0, NULL);
+        }
     }
 
     /**
      * Non-temporary assignment.
      * Differs from temporary assignment in that the underlying array is copied instead of moved.
+     * Observers keep their state and are notified of the copied contents through `onAssign`. As with the copy
+     * constructor, the maximum size and the overflow policy's settings are copied.
      * Runtime: `O(that.size())`
      * @param that `VectorDeque` to assign from.
      * @return A reference to `*this`.
      */
-    VectorDeque& operator =(const VectorDeque& that) throw() {
+    VECTOR_DEQUE_CONSTEXPR BasicVectorDeque& operator =(const BasicVectorDeque& that) {
         if (this == &that) {
             return *this;
         }
+        Overflow::operator =(that);
         if (_capacity < that._size) {
-            delete[] _data;
-            _data = new DataType[that._size];
-            _capacity = that._size;
+            size_t newCapacity = Wrapping::capacityFor(that._size);
+            DataType* const newData = Storage::allocate(newCapacity);
+            Storage::deallocate(_data, _capacity);
+            _data = newData;
+            _capacity = newCapacity;
         }
         that.copyToArray(_data);
         _position = 0;
         _size = that._size;
+        Observers::notifyAssign(*this);
         return *this;
     }
 
     /**
      * Temporary assignment.
      * Differs from the non-temporary assignment in the the underlying array is moved instead of copied.
-     * Runtime: `O(1)`
+     * Observers and the overflow policy are moved along with the contents.
+     * Runtime: `O(1)`, or `O(that.size())` if `that` stores its elements inline
      * @param that Temporary `VectorDeque` to assign from.
      * @return A reference to `*this`.
      */
-    VectorDeque& operator =(VectorDeque&& that) throw() {
-        delete[] _data;
-        // Move with memcpy.
-        std::memcpy(this, &that, sizeof(VectorDeque));
-        // Allow safe destruction of that.
-        that._data = NULL;
+    VECTOR_DEQUE_CONSTEXPR BasicVectorDeque& operator =(BasicVectorDeque&& that) noexcept(
+            Storage::INLINE_CAPACITY == 0 && std::is_nothrow_move_assignable<Overflow>::value
+            && std::is_nothrow_move_assignable<Observers>::value) {
+        if (this == &that) {
+            return *this;
+        }
+        if (that.Storage::isInline(that._data)) {
+            *this = static_cast<const BasicVectorDeque&>(that);
+        } else {
+            Storage::deallocate(_data, _capacity);
+            _init(that._capacity, that._data);
+            _position = that._position;
+            _size = that._size;
+            // Allow safe destruction of that, leaving it empty.
+            that._init(0, NULL);
+        }
+        Overflow::operator =(std::move(static_cast<Overflow&>(that)));
+        Observers::operator =(std::move(static_cast<Observers&>(that)));
+        return *this;
+    }
+
+    /**
+     * Destroys `*this` along with its backing array.
+     * Runtime: `O(capacity)`
+     */
+    VECTOR_DEQUE_CONSTEXPR ~BasicVectorDeque() noexcept {
+        Storage::deallocate(_data, _capacity);
     }
 
     /**
@@ -610,7 +1036,7 @@ class VectorDeque {
      * @param that Other `VectorDeque` to check equality for.
      * @return true If `(*this)[i] == that[i]` for every `0 <= i < size()` and `this->size() == that.size()`.
      */
-    bool operator ==(const VectorDeque& that) const throw() {
+    VECTOR_DEQUE_CONSTEXPR bool operator ==(const BasicVectorDeque& that) const noexcept {
         if (this == &that) {
             return true;
         }
@@ -618,7 +1044,7 @@ class VectorDeque {
             return false;
         }
         for (size_t i = 0; i < _size; ++i) {
-            if ((*this)[i] != that[i]) {
+            if (_at(i) != that._at(i)) {
                 return false;
             }
         }
@@ -631,7 +1057,7 @@ class VectorDeque {
      * @param that Other `VectorDeque` to check inequality for.
      * @return `true` If `(*this)[i] != that[i]` for some `0 <= i < size()` or `this->size() != that.size()`.
      */
-    bool operator !=(const VectorDeque& that) const throw() {
+    VECTOR_DEQUE_CONSTEXPR bool operator !=(const BasicVectorDeque& that) const noexcept {
         return !(*this == that);
     }
 
@@ -643,9 +1069,10 @@ class VectorDeque {
      * @return A reference to the element.
      * @throws std::length_error If `index >= size()`.
      */
-    DataType& operator [](const size_t index) const {
-        _checkIndex(index);
-        return _data[_internalIndex(index)];
+    VECTOR_DEQUE_CONSTEXPR DataType& operator [](const size_t index) const {
+        DataType& element = _at(index);
+        Observers::notifyAccess(*this, index);
+        return element;
     }
 
     /**
@@ -653,55 +1080,77 @@ class VectorDeque {
      * Runtime: `O(size())`
      * @return Each element of `*this`, comma-separated and enclosed in curly braces.
      */
-    operator std::string() const throw() {
+    operator std::string() const {
         if (isEmpty()) {
             return "{}";
         }
         std::stringstream stream;
         stream << '{';
-        stream << (*this)[0];
+        stream << _at(0);
         for (size_t i = 1; i < _size; ++i) {
-            stream << ", " << (*this)[i];
+            stream << ", " << _at(i);
         }
         stream << '}';
         return stream.str();
     }
 
     /**
-     * Add `element` to the back of `*this`.
+     * Add `element` to the back of `*this`. If `*this` is bounded and full, the overflow policy decides whether it is
+     * added.
      * Runtime: `O(1)`
      * @param element Element to add.
+     * @return `true` If `element` was added, `false` if the overflow policy dropped it.
      */
-    void add(const DataType& element) throw() {
-        _ensureCanFit();
-        _data[_writePosition()] = element;
-        ++_size;
+    VECTOR_DEQUE_CONSTEXPR bool add(const DataType& element) {
+        if (_admit(1, false).count == 0) {
+            return false;
+        }
+        _add(element);
+        return true;
     }
 
     /**
-     * Add an array of elements to the back of `*this`.
+     * Add an array of elements to the back of `*this`. If `*this` is bounded and they would exceed its maximum size,
+     * the overflow policy is applied once to the whole array.
      * Runtime: `O(length)`
      * @param elements Elements to add.
      * @param length Amount of elements to add.
+     * @return `true` If every element was added, `false` if the overflow policy dropped some of them.
      */
-    void addAll(const DataType* const elements, const size_t length) throw() {
-        _ensureCanFit(length);
-        _addAll(elements, _writePosition(), length);
-        _size += length;
+    VECTOR_DEQUE_CONSTEXPR bool addAll(const DataType* const elements, const size_t length) {
+        const OverflowDecision decision = _admit(length, false);
+        _ensureCanFit(decision.count);
+        _addAll(elements + decision.skip, _writePosition(), decision.count);
+        _size += decision.count;
+        Observers::notifyAdd(*this, decision.count);
+        return decision.count == length;
     }
 
     /**
-     * Add a collection of elements to the back of `*this`.
+     * Add a collection of elements to the back of `*this`. If `*this` is bounded and they would exceed its maximum
+     * size, the overflow policy is applied once to the whole collection.
      * Runtime: `O(size of given collection)`
      * @param begin Iterator to the first element to add.
      * @param end Iterator past the last element to add.
-     * @param IteratorType The type of the iterator.
+     * @param IteratorType The type of the iterator. Must be a forward iterator if `*this` is bounded, since the
+     * collection is counted first.
+     * @return `true` If every element was added, `false` if the overflow policy dropped some of them.
      */
     template <class IteratorType>
-    void addAll(IteratorType begin, IteratorType end) throw() {
+    VECTOR_DEQUE_CONSTEXPR bool addAll(IteratorType begin, IteratorType end) {
+        if (Overflow::BOUNDED) {
+            const size_t length = static_cast<size_t>(std::distance(begin, end));
+            const OverflowDecision decision = _admit(length, false);
+            std::advance(begin, decision.skip);
+            for (size_t i = 0; i < decision.count; ++i, ++begin) {
+                _add(*begin);
+            }
+            return decision.count == length;
+        }
         for (IteratorType it = begin; it != end; ++it) {
-            add(*it);
+            _add(*it);
         }
+        return true;
     }
 
     /**
@@ -709,12 +1158,15 @@ class VectorDeque {
      * This method works as though `addFirst` was sequentially called on `elements`.
      * Thus, the last element added is the first element in `*this` after `addAllFirst` terminates.
      * Runtime: `O(length)`
+     * If `*this` is bounded and they would exceed its maximum size, the overflow policy is applied once to the whole
+     * array.
      * @param elements Elements to add.
      * @param length Amount of elements to add.
+     * @return `true` If every element was added, `false` if the overflow policy dropped some of them.
      */
-    void addAllFirst(const DataType* const elements, const size_t length) throw() {
+    VECTOR_DEQUE_CONSTEXPR bool addAllFirst(const DataType* const elements, const size_t length) {
         // Can't take advantage of memcpy: use iterator version.
-        addAllFirst(elements, elements + length);
+        return addAllFirst(elements, elements + length);
     }
 
     /**
@@ -722,32 +1174,99 @@ class VectorDeque {
      * This method works as though `addFirst` was sequentially called on for the given iterator.
      * Thus, the last element added is the first element in `*this` after `addAllFirst` terminates.
      * Runtime: `O(size of given collection)`
+     * If `*this` is bounded and they would exceed its maximum size, the overflow policy is applied once to the whole
+     * collection.
      * @param begin Iterator to the first element to add.
      * @param end Iterator past the last element to add.
-     * @param IteratorType The type of the iterator.
+     * @param IteratorType The type of the iterator. Must be a forward iterator if `*this` is bounded, since the
+     * collection is counted first.
+     * @return `true` If every element was added, `false` if the overflow policy dropped some of them.
      */
     template <class IteratorType>
-    void addAllFirst(IteratorType begin, IteratorType end) throw() {
+    VECTOR_DEQUE_CONSTEXPR bool addAllFirst(IteratorType begin, IteratorType end) {
+        if (Overflow::BOUNDED) {
+            const size_t length = static_cast<size_t>(std::distance(begin, end));
+            const OverflowDecision decision = _admit(length, true);
+            std::advance(begin, decision.skip);
+            for (size_t i = 0; i < decision.count; ++i, ++begin) {
+                _addFirst(*begin);
+            }
+            return decision.count == length;
+        }
         for (IteratorType it = begin; it != end; ++it) {
-            addFirst(*it);
+            _addFirst(*it);
         }
+        return true;
     }
 
     /**
-     * Add `element` to the front of `*this`.
+     * Add `element` to the front of `*this`. If `*this` is bounded and full, the overflow policy decides whether it is
+     * added.
      * Runtime: `O(1)`
      * @param element Element to add.
+     * @return `true` If `element` was added, `false` if the overflow policy dropped it.
      */
-    void addFirst(const DataType& element) throw() {
-        _ensureCanFit();
-        if (_position == 0) {
-            _position = _capacity - 1;
-        } else {
-            --_position;
+    VECTOR_DEQUE_CONSTEXPR bool addFirst(const DataType& element) {
+        if (_admit(1, true).count == 0) {
+            return false;
         }
-        // The position is now at the element which was added to the front.
-        _data[_position] = element;
-        ++_size;
+        _addFirst(element);
+        return true;
+    }
+
+    /**
+     * Take ownership of `data`, an array of `capacity` elements whose first `size` are the new contents of `*this`,
+     * replacing the current contents and backing array without copying. The array must have been allocated with
+     * `new DataType[capacity]`, and is freed by `*this` with `delete[]`. Only storage policies which allocate that way
+     * (`HeapStorage` and `SmallBufferStorage`) can adopt arrays.
+     * Runtime: `O(1)`, plus that of freeing the current backing array
+     * @param data Array to adopt. Nothing is taken if an exception is thrown.
+     * @param size Number of elements in use, from index `0`.
+     * @param capacity Length of `data`.
+     * @throws std::invalid_argument If `size > capacity`, if `data` is `NULL` while `capacity` is not `0`, or if the
+     * wrapping policy does not allow `capacity` (`MaskWrapping` needs a power of two).
+     * @throws std::length_error If `size` exceeds the maximum size of `*this`, or `capacity` the maximum capacity of the
+     * index type.
+     */
+    void adopt(DataType* const data, const size_t size, const size_t capacity) {
+        static_assert(Storage::NEW_ARRAYS, "The storage policy cannot adopt arrays allocated with new[]");
+        if (size > capacity || (data == NULL && capacity != 0) || Wrapping::capacityFor(capacity) != capacity) {
+            throw std::invalid_argument("Cannot adopt " + std::to_string(size) + " elements in an array of "
+                    + std::to_string(capacity));
+        }
+        _checkCapacity(capacity);
+        if (Overflow::BOUNDED && size > Overflow::maxSize()) {
+            throw std::length_error("Adopting " + std::to_string(size) + " elements would exceed the maximum size of "
+                    + std::to_string(Overflow::maxSize()));
+        }
+        // Observers see the old contents removed before the new ones are assigned.
+        const size_t numRemoved = _size;
+        _size = 0;
+        Observers::notifyRemove(*this, numRemoved);
+        _replaceData(data, capacity);
+        _size = size;
+        Observers::notifyAssign(*this);
+    }
+
+    /**
+     * Get a reference to the last element of `*this`.
+     * Runtime: `O(1)`
+     * @return The last element of `*this`.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    VECTOR_DEQUE_CONSTEXPR DataType& back() {
+        _checkSize();
+        return _data[_internalIndex(_size - 1)];
+    }
+
+    /**
+     * Get a constant reference to the last element of `*this`.
+     * Runtime: `O(1)`
+     * @return The last element of `*this`.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    VECTOR_DEQUE_CONSTEXPR const DataType& back() const {
+        return peekLast();
     }
 
     /**
@@ -755,7 +1274,7 @@ class VectorDeque {
      * Runtime: `O(1)`
      * @return Iterator pointing to the first element of `*this`.
      */
-    Iterator begin() throw() {
+    VECTOR_DEQUE_CONSTEXPR Iterator begin() noexcept {
         return Iterator(this);
     }
 
@@ -764,7 +1283,25 @@ class VectorDeque {
      * Runtime: `O(1)`
      * @return Constant iterator pointing to the first element of `*this`.
      */
-    ConstIterator cbegin() const throw() {
+    VECTOR_DEQUE_CONSTEXPR ConstIterator begin() const noexcept {
+        return cbegin();
+    }
+
+    /**
+     * Returns the number of elements `*this` can hold before it has to resize.
+     * Runtime: `O(1)`
+     * @return The length of the backing array.
+     */
+    VECTOR_DEQUE_CONSTEXPR size_t capacity() const noexcept {
+        return _capacity;
+    }
+
+    /**
+     * Get a constant iterator pointing to the first element of `*this`.
+     * Runtime: `O(1)`
+     * @return Constant iterator pointing to the first element of `*this`.
+     */
+    VECTOR_DEQUE_CONSTEXPR ConstIterator cbegin() const noexcept {
         return ConstIterator(this);
     }
 
@@ -773,16 +1310,20 @@ class VectorDeque {
      * Runtime: `O(1)`
      * @return Iterator past the last element of `*this`.
      */
-    ConstIterator cend() const throw() {
+    VECTOR_DEQUE_CONSTEXPR ConstIterator cend() const noexcept {
         return ConstIterator(this, _size);
     }
 
     /**
-     * Remove all elements from `*this`.
+     * Remove all elements from `*this`. The next elements added start at the beginning of the backing array, so that
+     * they are contiguous until they wrap around.
      * Runtime: `O(1)`.
      */
-    void clear() throw() {
+    VECTOR_DEQUE_CONSTEXPR void clear() noexcept {
+        const size_t numRemoved = _size;
+        _position = 0;
         _size = 0;
+        Observers::notifyRemove(*this, numRemoved);
     }
 
     /**
@@ -791,7 +1332,7 @@ class VectorDeque {
      * @param element Element to check for.
      * @return `true` If `(*this)[i] == element` for some `0 <= i < size()` and `false` otherwise.
      */
-    bool contains(const DataType& element) const throw() {
+    VECTOR_DEQUE_CONSTEXPR bool contains(const DataType& element) const noexcept {
         return find(element) != -1;
     }
 
@@ -800,7 +1341,7 @@ class VectorDeque {
      * Runtime: `O(size())`
      * @param target Array to copy to.
      */
-    void copyToArray(DataType* const target) const throw() {
+    VECTOR_DEQUE_CONSTEXPR void copyToArray(DataType* const target) const {
         sliceToArray(target, 0, _size);
     }
 
@@ -809,7 +1350,7 @@ class VectorDeque {
      * Runtime: `O(1)`
      * @return Constant reverse iterator pointing to the last element of `*this`.
      */
-    ConstReverseIterator crbegin() const throw() {
+    VECTOR_DEQUE_CONSTEXPR ConstReverseIterator crbegin() const noexcept {
         return ConstReverseIterator(this);
     }
 
@@ -818,18 +1359,84 @@ class VectorDeque {
      * Runtime: `O(1)`
      * @return Iterator past the last element of `*this`.
      */
-    ConstReverseIterator crend() const throw() {
+    VECTOR_DEQUE_CONSTEXPR ConstReverseIterator crend() const noexcept {
         return ConstReverseIterator(this, _size);
     } 
 
+    /**
+     * Construct an element from `args` and move it to the back of `*this`. The element is constructed before any
+     * resizing, so `args` may refer to elements of `*this`. If `*this` is bounded and full, the overflow policy decides
+     * whether it is added.
+     * Runtime: `O(1)`
+     * @param args Arguments to construct the element with.
+     * @return `true` If the element was added, `false` if the overflow policy dropped it.
+     */
+    template <class... Args>
+    VECTOR_DEQUE_CONSTEXPR bool emplace_back(Args&&... args) {
+        DataType element(std::forward<Args>(args)...);
+        if (_admit(1, false).count == 0) {
+            return false;
+        }
+        _add(std::move(element));
+        return true;
+    }
+
+    /**
+     * Construct an element from `args` and move it to the front of `*this`. The element is constructed before any
+     * resizing, so `args` may refer to elements of `*this`. If `*this` is bounded and full, the overflow policy decides
+     * whether it is added.
+     * Runtime: `O(1)`
+     * @param args Arguments to construct the element with.
+     * @return `true` If the element was added, `false` if the overflow policy dropped it.
+     */
+    template <class... Args>
+    VECTOR_DEQUE_CONSTEXPR bool emplace_front(Args&&... args) {
+        DataType element(std::forward<Args>(args)...);
+        if (_admit(1, true).count == 0) {
+            return false;
+        }
+        _addFirst(std::move(element));
+        return true;
+    }
+
+    /**
+     * Checks whether `*this` is empty. Same as `isEmpty`, for standard containers.
+     * Runtime: `O(1)`
+     * @return `true` If `size() == 0`, `false` otherwise.
+     */
+    VECTOR_DEQUE_CONSTEXPR bool empty() const noexcept {
+        return _size == 0;
+    }
+
     /**
      * Get an iterator past the last element of `*this`.
      * Runtime: `O(1)`
      * @return Iterator past the last element of `*this`.
      */
-    Iterator end() throw() {
+    VECTOR_DEQUE_CONSTEXPR Iterator end() noexcept {
         return Iterator(this, _size);
     }
+
+    /**
+     * Get a constant iterator past the last element of `*this`.
+     * Runtime: `O(1)`
+     * @return Constant iterator past the last element of `*this`.
+     */
+    VECTOR_DEQUE_CONSTEXPR ConstIterator end() const noexcept {
+        return cend();
+    }
+
+    /**
+     * Assign `value` to every element of `*this`. Observers are notified through `onAssign`.
+     * Runtime: `O(size())`
+     * @param value Value to assign.
+     */
+    VECTOR_DEQUE_CONSTEXPR void fill(const DataType& value) {
+        const VectorDequeSegments<DataType> segments = _segments<DataType>(0, _size);
+        std::fill(segments.first.begin(), segments.first.end(), value);
+        std::fill(segments.second.begin(), segments.second.end(), value);
+        Observers::notifyAssign(*this);
+    }
     
     /**
      * Check to see where `element` is located in `*this`.
@@ -837,11 +1444,16 @@ class VectorDeque {
      * @param element Element to check for.
      * @returns The first `i` such that `(`*this`)[i] == element` or `-1` if no such element exists.
      */
-    ssize_t find(const DataType& element) const throw() {
-        for (size_t i = 0; i < _size; ++i) {
-            if (element == (*this)[i]) {
-                return i;
-            }
+    VECTOR_DEQUE_CONSTEXPR ssize_t find(const DataType& element) const noexcept {
+        // Search each segment directly rather than going through `operator []` for every element.
+        const VectorDequeSegments<const DataType> segments = _segments<const DataType>(0, _size);
+        const DataType* const inFirst = std::find(segments.first.begin(), segments.first.end(), element);
+        if (inFirst != segments.first.end()) {
+            return inFirst - segments.first.begin();
+        }
+        const DataType* const inSecond = std::find(segments.second.begin(), segments.second.end(), element);
+        if (inSecond != segments.second.end()) {
+            return segments.first.size() + (inSecond - segments.second.begin());
         }
         return -1;
     }
@@ -858,15 +1470,50 @@ class VectorDeque {
         return (*this)[_size - index - 1];
     } 
 
+    /**
+     * Get a reference to the first element of `*this`.
+     * Runtime: `O(1)`
+     * @return The first element of `*this`.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    VECTOR_DEQUE_CONSTEXPR DataType& front() {
+        _checkSize();
+        return _data[_position];
+    }
+
+    /**
+     * Get a constant reference to the first element of `*this`.
+     * Runtime: `O(1)`
+     * @return The first element of `*this`.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    VECTOR_DEQUE_CONSTEXPR const DataType& front() const {
+        return peek();
+    }
+
+    /**
+     * Compute a hash of the contents of `*this`, consistent with `operator ==`.
+     * For integral, enumeration and pointer types, the bytes of each contiguous segment of the backing array are
+     * hashed in bulk. Otherwise, the `std::hash` of each element is combined. Either way, the result does not depend
+     * on where the contents wrap around in the backing array.
+     * Runtime: `O(size())`
+     * @return The hash.
+     */
+    size_t hash() const noexcept {
+        return _hash(_HasUniqueBytes());
+    }
+
     /**
      * Insert `element` before `before`.
      * Runtime: Amortized `O(min(before, size() - before))`
      * Exception Safety: Strong
      * @param element Element to insert.
      * @param before Index of the element to insert before. The inserted element's index will be `before`.
-     * @throws std::length_error If `before > size()`.
+     * @throws std::length_error If `before > size()`, or if `*this` is bounded and full. Insertions are not subject to
+     * the overflow policy.
      */
-    void insert(const DataType& element, const size_t before) {
+    VECTOR_DEQUE_CONSTEXPR void insert(const DataType& element, const size_t before) {
+        _checkMaxSize(1);
         if (before == 0) {
             // Handle the logic for 0 specially since it changes the position.
             addFirst(element);
@@ -882,20 +1529,20 @@ class VectorDeque {
         if (_size == _capacity) {
             // Handle insertion and resizing simultaneously for efficiency.
             _insertAndResize(element, before);
-            return;
-        }
-    
-        if (before <= _size / 2) {
-            // More efficient to shift front elements backwards.
-            _shiftDown(0, before);
-
         } else {
-            // More efficient to shift back elements forwards.
-            _shiftUp(before, _size);
+            if (before <= _size / 2) {
+                // More efficient to shift front elements backwards.
+                _shiftDown(0, before);
+
+            } else {
+                // More efficient to shift back elements forwards.
+                _shiftUp(before, _size);
+            }
+            ++_size;
+            const size_t insertionIndex = _internalIndex(before);
+            _data[insertionIndex] = element;
         }
-        ++_size;
-        const size_t insertionIndex = _internalIndex(before);
-        _data[insertionIndex] = element;
+        Observers::notifyInsert(*this, before);
     }
 
     /**
@@ -907,7 +1554,7 @@ class VectorDeque {
      * @throws std::length_error If `it` points to an out-of-bounds element.
      * @throws std::invalid_argument If `it` is not iterating over `*this`.
      */
-    void insert(const DataType& element, const ConstIterator& it) {
+    VECTOR_DEQUE_CONSTEXPR void insert(const DataType& element, const ConstIterator& it) {
         _checkIterator(it);
         insert(element, it._position);
     }
@@ -921,20 +1568,130 @@ class VectorDeque {
      * @throws std::length_error If `it` points to an out-of-bounds element.
      * @throws std::invalid_argument If `it` is not iterating over `*this`.
      */
-    void insert(const DataType& element, const ConstReverseIterator& it) {
+    VECTOR_DEQUE_CONSTEXPR void insert(const DataType& element, const ConstReverseIterator& it) {
         _checkIterator(it);
         insert(element, _size - it._position);
     }
 
+    /**
+     * Move the elements of `*this` into a `std::vector`, in order, freeing the backing array and leaving `*this` empty
+     * with no backing array. `std::vector` cannot adopt a buffer, so the elements are moved into it, one segment at a
+     * time; use `release` to hand out the backing array itself.
+     * Runtime: `O(size())`
+     * @return Vector of the elements.
+     */
+    std::vector<DataType> intoVector() {
+        const VectorDequeSegments<DataType> segments = _segments<DataType>(0, _size);
+        std::vector<DataType> vector;
+        vector.reserve(_size);
+        vector.insert(vector.end(), std::make_move_iterator(segments.first.begin()),
+                std::make_move_iterator(segments.first.end()));
+        vector.insert(vector.end(), std::make_move_iterator(segments.second.begin()),
+                std::make_move_iterator(segments.second.end()));
+        Storage::deallocate(_data, _capacity);
+        _disown();
+        return vector;
+    }
+
     /**
      * Checks whether `*this` is empty.
      * Runtime: `O(1)`
      * @returns `true` If `size() == 0`, `false` otherwise.
      */
-    bool isEmpty() const throw() {
+    VECTOR_DEQUE_CONSTEXPR bool isEmpty() const noexcept {
         return _size == 0;
     }
 
+    /**
+     * Make the elements of `*this` contiguous in the backing array, so that they can be handed to algorithms taking
+     * a pointer range. The elements keep their order. Nothing is moved if they are already contiguous.
+     * Runtime: `O(capacity())` if the elements wrap around the end of the backing array, `O(1)` otherwise
+     * @return Pointer to the first element, followed by the others up to the `size()`th.
+     */
+    VECTOR_DEQUE_CONSTEXPR DataType* linearize() {
+        if (_numBeforeWrap(_position, _size) < _size) {
+            std::rotate(_data, _data + _position, _data + _capacity);
+            _position = 0;
+        }
+        return _data + _position;
+    }
+
+    /**
+     * Get the median of the elements of `*this` without reordering them: they are copied into `scratch`, which is
+     * reordered instead. Reusing `scratch` across calls avoids allocating once it has grown to `size()`. For an even
+     * number of elements, this is the lower of the two middle elements.
+     * Runtime: `O(size())` on average
+     * @param scratch Buffer to select in, whose contents are replaced.
+     * @param cmp Strict weak ordering of the elements.
+     * @return The `(size() - 1) / 2`th smallest element.
+     * @throws std::length_error If `isEmpty()`.
+     */
+    template <class Compare = std::less<DataType> >
+    DataType medianOf(std::vector<DataType>& scratch, Compare cmp = Compare()) const {
+        _checkSize();
+        return nthElementOf((_size - 1) / 2, scratch, cmp);
+    }
+
+    /**
+     * Reorder `*this` in place like `std::nth_element`: the element at index `n` becomes the one which would be there
+     * if `*this` were sorted, no element before it is greater and no element after it is smaller. The elements are
+     * linearized first if they wrap around the end of the backing array. Observers are notified through `onAssign`.
+     * Runtime: `O(size())` on average, plus that of `linearize()`
+     * @param n Index of the element to select.
+     * @param cmp Strict weak ordering of the elements.
+     * @return Reference to the `n`th smallest element, now at index `n`.
+     * @throws std::length_error If `n >= size()`.
+     */
+    template <class Compare = std::less<DataType> >
+    VECTOR_DEQUE_CONSTEXPR DataType& nthElement(const size_t n, Compare cmp = Compare()) {
+        _checkIndex(n);
+        DataType* const first = linearize();
+        std::nth_element(first, first + n, first + _size, cmp);
+        Observers::notifyAssign(*this);
+        return first[n];
+    }
+
+    /**
+     * Get the element which would be at index `n` if `*this` were sorted, without reordering `*this`: the elements are
+     * copied segment by segment into `scratch`, which is reordered instead. Reusing `scratch` across calls avoids
+     * allocating once it has grown to `size()`.
+     * Runtime: `O(size())` on average
+     * @param n Index of the element to select.
+     * @param scratch Buffer to select in, whose contents are replaced.
+     * @param cmp Strict weak ordering of the elements.
+     * @return The `n`th smallest element.
+     * @throws std::length_error If `n >= size()`.
+     */
+    template <class Compare = std::less<DataType> >
+    DataType nthElementOf(const size_t n, std::vector<DataType>& scratch, Compare cmp = Compare()) const {
+        _checkIndex(n);
+        const VectorDequeSegments<const DataType> segments = _segments<const DataType>(0, _size);
+        scratch.assign(segments.first.begin(), segments.first.end());
+        scratch.insert(scratch.end(), segments.second.begin(), segments.second.end());
+        std::nth_element(scratch.begin(), scratch.begin() + static_cast<ptrdiff_t>(n), scratch.end(), cmp);
+        return scratch[n];
+    }
+
+    /**
+     * Get the observer of the observer policy `Policy`, which must be among the policies of `*this`.
+     * Runtime: `O(1)`
+     * @return The observer, through which the information it collected can be read.
+     */
+    template <class Policy>
+    VECTOR_DEQUE_CONSTEXPR typename Policy::template Observer<BasicVectorDeque>& observer() noexcept {
+        return *this;
+    }
+
+    /**
+     * Get the observer of the observer policy `Policy`, which must be among the policies of `*this`.
+     * Runtime: `O(1)`
+     * @return The observer, through which the information it collected can be read.
+     */
+    template <class Policy>
+    VECTOR_DEQUE_CONSTEXPR const typename Policy::template Observer<BasicVectorDeque>& observer() const noexcept {
+        return *this;
+    }
+
     /**
      * Get the first element of `*this`.
      * Runtime: `O(1)`
@@ -942,9 +1699,9 @@ class VectorDeque {
      * @return The first element of `*this`.
      * @throws std::length_error If `isEmpty()`.
      */
-    DataType peek() const {
+    VECTOR_DEQUE_CONSTEXPR const DataType& peek() const {
         _checkSize();
-        return (*this)[0];
+        return _data[_position];
     }
 
     /**
@@ -954,9 +1711,9 @@ class VectorDeque {
      * @return The last element of `*this`.
      * @throws std::length_error If `isEmpty()`.
      */
-    DataType peekLast() const {
+    VECTOR_DEQUE_CONSTEXPR const DataType& peekLast() const {
         _checkSize();
-        return (*this)[_size - 1];
+        return _data[_internalIndex(_size - 1)];
     }
 
     /**
@@ -966,7 +1723,7 @@ class VectorDeque {
      * @return The first element.
      * @throws std::length_error If `isEmpty()`.
      */
-    DataType pop() {
+    VECTOR_DEQUE_CONSTEXPR DataType pop() {
         _checkSize();
         const DataType popped = peek();
         skip();
@@ -978,7 +1735,7 @@ class VectorDeque {
      * Runtime: `O(size())`
      * @param target Array to put elements into.
      */
-    void popAll(DataType* const target) throw() {
+    VECTOR_DEQUE_CONSTEXPR void popAll(DataType* const target) {
         copyToArray(target);
         clear();
     }
@@ -988,7 +1745,7 @@ class VectorDeque {
      * Runtime: `O(size())`
      * @param target Array to put elements into.
      */
-    void popAllLast(DataType* const target) throw() {
+    VECTOR_DEQUE_CONSTEXPR void popAllLast(DataType* const target) {
         reverseCopyToArray(target);
         clear();
     }
@@ -1000,7 +1757,7 @@ class VectorDeque {
      * @return The last element.
      * @throws std::length_error If isEmpty().
      */
-    DataType popLast() {
+    VECTOR_DEQUE_CONSTEXPR DataType popLast() {
         _checkSize();
         const DataType popped = peekLast();
         skipLast();
@@ -1014,7 +1771,7 @@ class VectorDeque {
      * @param target Array to put removed elements into.
      * @throws std::length_error If `size() < amount`.
      */
-    void popSome(DataType* const target, const size_t amount) {
+    VECTOR_DEQUE_CONSTEXPR void popSome(DataType* const target, const size_t amount) {
         sliceToArray(target, 0, amount);
         skip(amount);
     }
@@ -1028,20 +1785,101 @@ class VectorDeque {
      * @param target Array to put removed elements into.
      * @throws std::length_error If `size() < amount`.
      */
-    void popSomeLast(DataType* const target, const size_t amount) {
+    VECTOR_DEQUE_CONSTEXPR void popSomeLast(DataType* const target, const size_t amount) {
         reverseSliceToArray(target, 0, amount);
         skipLast(amount);
     }
 
+    /**
+     * Remove the last element. Same as `skipLast()`, for standard containers.
+     * Runtime: `O(1)`
+     * @throws std::length_error If `isEmpty()`.
+     */
+    VECTOR_DEQUE_CONSTEXPR void pop_back() {
+        skipLast();
+    }
+
+    /**
+     * Remove the first element. Same as `skip()`, for standard containers.
+     * Runtime: `O(1)`
+     * @throws std::length_error If `isEmpty()`.
+     */
+    VECTOR_DEQUE_CONSTEXPR void pop_front() {
+        skip();
+    }
+
+    /**
+     * Copy `element` to the back of `*this`. Unlike `add`, `element` may be an element of `*this`.
+     * Runtime: `O(1)`
+     * @param element Element to add.
+     * @return `true` If `element` was added, `false` if the overflow policy dropped it.
+     */
+    VECTOR_DEQUE_CONSTEXPR bool push_back(const DataType& element) {
+        return emplace_back(element);
+    }
+
+    /**
+     * Move `element` to the back of `*this`.
+     * Runtime: `O(1)`
+     * @param element Element to add.
+     * @return `true` If `element` was added, `false` if the overflow policy dropped it.
+     */
+    VECTOR_DEQUE_CONSTEXPR bool push_back(DataType&& element) {
+        return emplace_back(std::move(element));
+    }
+
+    /**
+     * Copy `element` to the front of `*this`. Unlike `addFirst`, `element` may be an element of `*this`.
+     * Runtime: `O(1)`
+     * @param element Element to add.
+     * @return `true` If `element` was added, `false` if the overflow policy dropped it.
+     */
+    VECTOR_DEQUE_CONSTEXPR bool push_front(const DataType& element) {
+        return emplace_front(element);
+    }
+
+    /**
+     * Move `element` to the front of `*this`.
+     * Runtime: `O(1)`
+     * @param element Element to add.
+     * @return `true` If `element` was added, `false` if the overflow policy dropped it.
+     */
+    VECTOR_DEQUE_CONSTEXPR bool push_front(DataType&& element) {
+        return emplace_front(std::move(element));
+    }
+
     /**
      * Get a reverse iterator pointing to the last element of `*this`.
      * Runtime: `O(1)`
      * @return Reverse iterator pointing to the first element of `*this`.
      */
-    ReverseIterator rbegin() throw() {
+    VECTOR_DEQUE_CONSTEXPR ReverseIterator rbegin() noexcept {
         return ReverseIterator(this);
     }
 
+    /**
+     * Hand out the backing array of `*this` without copying, leaving `*this` empty with no backing array. The
+     * elements are first moved to the start of the array, so that the array holds them from index `0` in order; the
+     * receiver owns the array and frees it with `delete[]`. An inline backing array cannot be handed out, so its
+     * elements are moved into a new array instead.
+     * Runtime: `O(size())` if the elements do not start the backing array, `O(1)` otherwise
+     * @return The array, with the number of elements and its length.
+     */
+    VectorDequeBuffer<DataType> release() {
+        static_assert(Storage::NEW_ARRAYS, "The storage policy cannot release arrays to be freed with delete[]");
+        VectorDequeBuffer<DataType> buffer = {_data, _size, _capacity};
+        if (Storage::isInline(_data)) {
+            buffer.data = new DataType[_capacity];
+            _moveSliceToArray(buffer.data, 0, _size);
+        } else if (_numBeforeWrap(_position, _size) < _size) {
+            std::rotate(_data, _data + _position, _data + _capacity);
+        } else if (_position != 0) {
+            std::move(_data + _position, _data + _position + _size, _data);
+        }
+        _disown();
+        return buffer;
+    }
+
     /**
      * Remove the element at `index`.
      * Runtime: `O(size())`
@@ -1050,13 +1888,13 @@ class VectorDeque {
      * @return The removed element.
      * @throws std::length_error If `index >= size()`.
      */
-    DataType removeAt(const size_t index) {
+    VECTOR_DEQUE_CONSTEXPR DataType removeAt(const size_t index) {
         _checkIndex(index);
-        const DataType result = (*this)[index];
+        const DataType result = _at(index);
         if (index == _size - 1) {
             --_size;
         }
-        else if (index / 2 <= _size) {
+        else if (index <= _size / 2) {
             // More efficient to shift front elements forward.
             _shiftUp(0, index);
             --_size;
@@ -1066,6 +1904,7 @@ class VectorDeque {
             _shiftDown(index + 1, _size);
             --_size;
         }
+        Observers::notifyRemoveAt(*this, index);
         return result;
     }
     
@@ -1078,7 +1917,7 @@ class VectorDeque {
      * @throws std::length_error If `it` points to an out-of-bounds element.
      * @throws std::invalid_argument If `it` is not iterating over `*this`.
      */
-    DataType removeAt(const ConstIterator& it) {
+    VECTOR_DEQUE_CONSTEXPR DataType removeAt(const ConstIterator& it) {
         _checkIterator(it);
         return removeAt(it._position);
     }
@@ -1092,7 +1931,7 @@ class VectorDeque {
      * @throws std::length_error If `it` points to an out-of-bounds element.
      * @throws std::invalid_argument If `it` is not iterating over `*this`.
      */
-    DataType removeAt(const ConstReverseIterator& it) {
+    VECTOR_DEQUE_CONSTEXPR DataType removeAt(const ConstReverseIterator& it) {
         _checkIterator(it);
         removeAt(_size - it._position);
     }
@@ -1102,7 +1941,7 @@ class VectorDeque {
      * Runtime: `O(1)`
      * @return Iterator past the last element of `*this`.
      */
-    Iterator rend() throw() {
+    VECTOR_DEQUE_CONSTEXPR ReverseIterator rend() noexcept {
         return ReverseIterator(this, _size);
     } 
 
@@ -1111,7 +1950,7 @@ class VectorDeque {
      * Runtime: `O(size())`
      * @param target Array to copy to.
      */
-    void reverseCopyToArray(DataType* const target) const throw() {
+    VECTOR_DEQUE_CONSTEXPR void reverseCopyToArray(DataType* const target) const {
         reverseSliceToArray(target, 0, _size);
     }
 
@@ -1125,20 +1964,53 @@ class VectorDeque {
      * @throws std::length_error If `until > size()`.
      * @throws std::invalid_argument If `from > until`.
      */
-    void reverseSliceToArray(DataType* const target, const size_t from, const size_t until) const {
+    VECTOR_DEQUE_CONSTEXPR void reverseSliceToArray(DataType* const target, const size_t from,
+            const size_t until) const {
         _checkRange(from, until);
         const size_t length = until - from;
         for (size_t i = 0; i < length; ++i) {
-            target[i] = fromBack(i + from);
+            target[i] = _at(_size - from - i - 1);
         }
     }
 
+    /**
+     * Get the contiguous segments of the backing array holding the elements of `*this`, in order.
+     * Runtime: `O(1)`
+     * @return The segments.
+     */
+    VECTOR_DEQUE_CONSTEXPR VectorDequeSegments<DataType> segments() noexcept {
+        return _segments<DataType>(0, _size);
+    }
+
+    /**
+     * Get the contiguous segments of the backing array holding the elements of `*this`, in order.
+     * Runtime: `O(1)`
+     * @return The read-only segments.
+     */
+    VECTOR_DEQUE_CONSTEXPR VectorDequeSegments<const DataType> segments() const noexcept {
+        return _segments<const DataType>(0, _size);
+    }
+
+    /**
+     * Replace the element at `index` with `value`. Unlike writing through `operator []`, this notifies observers of
+     * the modification, which observers recording the contents (such as `LogChanges`) rely on.
+     * Runtime: `O(1)`
+     * Exception Safety: Strong
+     * @param index Index of the element to replace.
+     * @param value Value to replace it with.
+     * @throws std::length_error If `index >= size()`.
+     */
+    VECTOR_DEQUE_CONSTEXPR void set(const size_t index, const DataType& value) {
+        _at(index) = value;
+        Observers::notifySet(*this, index);
+    }
+
     /**
      * Returns the number of elements in `*this`.
      * Runtime: `O(1)`
      * @return The number of elements in `*this`.
      */
-    size_t size() const throw() {
+    VECTOR_DEQUE_CONSTEXPR size_t size() const noexcept {
         return _size;
     }
 
@@ -1149,10 +2021,11 @@ class VectorDeque {
      * @param amount Amount of elements to remove.
      * @throws std::length_error If `amount > size()`.
      */
-    void skip(const size_t amount = 1) {
+    VECTOR_DEQUE_CONSTEXPR void skip(const size_t amount = 1) {
         _checkSize(amount);
         _position = _internalIndex(amount);
         _size -= amount;
+        Observers::notifyRemove(*this, amount);
     }
 
     /**
@@ -1162,10 +2035,11 @@ class VectorDeque {
      * @param amount Amount of elements to remove.
      * @throws std::length_error If `amount > size()`
      */
-    void skipLast(const size_t amount = 1) {
+    VECTOR_DEQUE_CONSTEXPR void skipLast(const size_t amount = 1) {
         _checkSize(amount);
         // _position is already fine, since we are not removing from the front.
         _size -= amount;
+        Observers::notifyRemoveLast(*this, amount);
     }
 
     /**
@@ -1177,23 +2051,139 @@ class VectorDeque {
      * @param until Index of `*this` to stop copying (exclusive).
      * @throws std::length_error If `until > size()` or `from > until`.
      */
-    void sliceToArray(DataType* const target, const size_t from, const size_t until) const {
+    VECTOR_DEQUE_CONSTEXPR void sliceToArray(DataType* const target, const size_t from, const size_t until) const {
         _checkRange(from, until);
         const size_t length = until - from;
         const size_t start = _internalIndex(from);
         const size_t numBeforeWrap = _numBeforeWrap(start, length);
         const size_t numAfterWrap = length - numBeforeWrap;
-        memcpy(target, _data + start, sizeof(DataType) * numBeforeWrap);
-        memcpy(target + numBeforeWrap, _data, sizeof(DataType) *  numAfterWrap);
+        _copy(target, _data + start, numBeforeWrap);
+        _copy(target + numBeforeWrap, _data, numAfterWrap);
+    }
+
+    /**
+     * Put the `k` greatest elements of `*this` into `target`, greatest first, without reordering `*this`. This makes a
+     * single pass over the segments of `*this`, keeping the greatest elements seen so far in a heap built in `target`
+     * itself, so no other memory is used.
+     * Runtime: `O(size() * log(k))`
+     * @param k Number of elements to select.
+     * @param target Array of at least `k` elements to put the selected elements into.
+     * @param cmp Strict weak ordering of the elements. Pass `std::greater<DataType>()` to select the smallest instead.
+     * @throws std::length_error If `k > size()`.
+     */
+    template <class Compare = std::less<DataType> >
+    VECTOR_DEQUE_CONSTEXPR void topK(const size_t k, DataType* const target, Compare cmp = Compare()) const {
+        _checkSize(k);
+        if (k == 0) {
+            return;
+        }
+        // Inverted, so that the top of the heap is the least of the elements selected so far.
+        const auto inverted = [&cmp](const DataType& a, const DataType& b) {
+            return cmp(b, a);
+        };
+        const VectorDequeSegments<const DataType> segments = _segments<const DataType>(0, _size);
+        const VectorDequeSegment<const DataType> parts[] = {segments.first, segments.second};
+        size_t numSeen = 0;
+        for (const VectorDequeSegment<const DataType>& part: parts) {
+            for (const DataType& element: part) {
+                if (numSeen < k) {
+                    target[numSeen] = element;
+                    if (++numSeen == k) {
+                        std::make_heap(target, target + k, inverted);
+                    }
+                } else if (cmp(target[0], element)) {
+                    std::pop_heap(target, target + k, inverted);
+                    target[k - 1] = element;
+                    std::push_heap(target, target + k, inverted);
+                }
+            }
+        }
+        std::sort_heap(target, target + k, inverted);
+    }
+
+    /**
+     * Move the last `amount` elements of `*this` to the front of `target`, keeping their order. This is equivalent to
+     * `popSomeLast` into a temporary array followed by `addAllFirst` of it in reverse, but `target` is resized at most
+     * once and the elements are moved directly between the backing arrays in at most four blocks.
+     * Runtime: `O(amount)`, plus `O(target.size())` if `target` has to resize
+     * Exception Safety: Strong
+     * @param target Deque to move the elements to. May use different policies.
+     * @param amount Number of elements to move.
+     * @throws std::length_error If `amount > size()`, or if the elements would exceed the maximum size of `target`.
+     * Transfers are not subject to the overflow policy.
+     * @throws std::invalid_argument If `target` is `*this`.
+     */
+    template <class... TargetPolicies>
+    VECTOR_DEQUE_CONSTEXPR void transferLastTo(BasicVectorDeque<DataType, TargetPolicies...>& target,
+            const size_t amount) {
+        _checkTransferTarget(target);
+        _checkSize(amount);
+        target._checkMaxSize(amount);
+        target._ensureCanFit(amount);
+        const size_t targetStart = target._internalNegativeIndexFrom(0, amount);
+        _moveTo(target, _size - amount, targetStart, amount);
+        target._position = targetStart;
+        target._size += amount;
+        _size -= amount;
+        target.notifyAddFirst(target, amount);
+        Observers::notifyRemoveLast(*this, amount);
+    }
+
+    /**
+     * Move the first `amount` elements of `*this` to the back of `target`, keeping their order. This is equivalent to
+     * `popSome` into a temporary array followed by `addAll` of it, but `target` is resized at most once and the
+     * elements are moved directly between the backing arrays in at most four blocks.
+     * Runtime: `O(amount)`, plus `O(target.size())` if `target` has to resize
+     * Exception Safety: Strong
+     * @param target Deque to move the elements to. May use different policies.
+     * @param amount Number of elements to move.
+     * @throws std::length_error If `amount > size()`, or if the elements would exceed the maximum size of `target`.
+     * Transfers are not subject to the overflow policy.
+     * @throws std::invalid_argument If `target` is `*this`.
+     */
+    template <class... TargetPolicies>
+    VECTOR_DEQUE_CONSTEXPR void transferTo(BasicVectorDeque<DataType, TargetPolicies...>& target,
+            const size_t amount) {
+        _checkTransferTarget(target);
+        _checkSize(amount);
+        target._checkMaxSize(amount);
+        target._ensureCanFit(amount);
+        _moveTo(target, 0, target._writePosition(), amount);
+        target._size += amount;
+        _position = _internalIndex(amount);
+        _size -= amount;
+        target.notifyAdd(target, amount);
+        Observers::notifyRemove(*this, amount);
     }
 };
 
+template <class DataType, class... Policies>
+const size_t BasicVectorDeque<DataType, Policies...>::DEFAULT_INITIAL_CAPACITY = 11;
+
+/**
+ * `BasicVectorDeque` with the default policies.
+ * @param DataType The type of the data to contain.
+ */
 template <class DataType>
-const size_t VectorDeque<DataType>::DEFAULT_INITIAL_CAPACITY = 11;
+using VectorDeque = BasicVectorDeque<DataType>;
 
 // Leftover friend function.
 
 template <class DataType, class VectorDequeType, class MemberType, bool IS_REVERSE>
 typename VectorDeque<DataType>::template IteratorBase<VectorDequeType, MemberType, IS_REVERSE> operator +
     (const ptrdiff_t amount, const typename VectorDeque<DataType>::template 
-    IteratorBase<VectorDequeType, MemberType, IS_REVERSE>& it) throw();
\ No newline at end of file
+    IteratorBase<VectorDequeType, MemberType, IS_REVERSE>& it) noexcept;
+
+namespace std {
+    /**
+     * Allows `VectorDeque` to be used as a key in unordered containers.
+     */
+    template <class DataType, class... Policies>
+    struct hash<BasicVectorDeque<DataType, Policies...> > {
+        size_t operator ()(const BasicVectorDeque<DataType, Policies...>& vectorDeque) const noexcept {
+            return vectorDeque.hash();
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,637 @@
+#ifndef VECTOR_DEQUE_CHANGE_LOG_HPP
+#define VECTOR_DEQUE_CHANGE_LOG_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "VectorDeque.hpp"
+
+/*
+ * Incremental checkpoints of a `VectorDeque`: a full snapshot of the contents plus append-only logs of the changes made
+ * since, so that a checkpoint costs the size of the changes rather than the size of the deque.
+ *
+ * The checkpoint of a deque at path `base` is the snapshot `base.snapshot` and the logs `base.log.1`, `base.log.2`,
+ * and so on. Each log holds the changes made after the one before it; the snapshot records the last log folded into
+ * it, and `recoverChangeLog` loads it and replays the later logs in order. `LogChanges` starts a new log once the
+ * current one grows past a threshold, and folds the finished ones into a new snapshot on a background thread.
+ *
+ * Both kinds of file start with 4 magic bytes (`VDQS` for snapshots, `VDQL` for logs), a version byte, and the size of
+ * an element and the generation (the number of the last log folded in, or of the log itself) as unsigned LEB128
+ * varints. A snapshot then has the number of elements as a varint, followed by the elements. A log has one record per
+ * change: a `ChangeOperation` byte, its argument as a varint, and the elements it adds or sets. Elements are written as
+ * their raw bytes, so they must be trivially copyable, and checkpoints are only portable between platforms which
+ * represent them the same way.
+ */
+
+/**
+ * The changes recorded in a log, with the meaning of their argument and the elements following it.
+ */
+enum ChangeOperation {
+    // Elements added to the back (a count), followed by them in order.
+    CHANGE_ADD = 0,
+    // Elements added to the front (a count), followed by them in the order they are in the deque.
+    CHANGE_ADD_FIRST = 1,
+    // The contents were replaced (the new size), followed by every element.
+    CHANGE_ASSIGN = 2,
+    // An element inserted at the argument (an index), followed by it.
+    CHANGE_INSERT = 3,
+    // Elements removed from the front (a count). Consecutive removals are merged into one record.
+    CHANGE_REMOVE = 4,
+    // The element at the argument removed (an index).
+    CHANGE_REMOVE_AT = 5,
+    // Elements removed from the back (a count).
+    CHANGE_REMOVE_LAST = 6,
+    // The element at the argument replaced through `set` (an index), followed by its new value.
+    CHANGE_SET = 7
+};
+
+namespace vector_deque_detail {
+    static const uint8_t CHANGE_LOG_VERSION = 1;
+
+    inline std::string changeLogPath(const std::string& base, const uint64_t generation) {
+        return base + ".log." + std::to_string(generation);
+    }
+
+    inline std::string snapshotPath(const std::string& base) {
+        return base + ".snapshot";
+    }
+
+    // Write `value` as a varint, returning the number of bytes written.
+    inline size_t writeVarint(std::ostream& stream, uint64_t value) {
+        char bytes[10];
+        size_t length = 0;
+        while (value >= 0x80) {
+            bytes[length++] = static_cast<char>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        bytes[length++] = static_cast<char>(value);
+        stream.write(bytes, static_cast<std::streamsize>(length));
+        return length;
+    }
+
+    // Read a varint into `value`, returning `false` if the stream ends first.
+    inline bool readVarint(std::istream& stream, uint64_t& value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const int byte = stream.get();
+            if (byte == std::char_traits<char>::eof()) {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline void writeChangeLogHeader(std::ostream& stream, const char* const magic, const size_t elementSize,
+            const uint64_t generation) {
+        stream.write(magic, 4);
+        stream.put(static_cast<char>(CHANGE_LOG_VERSION));
+        writeVarint(stream, elementSize);
+        writeVarint(stream, generation);
+    }
+
+    // Check the header of the file at `path`, returning its generation.
+    inline uint64_t readChangeLogHeader(std::istream& stream, const char* const magic, const size_t elementSize,
+            const std::string& path) {
+        char header[5];
+        if (!stream.read(header, 5) || std::string(header, 4) != magic) {
+            throw std::runtime_error(path + " is not a VectorDeque checkpoint file");
+        }
+        if (static_cast<uint8_t>(header[4]) != CHANGE_LOG_VERSION) {
+            throw std::runtime_error("Unsupported checkpoint version " + std::to_string(
+                    static_cast<uint8_t>(header[4])) + " in " + path);
+        }
+        uint64_t fileElementSize;
+        uint64_t generation;
+        if (!readVarint(stream, fileElementSize) || !readVarint(stream, generation)) {
+            throw std::runtime_error("Truncated header in " + path);
+        }
+        if (fileElementSize != elementSize) {
+            throw std::runtime_error(path + " holds elements of " + std::to_string(fileElementSize) + " bytes, not "
+                    + std::to_string(elementSize));
+        }
+        return generation;
+    }
+
+    // Write the elements of `deque` from `from` until `until` as raw bytes.
+    template <class Deque>
+    void writeElements(std::ostream& stream, const Deque& deque, const size_t from, const size_t until) {
+        typedef typename Deque::value_type DataType;
+        static_assert(std::is_trivially_copyable<DataType>::value,
+                "Only trivially copyable elements can be checkpointed");
+        if (from == until) {
+            return;
+        }
+        const VectorDequeSegments<const DataType> segments = (deque.cbegin() + from).segmentsUntil(
+                deque.cbegin() + until);
+        stream.write(reinterpret_cast<const char*>(segments.first.data),
+                static_cast<std::streamsize>(segments.first.length * sizeof(DataType)));
+        stream.write(reinterpret_cast<const char*>(segments.second.data),
+                static_cast<std::streamsize>(segments.second.length * sizeof(DataType)));
+    }
+
+    // Read `count` elements into `elements`, returning `false` if the stream ends first.
+    template <class DataType>
+    bool readElements(std::istream& stream, std::vector<DataType>& elements, const uint64_t count) {
+        elements.resize(count);
+        return count == 0 || static_cast<bool>(stream.read(reinterpret_cast<char*>(elements.data()),
+                static_cast<std::streamsize>(count * sizeof(DataType))));
+    }
+
+    // Apply the records of the log at `path` to `deque`. A record cut short at the end of the log, as left by a crash
+    // while writing it, was never part of a checkpoint and is ignored, and so is a log left empty by a crash right
+    // after creating it.
+    template <class Deque>
+    void replayChangeLog(const std::string& path, const uint64_t generation, Deque& deque) {
+        typedef typename Deque::value_type DataType;
+        std::ifstream stream(path.c_str(), std::ios::binary);
+        if (stream.peek() == std::char_traits<char>::eof()) {
+            return;
+        }
+        if (readChangeLogHeader(stream, "VDQL", sizeof(DataType), path) != generation) {
+            throw std::runtime_error(path + " is not the log of generation " + std::to_string(generation));
+        }
+        std::vector<DataType> elements;
+        for (int operation = stream.get(); operation != std::char_traits<char>::eof(); operation = stream.get()) {
+            uint64_t argument;
+            if (!readVarint(stream, argument)) {
+                return;
+            }
+            switch (operation) {
+                case CHANGE_ADD:
+                    if (!readElements(stream, elements, argument)) {
+                        return;
+                    }
+                    deque.addAll(elements.data(), elements.size());
+                    break;
+                case CHANGE_ADD_FIRST:
+                    if (!readElements(stream, elements, argument)) {
+                        return;
+                    }
+                    for (size_t i = elements.size(); i > 0; --i) {
+                        deque.addFirst(elements[i - 1]);
+                    }
+                    break;
+                case CHANGE_ASSIGN:
+                    if (!readElements(stream, elements, argument)) {
+                        return;
+                    }
+                    deque.clear();
+                    deque.addAll(elements.data(), elements.size());
+                    break;
+                case CHANGE_INSERT:
+                    if (!readElements(stream, elements, 1)) {
+                        return;
+                    }
+                    deque.insert(elements[0], argument);
+                    break;
+                case CHANGE_REMOVE:
+                    deque.skip(argument);
+                    break;
+                case CHANGE_REMOVE_AT:
+                    deque.removeAt(argument);
+                    break;
+                case CHANGE_REMOVE_LAST:
+                    deque.skipLast(argument);
+                    break;
+                case CHANGE_SET:
+                    if (!readElements(stream, elements, 1)) {
+                        return;
+                    }
+                    deque.set(argument, elements[0]);
+                    break;
+                default:
+                    throw std::runtime_error("Unknown change operation " + std::to_string(operation) + " in " + path);
+            }
+        }
+    }
+
+    // Remove the logs of `generation` and those before it, stopping at the first which does not exist.
+    inline void removeChangeLogs(const std::string& base, uint64_t generation) {
+        for (; generation > 0 && std::remove(changeLogPath(base, generation).c_str()) == 0; --generation) {}
+    }
+}
+
+/**
+ * Write the contents of `deque` as the snapshot of `base`, replacing the existing one only once the new one is
+ * complete, so a crash leaves one or the other.
+ * Runtime: `O(deque.size())`
+ * @param base Path of the checkpoint, to which `.snapshot` is appended.
+ * @param deque The deque to write. Its elements must be trivially copyable.
+ * @param generation Number of the last log whose changes `deque` includes, or `0` if none.
+ * @throws std::runtime_error If the snapshot cannot be written.
+ */
+template <class Deque>
+void writeSnapshot(const std::string& base, const Deque& deque, const uint64_t generation) {
+    const std::string path = vector_deque_detail::snapshotPath(base);
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream stream(temporaryPath.c_str(), std::ios::binary | std::ios::trunc);
+        vector_deque_detail::writeChangeLogHeader(stream, "VDQS", sizeof(typename Deque::value_type), generation);
+        vector_deque_detail::writeVarint(stream, deque.size());
+        vector_deque_detail::writeElements(stream, deque, 0, deque.size());
+        stream.flush();
+        if (!stream) {
+            throw std::runtime_error("Cannot write snapshot " + temporaryPath);
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace snapshot " + path);
+    }
+}
+
+/**
+ * Restore `deque` from the checkpoint of `base`: load the snapshot, then replay each later log in order until one does
+ * not exist. The deque should not be logging its changes during recovery, or the replayed changes would be logged
+ * again; start logging afterwards with `resumeLog` on `deque.observer<LogChanges>()`.
+ * Runtime: `O(size of the snapshot and the logs)`
+ * @param base Path of the checkpoint.
+ * @param deque The deque to restore into. Its contents are replaced.
+ * @param lastGeneration Number of the last log to replay.
+ * @return The number of the last log replayed, or the generation of the snapshot if there was none.
+ * @throws std::runtime_error If the snapshot is missing or a file is not a valid checkpoint of elements of this size.
+ * @throws std::length_error If a log does not apply to the contents it follows.
+ */
+template <class Deque>
+uint64_t recoverChangeLog(const std::string& base, Deque& deque, const uint64_t lastGeneration = UINT64_MAX) {
+    typedef typename Deque::value_type DataType;
+    const std::string path = vector_deque_detail::snapshotPath(base);
+    std::ifstream stream(path.c_str(), std::ios::binary);
+    if (!stream) {
+        throw std::runtime_error("Cannot open snapshot " + path);
+    }
+    uint64_t generation = vector_deque_detail::readChangeLogHeader(stream, "VDQS", sizeof(DataType), path);
+    uint64_t size;
+    std::vector<DataType> elements;
+    if (!vector_deque_detail::readVarint(stream, size) || !vector_deque_detail::readElements(stream, elements, size)) {
+        throw std::runtime_error("Truncated snapshot " + path);
+    }
+    deque.clear();
+    deque.addAll(elements.data(), elements.size());
+    std::vector<DataType>().swap(elements);
+    for (; generation < lastGeneration; ++generation) {
+        const std::string logPath = vector_deque_detail::changeLogPath(base, generation + 1);
+        if (!std::ifstream(logPath.c_str())) {
+            break;
+        }
+        vector_deque_detail::replayChangeLog(logPath, generation + 1, deque);
+    }
+    return generation;
+}
+
+/**
+ * Observer policy which records every change to the deque in the log of a checkpoint (see the top of this file), so
+ * that the deque can be restored with `recoverChangeLog` without ever writing its full contents again. Logging is off
+ * until `startLog` or `resumeLog` is called; when off, the only cost is a null check per operation.
+ * Changes are buffered and reach the file when the buffer fills or at `checkpoint`. Writes through references
+ * (`operator []`, `front`, iterators) are not observed, so modify elements in place with `set`. Elements must be
+ * trivially copyable. Copies of a logged deque are not logged. The logging operations are members of the observer,
+ * `deque.observer<LogChanges>()`.
+ * Once the current log exceeds the compaction threshold, a new log is started and the finished ones are folded into a
+ * new snapshot by a background thread, which replays them onto the previous snapshot in memory, so it needs as much
+ * memory as the deque. Until a compaction finishes, no other is started and the current log keeps growing.
+ */
+struct LogChanges {
+    typedef ObserverPolicy Category;
+
+    /**
+     * Size of a log at which it is compacted unless another threshold is given.
+     */
+    static const uint64_t DEFAULT_COMPACT_BYTES = static_cast<uint64_t>(64) << 20;
+
+    template <class Deque>
+    class Observer: public VectorDequeObserver<Deque> {
+        private:
+        // A background compaction, shared with its thread.
+        struct Compaction {
+            std::thread thread;
+
+            // Set by the thread once it is done, after `error`.
+            std::atomic<bool> done;
+
+            // Why the compaction failed, if it did.
+            std::exception_ptr error;
+
+            Compaction(): done(false) {}
+        };
+
+        // The log being written, or `nullptr` when not logging.
+        std::unique_ptr<std::ofstream> _log;
+
+        std::string _base;
+
+        // Number of the log being written.
+        uint64_t _generation;
+
+        // Number of bytes written to the current log.
+        uint64_t _logBytes;
+
+        uint64_t _compactBytes;
+
+        // Number of elements removed from the front and not yet recorded, so that consecutive removals make one
+        // record.
+        uint64_t _pendingRemoved;
+
+        // The latest compaction, or `nullptr` if none was started since the last was finished.
+        std::unique_ptr<Compaction> _compaction;
+
+        // Wait for the latest compaction, throwing its error if it failed.
+        void _finishCompaction() {
+            if (!_compaction) {
+                return;
+            }
+            _compaction->thread.join();
+            const std::exception_ptr error = _compaction->error;
+            _compaction.reset();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        // Write the pending front removals, if any.
+        void _flushRemoved() {
+            if (_pendingRemoved != 0) {
+                const uint64_t count = _pendingRemoved;
+                _pendingRemoved = 0;
+                _writeHeader(CHANGE_REMOVE, count);
+            }
+        }
+
+        // Start writing the log of `generation`.
+        void _openLog(const uint64_t generation) {
+            const std::string path = vector_deque_detail::changeLogPath(_base, generation);
+            std::unique_ptr<std::ofstream> log(new std::ofstream(path.c_str(), std::ios::binary | std::ios::trunc));
+            vector_deque_detail::writeChangeLogHeader(*log, "VDQL", sizeof(typename Deque::value_type), generation);
+            log->flush();
+            if (!*log) {
+                throw std::runtime_error("Cannot open log " + path);
+            }
+            _log = std::move(log);
+            _generation = generation;
+            _logBytes = 0;
+            _pendingRemoved = 0;
+        }
+
+        // Record a change of `count` elements starting at `from`, with its argument.
+        void _record(const Deque& deque, const ChangeOperation operation, const uint64_t argument, const size_t from,
+                const size_t count) {
+            if (!_log) {
+                return;
+            }
+            _flushRemoved();
+            _writeHeader(operation, argument);
+            vector_deque_detail::writeElements(*_log, deque, from, from + count);
+            _logBytes += count * sizeof(typename Deque::value_type);
+            if (!*_log) {
+                throw std::runtime_error("Cannot write log " + vector_deque_detail::changeLogPath(_base, _generation));
+            }
+            if (_logBytes >= _compactBytes) {
+                compact();
+            }
+        }
+
+        // Write the operation and argument of a record.
+        void _writeHeader(const ChangeOperation operation, const uint64_t argument) {
+            _log->put(static_cast<char>(operation));
+            _logBytes += 1 + vector_deque_detail::writeVarint(*_log, argument);
+        }
+
+        protected:
+        void onAdd(const Deque& deque, const size_t count) {
+            _record(deque, CHANGE_ADD, count, deque.size() - count, count);
+        }
+
+        void onAddFirst(const Deque& deque, const size_t count) {
+            _record(deque, CHANGE_ADD_FIRST, count, 0, count);
+        }
+
+        void onAssign(const Deque& deque) {
+            _record(deque, CHANGE_ASSIGN, deque.size(), 0, deque.size());
+        }
+
+        void onInsert(const Deque& deque, const size_t index) {
+            _record(deque, CHANGE_INSERT, index, index, 1);
+        }
+
+        void onRemove(const Deque&, const size_t count) {
+            if (_log) {
+                _pendingRemoved += count;
+            }
+        }
+
+        void onRemoveAt(const Deque& deque, const size_t index) {
+            _record(deque, CHANGE_REMOVE_AT, index, 0, 0);
+        }
+
+        void onRemoveLast(const Deque& deque, const size_t count) {
+            _record(deque, CHANGE_REMOVE_LAST, count, 0, 0);
+        }
+
+        void onSet(const Deque& deque, const size_t index) {
+            _record(deque, CHANGE_SET, index, index, 1);
+        }
+
+        public:
+        Observer(): _generation(0), _logBytes(0), _compactBytes(DEFAULT_COMPACT_BYTES), _pendingRemoved(0) {}
+
+        Observer(Observer&& that) noexcept: _log(std::move(that._log)), _base(std::move(that._base)),
+                _generation(that._generation), _logBytes(that._logBytes), _compactBytes(that._compactBytes),
+                _pendingRemoved(that._pendingRemoved), _compaction(std::move(that._compaction)) {}
+
+        Observer& operator =(Observer&& that) {
+            if (this != &that) {
+                stopLog();
+                _log = std::move(that._log);
+                _base = std::move(that._base);
+                _generation = that._generation;
+                _logBytes = that._logBytes;
+                _compactBytes = that._compactBytes;
+                _pendingRemoved = that._pendingRemoved;
+                _compaction = std::move(that._compaction);
+            }
+            return *this;
+        }
+
+        /**
+         * Stops logging, writing the buffered changes and waiting for any compaction. Errors are ignored; call
+         * `stopLog` first to see them.
+         */
+        ~Observer() {
+            try {
+                stopLog();
+            } catch (...) {}
+        }
+
+        /**
+         * Write the buffered changes to the log, making the checkpoint include every change so far. The data is
+         * handed to the operating system, which writes it to the disk in the background.
+         * Runtime: `O(number of buffered bytes)`
+         * @throws std::logic_error If not logging.
+         * @throws std::runtime_error If the log cannot be written, or a finished compaction failed.
+         */
+        void checkpoint() {
+            if (!_log) {
+                throw std::logic_error("Changes are not being logged");
+            }
+            _flushRemoved();
+            _log->flush();
+            if (!*_log) {
+                throw std::runtime_error("Cannot write log " + vector_deque_detail::changeLogPath(_base, _generation));
+            }
+            if (_compaction && _compaction->done.load(std::memory_order_acquire)) {
+                _finishCompaction();
+            }
+        }
+
+        /**
+         * Start a new log now and fold the finished ones into a new snapshot in the background, unless a compaction
+         * is still running. This happens on its own once the log exceeds the compaction threshold.
+         * Runtime: `O(number of buffered bytes)`, plus that of compacting in the background
+         * @return `true` If a compaction was started, `false` if the previous one is still running.
+         * @throws std::logic_error If not logging.
+         * @throws std::runtime_error If the logs cannot be written, or the previous compaction failed.
+         */
+        bool compact() {
+            typedef typename Deque::value_type DataType;
+            if (!_log) {
+                throw std::logic_error("Changes are not being logged");
+            }
+            if (_compaction) {
+                if (!_compaction->done.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                _finishCompaction();
+            }
+            checkpoint();
+            const uint64_t finished = _generation;
+            _log.reset();
+            _openLog(finished + 1);
+            Compaction* const compaction = new Compaction();
+            _compaction.reset(compaction);
+            const std::string base = _base;
+            compaction->thread = std::thread([compaction, base, finished]() {
+                try {
+                    VectorDeque<DataType> snapshot;
+                    recoverChangeLog(base, snapshot, finished);
+                    writeSnapshot(base, snapshot, finished);
+                    vector_deque_detail::removeChangeLogs(base, finished);
+                } catch (...) {
+                    compaction->error = std::current_exception();
+                }
+                compaction->done.store(true, std::memory_order_release);
+            });
+            return true;
+        }
+
+        /**
+         * Returns the number of the log being written.
+         * Runtime: `O(1)`
+         * @return The generation of the current log, or of the last one if logging has stopped.
+         */
+        uint64_t generation() const noexcept {
+            return _generation;
+        }
+
+        /**
+         * Checks whether changes are currently being logged.
+         * Runtime: `O(1)`
+         * @return `true` If logging is started, `false` otherwise.
+         */
+        bool isLogging() const noexcept {
+            return static_cast<bool>(_log);
+        }
+
+        /**
+         * Returns the number of bytes of changes in the current log, buffered or not.
+         * Runtime: `O(1)`
+         * @return The number of bytes, not counting the header.
+         */
+        uint64_t logBytes() const noexcept {
+            return _logBytes;
+        }
+
+        /**
+         * Continue the checkpoint of `base` after the deque was restored from it with `recoverChangeLog`: changes are
+         * logged from the next generation on, and the existing logs are folded in by the next compaction.
+         * Runtime: `O(1)`
+         * @param base Path of the checkpoint.
+         * @param generation The generation returned by `recoverChangeLog`.
+         * @param compactBytes Size of a log at which it is compacted.
+         * @throws std::runtime_error If the log cannot be opened, or a previous compaction failed.
+         */
+        void resumeLog(const std::string& base, const uint64_t generation,
+                const uint64_t compactBytes = DEFAULT_COMPACT_BYTES) {
+            stopLog();
+            _base = base;
+            _compactBytes = compactBytes;
+            _openLog(generation + 1);
+        }
+
+        /**
+         * Start a new checkpoint of the deque at `base`: its contents are written as a snapshot, replacing any
+         * checkpoint there, and changes are logged from then on.
+         * Runtime: `O(size())` of the deque
+         * @param base Path of the checkpoint.
+         * @param compactBytes Size of a log at which it is compacted.
+         * @throws std::runtime_error If the snapshot or the log cannot be written, or a previous compaction failed.
+         */
+        void startLog(const std::string& base, const uint64_t compactBytes = DEFAULT_COMPACT_BYTES) {
+            stopLog();
+            // Remove the logs of an earlier checkpoint: those following its snapshot, and any which a compaction did
+            // not get to remove.
+            uint64_t oldGeneration = 0;
+            try {
+                std::ifstream stream(vector_deque_detail::snapshotPath(base).c_str(), std::ios::binary);
+                oldGeneration = vector_deque_detail::readChangeLogHeader(stream, "VDQS",
+                        sizeof(typename Deque::value_type), base);
+            } catch (const std::runtime_error&) {}
+            vector_deque_detail::removeChangeLogs(base, oldGeneration);
+            for (uint64_t generation = oldGeneration + 1;
+                    std::remove(vector_deque_detail::changeLogPath(base, generation).c_str()) == 0; ++generation) {}
+            writeSnapshot(base, vector_deque_detail::ObserverAccess::deque<Deque>(*this), 0);
+            _base = base;
+            _compactBytes = compactBytes;
+            _openLog(1);
+        }
+
+        /**
+         * Stop logging: write the buffered changes, close the log and wait for any compaction.
+         * Runtime: `O(number of buffered bytes)`, plus the rest of a running compaction
+         * @return The generation of the last log, which `recoverChangeLog` replays up to, or `0` if not logging.
+         * @throws std::runtime_error If the log cannot be written, or a compaction failed.
+         */
+        uint64_t stopLog() {
+            uint64_t generation = 0;
+            if (_log) {
+                _flushRemoved();
+                _log->flush();
+                const bool written = static_cast<bool>(*_log);
+                _log.reset();
+                generation = _generation;
+                if (!written) {
+                    _finishCompaction();
+                    throw std::runtime_error("Cannot write log "
+                            + vector_deque_detail::changeLogPath(_base, generation));
+                }
+            }
+            _finishCompaction();
+            return generation;
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,216 @@
+#ifndef VECTOR_DEQUE_OCCUPANCY_HPP
+#define VECTOR_DEQUE_OCCUPANCY_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+#include "StaticVectorDeque.hpp"
+#include "VectorDequePolicies.hpp"
+
+/**
+ * The occupancy of a deque over one interval, recorded by `RecordOccupancy`.
+ */
+struct OccupancySample {
+    // Time the interval ended, in nanoseconds since the epoch of the recorder's clock.
+    int64_t time;
+
+    // Number of operations made on the deque up to the end of the interval.
+    uint64_t operations;
+
+    // Size at the end of the interval.
+    size_t size;
+
+    // Smallest and largest size during the interval: its low and high water marks.
+    size_t lowSize;
+    size_t highSize;
+
+    // Capacity at the end of the interval.
+    size_t capacity;
+
+    // Largest capacity during the interval.
+    size_t highCapacity;
+};
+
+/**
+ * Observer policy which records the occupancy history of the deque, for choosing initial capacities and shrink
+ * thresholds. Operations (additions, removals, insertions, assignments and resizes) are grouped into intervals, of a
+ * number of operations or of a duration, and each interval's final, lowest and highest size and capacity are kept in
+ * a ring of the last `NUM_SAMPLES` intervals. The history is available as samples, CSV or JSON.
+ * By default an interval is 1024 operations; use `sampleOccupancyEvery` to change it.
+ * @param Clock The clock to stamp samples with and to time intervals by, such as `std::chrono::steady_clock`.
+ * @param NUM_SAMPLES The number of intervals kept. Older ones are dropped.
+ */
+template <class Clock, size_t NUM_SAMPLES = 64>
+struct BasicRecordOccupancy {
+    typedef ObserverPolicy Category;
+
+    template <class Deque>
+    class Observer: public VectorDequeObserver<Deque> {
+        private:
+        StaticVectorDeque<OccupancySample, NUM_SAMPLES> _occupancySamples;
+
+        // The interval in progress, whose `time` is when it started.
+        OccupancySample _current;
+
+        // Whether an operation has been made in the current interval, so that its fields are set.
+        bool _started;
+
+        // Length of an interval in operations and in nanoseconds. `0` disables the corresponding limit.
+        uint64_t _operationsPerSample;
+        int64_t _nanosecondsPerSample;
+
+        // Number of operations made since the current interval started.
+        uint64_t _operationsInSample;
+
+        static int64_t _now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        }
+
+        void _operation(const Deque& deque) {
+            const size_t size = deque.size();
+            const size_t capacity = deque.capacity();
+            ++_current.operations;
+            ++_operationsInSample;
+            if (!_started) {
+                _started = true;
+                _current.time = _now();
+                _current.lowSize = size;
+                _current.highSize = size;
+                _current.highCapacity = capacity;
+            } else {
+                _current.lowSize = size < _current.lowSize ? size : _current.lowSize;
+                _current.highSize = size > _current.highSize ? size : _current.highSize;
+                _current.highCapacity = capacity > _current.highCapacity ? capacity : _current.highCapacity;
+            }
+            _current.size = size;
+            _current.capacity = capacity;
+            if ((_operationsPerSample != 0 && _operationsInSample >= _operationsPerSample)
+                    || (_nanosecondsPerSample != 0 && _now() - _current.time >= _nanosecondsPerSample)) {
+                closeOccupancySample();
+            }
+        }
+
+        protected:
+        void onAdd(const Deque& deque, const size_t) {
+            _operation(deque);
+        }
+
+        void onAddFirst(const Deque& deque, const size_t) {
+            _operation(deque);
+        }
+
+        void onAssign(const Deque& deque) {
+            _operation(deque);
+        }
+
+        void onInsert(const Deque& deque, const size_t) {
+            _operation(deque);
+        }
+
+        void onRemove(const Deque& deque, const size_t) {
+            _operation(deque);
+        }
+
+        void onRemoveAt(const Deque& deque, const size_t) {
+            _operation(deque);
+        }
+
+        void onRemoveLast(const Deque& deque, const size_t) {
+            _operation(deque);
+        }
+
+        void onResize(const Deque& deque, const size_t) {
+            _operation(deque);
+        }
+
+        public:
+        Observer(): _current(), _started(false), _operationsPerSample(1024), _nanosecondsPerSample(0),
+                _operationsInSample(0) {}
+
+        /**
+         * End the current interval now and record it, if it had any operation. The next operation starts a new one.
+         * Runtime: `O(1)`
+         */
+        void closeOccupancySample() {
+            if (!_started) {
+                return;
+            }
+            OccupancySample sample = _current;
+            sample.time = _now();
+            if (_occupancySamples.isFull()) {
+                _occupancySamples.skip();
+            }
+            _occupancySamples.add(sample);
+            _started = false;
+            _operationsInSample = 0;
+        }
+
+        /**
+         * Get the recorded intervals as CSV, with a header row and one row per interval from oldest to newest.
+         * Runtime: `O(NUM_SAMPLES)`
+         * @return The CSV.
+         */
+        std::string occupancyCsv() const {
+            std::ostringstream stream;
+            stream << "time,operations,size,low_size,high_size,capacity,high_capacity\n";
+            for (size_t i = 0; i < _occupancySamples.size(); ++i) {
+                const OccupancySample& sample = _occupancySamples[i];
+                stream << sample.time << ',' << sample.operations << ',' << sample.size << ',' << sample.lowSize << ','
+                        << sample.highSize << ',' << sample.capacity << ',' << sample.highCapacity << '\n';
+            }
+            return stream.str();
+        }
+
+        /**
+         * Get the recorded intervals as a JSON array of objects, from oldest to newest.
+         * Runtime: `O(NUM_SAMPLES)`
+         * @return The JSON.
+         */
+        std::string occupancyJson() const {
+            std::ostringstream stream;
+            stream << '[';
+            for (size_t i = 0; i < _occupancySamples.size(); ++i) {
+                const OccupancySample& sample = _occupancySamples[i];
+                stream << (i == 0 ? "" : ",") << "{\"time\":" << sample.time << ",\"operations\":" << sample.operations
+                        << ",\"size\":" << sample.size << ",\"lowSize\":" << sample.lowSize << ",\"highSize\":"
+                        << sample.highSize << ",\"capacity\":" << sample.capacity << ",\"highCapacity\":"
+                        << sample.highCapacity << '}';
+            }
+            stream << ']';
+            return stream.str();
+        }
+
+        /**
+         * Get the recorded intervals, from oldest to newest.
+         * Runtime: `O(1)`
+         * @return The ring of intervals.
+         */
+        const StaticVectorDeque<OccupancySample, NUM_SAMPLES>& occupancySamples() const noexcept {
+            return _occupancySamples;
+        }
+
+        /**
+         * Set the length of the intervals, starting with the current one. An interval ends when either limit is
+         * reached.
+         * Runtime: `O(1)`
+         * @param operations Number of operations per interval, or `0` for no limit.
+         * @param duration Duration of an interval, or zero for no limit. Checking it reads the clock on every
+         *        operation.
+         */
+        void sampleOccupancyEvery(const uint64_t operations,
+                const std::chrono::nanoseconds duration = std::chrono::nanoseconds(0)) noexcept {
+            _operationsPerSample = operations;
+            _nanosecondsPerSample = duration.count();
+        }
+    };
+};
+
+/**
+ * `BasicRecordOccupancy` using `std::chrono::steady_clock` and keeping 64 intervals.
+ */
+typedef BasicRecordOccupancy<std::chrono::steady_clock> RecordOccupancy;
+
+#endif
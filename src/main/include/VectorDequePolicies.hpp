@@ -0,0 +1,782 @@
+#ifndef VECTOR_DEQUE_POLICIES_HPP
+#define VECTOR_DEQUE_POLICIES_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// `VectorDeque` is usable in constant expressions when the compiler supports transient allocation (C++20).
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L
+#define VECTOR_DEQUE_CONSTEXPR constexpr
+#else
+#define VECTOR_DEQUE_CONSTEXPR
+#endif
+
+/*
+ * Compile-time policies for `BasicVectorDeque`. Each policy declares which aspect of the deque it configures through
+ * its `Category` typedef, and policies may be given to `BasicVectorDeque` in any order. Any aspect which is not
+ * configured uses the same behavior as the plain `VectorDeque`, and every policy which is not in use compiles away.
+ */
+
+/**
+ * Category of policies deciding what happens when an index or size is out of bounds.
+ */
+struct BoundsCheckingPolicy {};
+
+/**
+ * Category of policies deciding the new capacity when a `BasicVectorDeque` needs to grow.
+ */
+struct GrowthPolicy {};
+
+/**
+ * Category of policies deciding how logical indices are wrapped around the backing array.
+ */
+struct WrappingPolicy {};
+
+/**
+ * Category of policies deciding where the backing array is stored.
+ */
+struct StoragePolicy {};
+
+/**
+ * Category of policies deciding the type of the capacity, position and size stored in the deque.
+ */
+struct IndexPolicy {};
+
+/**
+ * Category of policies deciding whether the size is bounded, and what happens to additions beyond the bound.
+ */
+struct OverflowPolicy {};
+
+/**
+ * Category of policies which are notified of modifications. Unlike the other categories, any number of observers
+ * may be given.
+ */
+struct ObserverPolicy {};
+
+/**
+ * Out-of-bounds accesses throw `std::length_error` (or `std::invalid_argument` for malformed ranges).
+ * This is the default.
+ */
+struct ThrowOnOutOfBounds {
+    typedef BoundsCheckingPolicy Category;
+
+    static const bool ENABLED = true;
+
+    template <class Exception>
+    static void fail(const std::string& message) {
+        throw Exception(message);
+    }
+};
+
+/**
+ * Out-of-bounds accesses fail an `assert`, so they are only checked when `NDEBUG` is not defined.
+ */
+struct AssertOnOutOfBounds {
+    typedef BoundsCheckingPolicy Category;
+
+#ifdef NDEBUG
+    static const bool ENABLED = false;
+#else
+    static const bool ENABLED = true;
+#endif
+
+    template <class Exception>
+    static void fail(const std::string&) noexcept {
+        assert(!"VectorDeque index out of bounds");
+    }
+};
+
+/**
+ * Bounds are never checked. Out-of-bounds accesses have undefined behavior.
+ */
+struct NoBoundsChecking {
+    typedef BoundsCheckingPolicy Category;
+
+    static const bool ENABLED = false;
+
+    template <class Exception>
+    static VECTOR_DEQUE_CONSTEXPR void fail(const std::string&) noexcept {}
+};
+
+/**
+ * Grow to a little over twice the required capacity. This is the default.
+ */
+struct DoublingGrowth {
+    typedef GrowthPolicy Category;
+
+    static VECTOR_DEQUE_CONSTEXPR size_t grow(const size_t, const size_t required) noexcept {
+        return required * 2 + 1;
+    }
+};
+
+/**
+ * Grow to a little over 1.5 times the required capacity, trading more frequent resizes for less slack.
+ */
+struct OneAndAHalfGrowth {
+    typedef GrowthPolicy Category;
+
+    static VECTOR_DEQUE_CONSTEXPR size_t grow(const size_t, const size_t required) noexcept {
+        return required + required / 2 + 1;
+    }
+};
+
+/**
+ * Never grow: adding to a full deque throws `std::length_error`.
+ */
+struct FixedCapacity {
+    typedef GrowthPolicy Category;
+
+    static size_t grow(const size_t capacity, const size_t) {
+        throw std::length_error("VectorDeque is at its fixed capacity of " + std::to_string(capacity));
+    }
+};
+
+/**
+ * Wrap indices with a comparison and a subtraction. Works with any capacity. This is the default.
+ */
+struct BranchWrapping {
+    typedef WrappingPolicy Category;
+
+    static const bool REQUIRES_POWER_OF_TWO = false;
+
+    // Round `capacity` up to a capacity supported by this policy.
+    static VECTOR_DEQUE_CONSTEXPR size_t capacityFor(const size_t capacity) noexcept {
+        return capacity;
+    }
+
+    // Wrap `index`, which must be less than `2 * capacity`.
+    static VECTOR_DEQUE_CONSTEXPR size_t wrap(const size_t index, const size_t capacity) noexcept {
+        return index < capacity ? index : index - capacity;
+    }
+
+    // Wrap `index - offset`, where both `index` and `offset` are at most `capacity`.
+    static VECTOR_DEQUE_CONSTEXPR size_t wrapBackwards(const size_t index, const size_t offset,
+            const size_t capacity) noexcept {
+        return index >= offset ? index - offset : capacity - (offset - index);
+    }
+};
+
+/**
+ * Wrap indices by masking, which requires the capacity to always be a power of two. Capacities requested through
+ * constructors are rounded up accordingly, and growth steps are rounded down to a power of two which fits the required
+ * elements, so that every resize doubles the capacity at least. `OneAndAHalfGrowth` therefore doubles too.
+ */
+struct MaskWrapping {
+    typedef WrappingPolicy Category;
+
+    static const bool REQUIRES_POWER_OF_TWO = true;
+
+    static VECTOR_DEQUE_CONSTEXPR size_t capacityFor(const size_t capacity) noexcept {
+        size_t result = 1;
+        while (result < capacity) {
+            result <<= 1;
+        }
+        return capacity == 0 ? 0 : result;
+    }
+
+    static VECTOR_DEQUE_CONSTEXPR size_t wrap(const size_t index, const size_t capacity) noexcept {
+        return index & (capacity - 1);
+    }
+
+    static VECTOR_DEQUE_CONSTEXPR size_t wrapBackwards(const size_t index, const size_t offset,
+            const size_t capacity) noexcept {
+        return (index - offset) & (capacity - 1);
+    }
+};
+
+/**
+ * Store the backing array on the heap. This is the default.
+ */
+struct HeapStorage {
+    typedef StoragePolicy Category;
+
+    template <class DataType>
+    class Storage {
+        public:
+        static const size_t INLINE_CAPACITY = 0;
+
+        // Whether arrays which are not inline are allocated with `new DataType[capacity]` and freed with `delete[]`, so
+        // that the deque can adopt and release them.
+        static const bool NEW_ARRAYS = true;
+
+        // Capacity to use when no capacity is given.
+        static VECTOR_DEQUE_CONSTEXPR size_t defaultCapacity(const size_t suggested) noexcept {
+            return suggested;
+        }
+
+        // Allocate an array of at least `capacity` elements, updating `capacity` to its actual length.
+        VECTOR_DEQUE_CONSTEXPR DataType* allocate(size_t& capacity) const {
+            return new DataType[capacity];
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void deallocate(DataType* const data, const size_t) const noexcept {
+            delete[] data;
+        }
+
+        // Whether `data` lives inside the storage object, in which case it cannot be handed to another deque.
+        VECTOR_DEQUE_CONSTEXPR bool isInline(const DataType* const) const noexcept {
+            return false;
+        }
+    };
+};
+
+/**
+ * Store up to `CAPACITY` elements inside the deque itself. The deque never allocates, and adding more than `CAPACITY`
+ * elements throws `std::length_error`. Moving such a deque copies its elements.
+ * @param CAPACITY The number of elements stored inline.
+ */
+template <size_t CAPACITY>
+struct InlineStorage {
+    typedef StoragePolicy Category;
+
+    template <class DataType>
+    class Storage {
+        private:
+        DataType _buffer[CAPACITY];
+
+        public:
+        static const size_t INLINE_CAPACITY = CAPACITY;
+
+        static const bool NEW_ARRAYS = false;
+
+        static VECTOR_DEQUE_CONSTEXPR size_t defaultCapacity(const size_t) noexcept {
+            return CAPACITY;
+        }
+
+        VECTOR_DEQUE_CONSTEXPR DataType* allocate(size_t& capacity) {
+            if (capacity > CAPACITY) {
+                throw std::length_error("VectorDeque is at its inline capacity of " + std::to_string(CAPACITY));
+            }
+            capacity = CAPACITY;
+            return _buffer;
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void deallocate(DataType* const, const size_t) const noexcept {}
+
+        VECTOR_DEQUE_CONSTEXPR bool isInline(const DataType* const data) const noexcept {
+            return data == _buffer;
+        }
+    };
+};
+
+/**
+ * Store up to `CAPACITY` elements inside the deque itself, and move to the heap once more are needed.
+ * @param CAPACITY The number of elements stored inline.
+ */
+template <size_t CAPACITY>
+struct SmallBufferStorage {
+    typedef StoragePolicy Category;
+
+    template <class DataType>
+    class Storage {
+        private:
+        DataType _buffer[CAPACITY];
+
+        public:
+        static const size_t INLINE_CAPACITY = CAPACITY;
+
+        static const bool NEW_ARRAYS = true;
+
+        static VECTOR_DEQUE_CONSTEXPR size_t defaultCapacity(const size_t) noexcept {
+            return CAPACITY;
+        }
+
+        VECTOR_DEQUE_CONSTEXPR DataType* allocate(size_t& capacity) {
+            if (capacity <= CAPACITY) {
+                capacity = CAPACITY;
+                return _buffer;
+            }
+            return new DataType[capacity];
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void deallocate(DataType* const data, const size_t) const noexcept {
+            if (!isInline(data)) {
+                delete[] data;
+            }
+        }
+
+        VECTOR_DEQUE_CONSTEXPR bool isInline(const DataType* const data) const noexcept {
+            return data == _buffer;
+        }
+    };
+};
+
+/**
+ * Store the capacity, position and size of the deque as `IndexType`, which limits the capacity to the largest value of
+ * `IndexType` (or the largest power of two for `MaskWrapping`); growing beyond it throws `std::length_error`. With
+ * `uint32_t`, a deque on a 64-bit platform takes 24 bytes instead of 32, which adds up when many small deques are kept.
+ * The default is `Indices<size_t>`.
+ * @param IndexType An unsigned integer type.
+ */
+template <class IndexType>
+struct Indices {
+    typedef IndexPolicy Category;
+
+    static_assert(std::is_unsigned<IndexType>::value && sizeof(IndexType) <= sizeof(size_t),
+            "Indices must be an unsigned type no larger than size_t");
+
+    typedef IndexType Index;
+};
+
+/**
+ * 32-bit indices, for deques which never hold more than about 4 billion elements.
+ */
+typedef Indices<uint32_t> CompactIndices;
+
+/**
+ * The size is unbounded: the deque grows as needed. This is the default.
+ */
+struct Unbounded {
+    typedef OverflowPolicy Category;
+
+    static const bool BOUNDED = false;
+
+    static VECTOR_DEQUE_CONSTEXPR size_t maxSize() noexcept {
+        return std::numeric_limits<size_t>::max();
+    }
+};
+
+/**
+ * What a bounded deque does with a batch of additions which would exceed its maximum size: the first `skip` elements
+ * of the batch are dropped and the `count` after them are added. Any room needed has been made by the policy.
+ */
+struct OverflowDecision {
+    size_t skip;
+    size_t count;
+};
+
+namespace vector_deque_detail {
+    // State shared by the bounded overflow policies: the maximum size and the counters.
+    class Bound {
+        private:
+        size_t _maxSize = std::numeric_limits<size_t>::max();
+
+        size_t _numDropped = 0;
+
+        size_t _numOverflows = 0;
+
+        protected:
+        // Count a batch which overflowed, of which `numDropped` elements (incoming or evicted) were dropped.
+        VECTOR_DEQUE_CONSTEXPR void _overflowed(const size_t numDropped) noexcept {
+            ++_numOverflows;
+            _numDropped += numDropped;
+        }
+
+        public:
+        static const bool BOUNDED = true;
+
+        /**
+         * Returns the maximum size. Unlimited until `setMaxSize` is called.
+         * Runtime: `O(1)`
+         * @return The maximum size.
+         */
+        VECTOR_DEQUE_CONSTEXPR size_t maxSize() const noexcept {
+            return _maxSize;
+        }
+
+        /**
+         * Returns the number of elements dropped so far, whether they were rejected or evicted.
+         * Runtime: `O(1)`
+         * @return The number of elements dropped.
+         */
+        VECTOR_DEQUE_CONSTEXPR size_t numDropped() const noexcept {
+            return _numDropped;
+        }
+
+        /**
+         * Returns the number of additions (counting a batch as one) which would have exceeded the maximum size.
+         * Runtime: `O(1)`
+         * @return The number of overflows.
+         */
+        VECTOR_DEQUE_CONSTEXPR size_t numOverflows() const noexcept {
+            return _numOverflows;
+        }
+
+        /**
+         * Set the maximum size. Elements already beyond it are kept; it applies to additions from now on.
+         * Runtime: `O(1)`
+         * @param maxSize The maximum size.
+         */
+        VECTOR_DEQUE_CONSTEXPR void setMaxSize(const size_t maxSize) noexcept {
+            _maxSize = maxSize;
+        }
+    };
+}
+
+/**
+ * The size is bounded by `maxSize()`, and additions which would exceed it are rejected as a whole: nothing is added
+ * and the addition returns `false`.
+ */
+struct RejectOnOverflow: vector_deque_detail::Bound {
+    typedef OverflowPolicy Category;
+
+    protected:
+    template <class Deque>
+    VECTOR_DEQUE_CONSTEXPR OverflowDecision overflow(Deque&, const size_t count, const bool) noexcept {
+        _overflowed(count);
+        return OverflowDecision{0, 0};
+    }
+};
+
+/**
+ * The size is bounded by `maxSize()`, and additions which would exceed it evict the oldest elements, those at the
+ * opposite end from where the additions are made, to make room. Of a batch larger than the maximum size, only the last
+ * `maxSize()` elements are kept.
+ */
+struct DropOldestOnOverflow: vector_deque_detail::Bound {
+    typedef OverflowPolicy Category;
+
+    protected:
+    template <class Deque>
+    VECTOR_DEQUE_CONSTEXPR OverflowDecision overflow(Deque& deque, const size_t count, const bool atFront) {
+        const size_t skip = count > maxSize() ? count - maxSize() : 0;
+        const size_t kept = count - skip;
+        const size_t room = maxSize() > deque.size() ? maxSize() - deque.size() : 0;
+        const size_t evicted = kept > room ? kept - room : 0;
+        if (atFront) {
+            deque.skipLast(evicted);
+        } else {
+            deque.skip(evicted);
+        }
+        _overflowed(skip + evicted);
+        return OverflowDecision{skip, kept};
+    }
+};
+
+/**
+ * The size is bounded by `maxSize()`, and the incoming elements which do not fit are dropped: of a batch, the first
+ * ones are added until the deque is full.
+ */
+struct DropNewestOnOverflow: vector_deque_detail::Bound {
+    typedef OverflowPolicy Category;
+
+    protected:
+    template <class Deque>
+    VECTOR_DEQUE_CONSTEXPR OverflowDecision overflow(Deque& deque, const size_t count, const bool) noexcept {
+        const size_t room = maxSize() > deque.size() ? maxSize() - deque.size() : 0;
+        const size_t kept = count < room ? count : room;
+        _overflowed(count - kept);
+        return OverflowDecision{0, kept};
+    }
+};
+
+/**
+ * The size is bounded by `maxSize()`, and additions which would exceed it first call the overflow callback with the
+ * number of elements too many. The callback may make room, such as by draining the deque elsewhere; if it made enough
+ * the addition goes ahead, and otherwise it is rejected as a whole as by `RejectOnOverflow`.
+ */
+struct CallbackOnOverflow: vector_deque_detail::Bound {
+    private:
+    std::function<void(size_t)> _overflowCallback;
+
+    protected:
+    template <class Deque>
+    OverflowDecision overflow(Deque& deque, const size_t count, const bool) {
+        if (_overflowCallback) {
+            _overflowCallback(deque.size() + count - maxSize());
+        }
+        if (deque.size() + count <= maxSize()) {
+            _overflowed(0);
+            return OverflowDecision{0, count};
+        }
+        _overflowed(count);
+        return OverflowDecision{0, 0};
+    }
+
+    public:
+    typedef OverflowPolicy Category;
+
+    /**
+     * Set the function called with the number of elements too many when an addition would exceed the maximum size.
+     * Runtime: `O(1)`
+     * @param callback The callback, or an empty function for none.
+     */
+    void setOverflowCallback(std::function<void(size_t)> callback) {
+        _overflowCallback = std::move(callback);
+    }
+};
+
+namespace vector_deque_detail {
+    // Converts an observer to the deque it belongs to. Deques inherit their observers privately and befriend this
+    // class, so observers can reach their deque without their hooks becoming part of its interface.
+    struct ObserverAccess {
+        template <class Deque, class Observer>
+        static VECTOR_DEQUE_CONSTEXPR const Deque& deque(const Observer& observer) noexcept {
+            return static_cast<const Deque&>(observer);
+        }
+    };
+}
+
+/**
+ * Base class for the `Observer` template of observer policies, providing a no-op for every notification so that
+ * observers only need to define the ones they care about. Each notification is given the deque after the modification
+ * has been made. Notifications are protected, so that only the deque can send them.
+ * @param Deque The type of the observed deque.
+ */
+template <class Deque>
+class VectorDequeObserver {
+    protected:
+    // The element at `index` was accessed through `operator []` (or an iterator). Since access does not modify the
+    // deque, this is called on a constant observer.
+    VECTOR_DEQUE_CONSTEXPR void onAccess(const Deque&, const size_t) const noexcept {}
+
+    // `count` elements were added to the back.
+    VECTOR_DEQUE_CONSTEXPR void onAdd(const Deque&, const size_t) noexcept {}
+
+    // `count` elements were added to the front.
+    VECTOR_DEQUE_CONSTEXPR void onAddFirst(const Deque&, const size_t) noexcept {}
+
+    // The contents were replaced wholesale, such as by assignment, `fill` or `nthElement`.
+    VECTOR_DEQUE_CONSTEXPR void onAssign(const Deque&) noexcept {}
+
+    // An element was inserted at `index`.
+    VECTOR_DEQUE_CONSTEXPR void onInsert(const Deque&, const size_t) noexcept {}
+
+    // `count` elements were removed from the front.
+    VECTOR_DEQUE_CONSTEXPR void onRemove(const Deque&, const size_t) noexcept {}
+
+    // The element at `index` was removed.
+    VECTOR_DEQUE_CONSTEXPR void onRemoveAt(const Deque&, const size_t) noexcept {}
+
+    // `count` elements were removed from the back.
+    VECTOR_DEQUE_CONSTEXPR void onRemoveLast(const Deque&, const size_t) noexcept {}
+
+    // The backing array was replaced by one of a different capacity.
+    VECTOR_DEQUE_CONSTEXPR void onResize(const Deque&, const size_t) noexcept {}
+
+    // The element at `index` was replaced through `set`. Writes through references are not observed.
+    VECTOR_DEQUE_CONSTEXPR void onSet(const Deque&, const size_t) noexcept {}
+};
+
+/**
+ * Counters collected by `CollectStatistics`.
+ */
+struct VectorDequeStatistics {
+    // Total number of elements added to either end or inserted.
+    size_t numAdded;
+
+    // Total number of elements removed from either end or the middle.
+    size_t numRemoved;
+
+    // Number of times the backing array has been replaced.
+    size_t numResizes;
+
+    // Largest size reached.
+    size_t maxSize;
+};
+
+/**
+ * Observer which counts additions, removals and resizes, available through `statistics()`.
+ */
+struct CollectStatistics {
+    typedef ObserverPolicy Category;
+
+    template <class Deque>
+    class Observer: public VectorDequeObserver<Deque> {
+        private:
+        VectorDequeStatistics _statistics = VectorDequeStatistics();
+
+        VECTOR_DEQUE_CONSTEXPR void _added(const Deque& deque, const size_t count) noexcept {
+            _statistics.numAdded += count;
+            if (deque.size() > _statistics.maxSize) {
+                _statistics.maxSize = deque.size();
+            }
+        }
+
+        protected:
+        VECTOR_DEQUE_CONSTEXPR void onAdd(const Deque& deque, const size_t count) noexcept {
+            _added(deque, count);
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void onAddFirst(const Deque& deque, const size_t count) noexcept {
+            _added(deque, count);
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void onInsert(const Deque& deque, const size_t) noexcept {
+            _added(deque, 1);
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void onRemove(const Deque&, const size_t count) noexcept {
+            _statistics.numRemoved += count;
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void onRemoveAt(const Deque&, const size_t) noexcept {
+            ++_statistics.numRemoved;
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void onRemoveLast(const Deque&, const size_t count) noexcept {
+            _statistics.numRemoved += count;
+        }
+
+        VECTOR_DEQUE_CONSTEXPR void onResize(const Deque&, const size_t) noexcept {
+            ++_statistics.numResizes;
+        }
+
+        public:
+        /**
+         * Get the statistics collected so far.
+         * Runtime: `O(1)`
+         * @return The statistics.
+         */
+        VECTOR_DEQUE_CONSTEXPR const VectorDequeStatistics& statistics() const noexcept {
+            return _statistics;
+        }
+    };
+};
+
+namespace vector_deque_detail {
+    // Select the policy of `Category` among `Policies`, or `Default` if there is none.
+    template <class Category, class Default, class... Policies>
+    struct SelectPolicy {
+        typedef Default Type;
+    };
+
+    template <class Category, class Default, class First, class... Rest>
+    struct SelectPolicy<Category, Default, First, Rest...> {
+        typedef typename std::conditional<std::is_same<typename First::Category, Category>::value, First,
+                typename SelectPolicy<Category, Default, Rest...>::Type>::type Type;
+    };
+
+    // Count the policies of `Category` among `Policies`.
+    template <class Category, class... Policies>
+    struct CountPolicies: std::integral_constant<size_t, 0> {};
+
+    template <class Category, class First, class... Rest>
+    struct CountPolicies<Category, First, Rest...>: std::integral_constant<size_t,
+            std::is_same<typename First::Category, Category>::value + CountPolicies<Category, Rest...>::value> {};
+
+    // The observers among the policies of a `BasicVectorDeque`.
+    template <class... Policies>
+    struct ObserverPolicies {
+        // Forwards each notification to the observer of every policy in `Policies`, which `Deque` inherits privately.
+        // With no observers, the arguments go unused.
+        template <class Deque>
+        class ObserverSet: public Policies::template Observer<Deque>... {
+            protected:
+            VECTOR_DEQUE_CONSTEXPR void notifyAccess(const Deque& deque, const size_t index) const {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onAccess(deque, index), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) index;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifyAdd(const Deque& deque, const size_t count) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onAdd(deque, count), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) count;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifyAddFirst(const Deque& deque, const size_t count) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onAddFirst(deque, count), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) count;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifyAssign(const Deque& deque) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onAssign(deque), 0)...};
+                (void) expand;
+                (void) deque;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifyInsert(const Deque& deque, const size_t index) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onInsert(deque, index), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) index;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifyRemove(const Deque& deque, const size_t count) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onRemove(deque, count), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) count;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifyRemoveAt(const Deque& deque, const size_t index) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onRemoveAt(deque, index), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) index;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifyRemoveLast(const Deque& deque, const size_t count) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onRemoveLast(deque, count), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) count;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifyResize(const Deque& deque, const size_t oldCapacity) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onResize(deque, oldCapacity), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) oldCapacity;
+            }
+
+            VECTOR_DEQUE_CONSTEXPR void notifySet(const Deque& deque, const size_t index) {
+                const int expand[] = {0, (Policies::template Observer<Deque>::onSet(deque, index), 0)...};
+                (void) expand;
+                (void) deque;
+                (void) index;
+            }
+        };
+    };
+
+    // Collect the observers among `Policies` into `Found`.
+    template <class Found, class... Policies>
+    struct CollectObservers {
+        typedef Found Type;
+    };
+
+    template <class... Found, class First, class... Rest>
+    struct CollectObservers<ObserverPolicies<Found...>, First, Rest...> {
+        typedef typename std::conditional<std::is_same<typename First::Category, ObserverPolicy>::value,
+                typename CollectObservers<ObserverPolicies<Found..., First>, Rest...>::Type,
+                typename CollectObservers<ObserverPolicies<Found...>, Rest...>::Type>::type Type;
+    };
+
+    // Resolves the policies of a `BasicVectorDeque`.
+    template <class DataType, class... Policies>
+    struct ResolvePolicies {
+        static_assert(CountPolicies<BoundsCheckingPolicy, Policies...>::value <= 1,
+                "At most one bounds checking policy may be given");
+        static_assert(CountPolicies<GrowthPolicy, Policies...>::value <= 1, "At most one growth policy may be given");
+        static_assert(CountPolicies<WrappingPolicy, Policies...>::value <= 1,
+                "At most one wrapping policy may be given");
+        static_assert(CountPolicies<StoragePolicy, Policies...>::value <= 1, "At most one storage policy may be given");
+        static_assert(CountPolicies<OverflowPolicy, Policies...>::value <= 1,
+                "At most one overflow policy may be given");
+        static_assert(CountPolicies<IndexPolicy, Policies...>::value <= 1, "At most one index policy may be given");
+        static_assert(CountPolicies<BoundsCheckingPolicy, Policies...>::value
+                + CountPolicies<GrowthPolicy, Policies...>::value + CountPolicies<WrappingPolicy, Policies...>::value
+                + CountPolicies<StoragePolicy, Policies...>::value + CountPolicies<OverflowPolicy, Policies...>::value
+                + CountPolicies<IndexPolicy, Policies...>::value + CountPolicies<ObserverPolicy, Policies...>::value
+                == sizeof...(Policies), "Unknown policy category");
+
+        typedef typename SelectPolicy<BoundsCheckingPolicy, ThrowOnOutOfBounds, Policies...>::Type BoundsChecking;
+        typedef typename SelectPolicy<GrowthPolicy, DoublingGrowth, Policies...>::Type Growth;
+        typedef typename SelectPolicy<WrappingPolicy, BranchWrapping, Policies...>::Type Wrapping;
+        typedef typename SelectPolicy<StoragePolicy, HeapStorage, Policies...>::Type::template Storage<DataType>
+                Storage;
+        typedef typename SelectPolicy<OverflowPolicy, Unbounded, Policies...>::Type Overflow;
+        typedef typename SelectPolicy<IndexPolicy, Indices<size_t>, Policies...>::Type::Index Index;
+        typedef typename CollectObservers<ObserverPolicies<>, Policies...>::Type Observers;
+
+        static_assert(!Wrapping::REQUIRES_POWER_OF_TWO
+                || (Storage::INLINE_CAPACITY & (Storage::INLINE_CAPACITY - 1)) == 0,
+                "Mask wrapping requires a power of two inline capacity");
+        static_assert(Storage::INLINE_CAPACITY <= std::numeric_limits<Index>::max(),
+                "The inline capacity does not fit in the index type");
+    };
+}
+
+#endif
@@ -0,0 +1,335 @@
+#ifndef VECTOR_DEQUE_RESIDENCY_HPP
+#define VECTOR_DEQUE_RESIDENCY_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "VectorDeque.hpp"
+#include "VectorDequePolicies.hpp"
+
+/**
+ * Histogram of non-negative integers with buckets of bounded relative width: each power of two is split into
+ * `2^SUB_BUCKET_BITS` equal buckets, so a value is known to within 12.5% from its bucket, and values below
+ * `2^SUB_BUCKET_BITS` are counted exactly. All of `uint64_t` is covered by `NUM_BUCKETS` buckets, so recording is
+ * `O(1)` and never allocates.
+ */
+class LogLinearHistogram {
+    public:
+    /**
+     * Base 2 logarithm of the number of buckets each power of two is split into.
+     */
+    static const unsigned SUB_BUCKET_BITS = 3;
+
+    /**
+     * Total number of buckets.
+     */
+    static const size_t NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+    private:
+    static const uint64_t SUB_BUCKETS = static_cast<uint64_t>(1) << SUB_BUCKET_BITS;
+
+    uint64_t _counts[NUM_BUCKETS];
+
+    // Number of values recorded.
+    uint64_t _count;
+
+    // Smallest and largest values recorded, if any.
+    uint64_t _min;
+    uint64_t _max;
+
+    // Sum of the values recorded, for the mean. May wrap around for very large totals.
+    uint64_t _sum;
+
+    // Index of the highest set bit of `value`, which must not be zero.
+    static unsigned _highestBit(const uint64_t value) noexcept {
+#if defined(__GNUC__)
+        return 63 - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        for (uint64_t rest = value >> 1; rest != 0; rest >>= 1) {
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+    static void _checkBucket(const size_t bucket) {
+        if (bucket >= NUM_BUCKETS) {
+            throw std::out_of_range("Histogram bucket " + std::to_string(bucket) + " does not exist");
+        }
+    }
+
+    public:
+    /**
+     * Constructs an empty histogram.
+     * Runtime: `O(NUM_BUCKETS)`
+     */
+    LogLinearHistogram() noexcept: _counts(), _count(0), _min(0), _max(0), _sum(0) {}
+
+    /**
+     * Get the index of the bucket `value` is counted in.
+     * Runtime: `O(1)`
+     * @param value The value.
+     * @return The index of its bucket.
+     */
+    static size_t bucketOf(const uint64_t value) noexcept {
+        if (value < SUB_BUCKETS) {
+            return static_cast<size_t>(value);
+        }
+        const unsigned shift = _highestBit(value) - SUB_BUCKET_BITS;
+        return static_cast<size_t>(((shift + 1) << SUB_BUCKET_BITS) + ((value >> shift) - SUB_BUCKETS));
+    }
+
+    /**
+     * Remove every value recorded.
+     * Runtime: `O(NUM_BUCKETS)`
+     */
+    void clear() noexcept {
+        *this = LogLinearHistogram();
+    }
+
+    /**
+     * Returns the number of values recorded.
+     * Runtime: `O(1)`
+     * @return The number of values recorded.
+     */
+    uint64_t count() const noexcept {
+        return _count;
+    }
+
+    /**
+     * Returns the number of values recorded in `bucket`.
+     * Runtime: `O(1)`
+     * @param bucket Index of the bucket.
+     * @return The number of values in it.
+     * @throws std::out_of_range If `bucket >= NUM_BUCKETS`.
+     */
+    uint64_t countAt(const size_t bucket) const {
+        _checkBucket(bucket);
+        return _counts[bucket];
+    }
+
+    /**
+     * Returns the smallest value counted in `bucket`.
+     * Runtime: `O(1)`
+     * @param bucket Index of the bucket.
+     * @return The smallest value of the bucket.
+     * @throws std::out_of_range If `bucket >= NUM_BUCKETS`.
+     */
+    static uint64_t lowerBound(const size_t bucket) {
+        _checkBucket(bucket);
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+        const unsigned shift = static_cast<unsigned>(bucket >> SUB_BUCKET_BITS) - 1;
+        return (SUB_BUCKETS + (bucket & (SUB_BUCKETS - 1))) << shift;
+    }
+
+    /**
+     * Returns the largest value recorded, or `0` if none was.
+     * Runtime: `O(1)`
+     * @return The largest value.
+     */
+    uint64_t max() const noexcept {
+        return _max;
+    }
+
+    /**
+     * Returns the mean of the values recorded, or `0` if none was.
+     * Runtime: `O(1)`
+     * @return The mean.
+     */
+    double mean() const noexcept {
+        return _count == 0 ? 0 : static_cast<double>(_sum) / static_cast<double>(_count);
+    }
+
+    /**
+     * Add the values recorded in `that` to this.
+     * Runtime: `O(NUM_BUCKETS)`
+     * @param that The histogram to add.
+     */
+    void merge(const LogLinearHistogram& that) noexcept {
+        if (that._count == 0) {
+            return;
+        }
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            _counts[i] += that._counts[i];
+        }
+        _min = _count == 0 || that._min < _min ? that._min : _min;
+        _max = that._max > _max ? that._max : _max;
+        _count += that._count;
+        _sum += that._sum;
+    }
+
+    /**
+     * Returns the smallest value recorded, or `0` if none was.
+     * Runtime: `O(1)`
+     * @return The smallest value.
+     */
+    uint64_t min() const noexcept {
+        return _min;
+    }
+
+    /**
+     * Estimate the value below which `fraction` of the recorded values are, as the largest value of the bucket it
+     * falls in (but no more than `max()`).
+     * Runtime: `O(NUM_BUCKETS)`
+     * @param fraction The fraction, from 0 to 1, such as `0.99` for the 99th percentile.
+     * @return The estimate, or `0` if no value was recorded.
+     * @throws std::invalid_argument If `fraction` is not between 0 and 1.
+     */
+    uint64_t quantile(const double fraction) const {
+        if (!(fraction >= 0 && fraction <= 1)) {
+            throw std::invalid_argument("Quantile fraction must be between 0 and 1");
+        }
+        if (_count == 0) {
+            return 0;
+        }
+        // The rank of the value, from 1 to `_count`.
+        uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(_count) + 0.5);
+        rank = rank == 0 ? 1 : rank > _count ? _count : rank;
+        uint64_t seen = 0;
+        for (size_t i = 0; i < NUM_BUCKETS; ++i) {
+            seen += _counts[i];
+            if (seen >= rank) {
+                const uint64_t upper = upperBound(i);
+                return upper < _max ? upper : _max;
+            }
+        }
+        return _max;
+    }
+
+    /**
+     * Count `value`.
+     * Runtime: `O(1)`
+     * @param value The value to count.
+     */
+    void record(const uint64_t value) noexcept {
+        ++_counts[bucketOf(value)];
+        _min = _count == 0 || value < _min ? value : _min;
+        _max = value > _max ? value : _max;
+        ++_count;
+        _sum += value;
+    }
+
+    /**
+     * Returns the largest value counted in `bucket`.
+     * Runtime: `O(1)`
+     * @param bucket Index of the bucket.
+     * @return The largest value of the bucket.
+     * @throws std::out_of_range If `bucket >= NUM_BUCKETS`.
+     */
+    static uint64_t upperBound(const size_t bucket) {
+        if (bucket + 1 == NUM_BUCKETS) {
+            return ~static_cast<uint64_t>(0);
+        }
+        return lowerBound(bucket + 1) - 1;
+    }
+};
+
+/**
+ * Observer policy which measures how long elements stay in the deque. Each element is stamped with the time it was
+ * added in a ring of timestamps kept in the same order as the elements, so `DataType` is unchanged, and the time it
+ * spent in the deque is recorded in nanoseconds into the `residencyHistogram()` of the observer when it is removed (by
+ * `pop`, `popLast`, `popSome`, `skip`, `removeAt`, `clear` and so on).
+ * Timestamps follow positions rather than elements, so reordering elements through iterators or `operator []` is not
+ * tracked. Deques without this policy pay nothing for it.
+ * @param Clock The clock to read the time from, such as `std::chrono::steady_clock`.
+ */
+template <class Clock>
+struct BasicTrackResidency {
+    typedef ObserverPolicy Category;
+
+    template <class Deque>
+    class Observer: public VectorDequeObserver<Deque> {
+        private:
+        // Times the elements were added, in the same order as the elements.
+        VectorDeque<int64_t> _stamps;
+
+        LogLinearHistogram _residencyHistogram;
+
+        static int64_t _now() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+        }
+
+        void _record(const int64_t now, const int64_t stamp) noexcept {
+            _residencyHistogram.record(now > stamp ? static_cast<uint64_t>(now - stamp) : 0);
+        }
+
+        protected:
+        void onAdd(const Deque&, const size_t count) {
+            const int64_t now = _now();
+            for (size_t i = 0; i < count; ++i) {
+                _stamps.add(now);
+            }
+        }
+
+        void onAddFirst(const Deque&, const size_t count) {
+            const int64_t now = _now();
+            for (size_t i = 0; i < count; ++i) {
+                _stamps.addFirst(now);
+            }
+        }
+
+        void onAssign(const Deque& deque) {
+            _stamps.clear();
+            onAdd(deque, deque.size());
+        }
+
+        void onInsert(const Deque&, const size_t index) {
+            if (index <= _stamps.size()) {
+                _stamps.insert(_now(), index);
+            }
+        }
+
+        void onRemove(const Deque&, size_t count) noexcept {
+            const int64_t now = _now();
+            count = count < _stamps.size() ? count : _stamps.size();
+            for (size_t i = 0; i < count; ++i) {
+                _record(now, _stamps.pop());
+            }
+        }
+
+        void onRemoveAt(const Deque&, const size_t index) {
+            if (index < _stamps.size()) {
+                _record(_now(), _stamps.removeAt(index));
+            }
+        }
+
+        void onRemoveLast(const Deque&, size_t count) noexcept {
+            const int64_t now = _now();
+            count = count < _stamps.size() ? count : _stamps.size();
+            for (size_t i = 0; i < count; ++i) {
+                _record(now, _stamps.popLast());
+            }
+        }
+
+        public:
+        /**
+         * Forget the residency times recorded so far. Elements still in the deque keep their timestamps.
+         * Runtime: `O(LogLinearHistogram::NUM_BUCKETS)`
+         */
+        void resetResidencyHistogram() noexcept {
+            _residencyHistogram.clear();
+        }
+
+        /**
+         * Get the histogram of the time removed elements spent in the deque, in nanoseconds.
+         * Runtime: `O(1)`
+         * @return The histogram.
+         */
+        const LogLinearHistogram& residencyHistogram() const noexcept {
+            return _residencyHistogram;
+        }
+    };
+};
+
+/**
+ * `BasicTrackResidency` using `std::chrono::steady_clock`.
+ */
+typedef BasicTrackResidency<std::chrono::steady_clock> TrackResidency;
+
+#endif
@@ -0,0 +1,274 @@
+#ifndef VECTOR_DEQUE_TRACE_HPP
+#define VECTOR_DEQUE_TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "VectorDequePolicies.hpp"
+
+/*
+ * Capture and replay of the operations made on a `VectorDeque`.
+ *
+ * A trace file starts with the 4 magic bytes `VDQT` and a version byte, followed by one record per operation: a
+ * `TraceOperation` byte followed by its argument, an index or a count depending on the operation, encoded as an
+ * unsigned LEB128 varint. Most records are therefore 2 bytes long. Element values are not recorded: a trace captures
+ * the shape of a workload (which operations, where and how many), which is what determines its performance.
+ */
+
+/**
+ * The operations recorded in a trace, with the meaning of their argument.
+ */
+enum TraceOperation {
+    // `operator []` at the argument (an index).
+    TRACE_ACCESS = 0,
+    // Elements added to the back (a count).
+    TRACE_ADD = 1,
+    // Elements added to the front (a count).
+    TRACE_ADD_FIRST = 2,
+    // The contents were replaced by assignment (the new size).
+    TRACE_ASSIGN = 3,
+    // An element inserted at the argument (an index).
+    TRACE_INSERT = 4,
+    // Elements removed from the front (a count). Also recorded by `clear`.
+    TRACE_REMOVE = 5,
+    // The element at the argument removed (an index).
+    TRACE_REMOVE_AT = 6,
+    // Elements removed from the back (a count).
+    TRACE_REMOVE_LAST = 7
+};
+
+/**
+ * A single record of a trace.
+ */
+struct TraceRecord {
+    TraceOperation operation;
+
+    // The index or count, depending on `operation`.
+    uint64_t argument;
+};
+
+/**
+ * Writes trace records to a file.
+ */
+class TraceWriter {
+    private:
+    static const uint8_t VERSION = 1;
+
+    std::ofstream _stream;
+
+    // Number of records written.
+    uint64_t _numRecords;
+
+    public:
+    /**
+     * Opens `path` for writing (truncating it) and writes the trace header.
+     * Runtime: `O(1)`
+     * @param path Path of the trace file.
+     * @throws std::runtime_error If the file cannot be opened.
+     */
+    explicit TraceWriter(const std::string& path): _stream(path.c_str(), std::ios::binary | std::ios::trunc),
+            _numRecords(0) {
+        if (!_stream) {
+            throw std::runtime_error("Cannot open trace file " + path);
+        }
+        _stream.write("VDQT", 4);
+        _stream.put(static_cast<char>(VERSION));
+    }
+
+    /**
+     * Flush all records written so far to the file.
+     * Runtime: `O(number of buffered records)`
+     */
+    void flush() {
+        _stream.flush();
+    }
+
+    /**
+     * Returns the number of records written.
+     * Runtime: `O(1)`
+     * @return The number of records written.
+     */
+    uint64_t numRecords() const noexcept {
+        return _numRecords;
+    }
+
+    /**
+     * Append a record.
+     * Runtime: `O(1)`
+     * @param operation The operation.
+     * @param argument Its index or count.
+     */
+    void write(const TraceOperation operation, uint64_t argument) {
+        char bytes[11];
+        size_t length = 0;
+        bytes[length++] = static_cast<char>(operation);
+        while (argument >= 0x80) {
+            bytes[length++] = static_cast<char>((argument & 0x7F) | 0x80);
+            argument >>= 7;
+        }
+        bytes[length++] = static_cast<char>(argument);
+        _stream.write(bytes, static_cast<std::streamsize>(length));
+        ++_numRecords;
+    }
+
+    /**
+     * Returns the version of the trace format written.
+     * Runtime: `O(1)`
+     * @return The version.
+     */
+    static uint8_t version() noexcept {
+        return VERSION;
+    }
+};
+
+/**
+ * Reads the records of a trace file in order.
+ */
+class TraceReader {
+    private:
+    std::ifstream _stream;
+
+    public:
+    /**
+     * Opens `path` and checks the trace header.
+     * Runtime: `O(1)`
+     * @param path Path of the trace file.
+     * @throws std::runtime_error If the file cannot be opened or is not a trace of a supported version.
+     */
+    explicit TraceReader(const std::string& path): _stream(path.c_str(), std::ios::binary) {
+        char header[5];
+        if (!_stream.read(header, 5) || std::string(header, 4) != "VDQT") {
+            throw std::runtime_error(path + " is not a VectorDeque trace");
+        }
+        if (static_cast<uint8_t>(header[4]) != TraceWriter::version()) {
+            throw std::runtime_error("Unsupported trace version " + std::to_string(static_cast<uint8_t>(header[4])));
+        }
+    }
+
+    /**
+     * Read the next record.
+     * Runtime: `O(1)`
+     * @param record Record to read into.
+     * @return `true` If a record was read, `false` at the end of the trace.
+     * @throws std::runtime_error If the trace is truncated or has an unknown operation.
+     */
+    bool next(TraceRecord& record) {
+        const int operation = _stream.get();
+        if (operation == std::char_traits<char>::eof()) {
+            return false;
+        }
+        if (operation > TRACE_REMOVE_LAST) {
+            throw std::runtime_error("Unknown trace operation " + std::to_string(operation));
+        }
+        record.operation = static_cast<TraceOperation>(operation);
+        record.argument = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            const int byte = _stream.get();
+            if (byte == std::char_traits<char>::eof() || shift > 63) {
+                throw std::runtime_error("Truncated trace record");
+            }
+            record.argument |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+    }
+};
+
+/**
+ * Observer policy which records every operation on the deque to a trace file while tracing is started. Tracing is
+ * off until `startTrace` is called, so a deque with this policy can be deployed and traced on demand; when off, the
+ * only cost is a null check per operation. Copies of a traced deque are not traced.
+ */
+struct TraceOperations {
+    typedef ObserverPolicy Category;
+
+    template <class Deque>
+    class Observer: public VectorDequeObserver<Deque> {
+        private:
+        std::unique_ptr<TraceWriter> _writer;
+
+        void _record(const TraceOperation operation, const size_t argument) const {
+            if (_writer) {
+                _writer->write(operation, argument);
+            }
+        }
+
+        protected:
+        void onAccess(const Deque&, const size_t index) const {
+            _record(TRACE_ACCESS, index);
+        }
+
+        void onAdd(const Deque&, const size_t count) {
+            _record(TRACE_ADD, count);
+        }
+
+        void onAddFirst(const Deque&, const size_t count) {
+            _record(TRACE_ADD_FIRST, count);
+        }
+
+        void onAssign(const Deque& deque) {
+            _record(TRACE_ASSIGN, deque.size());
+        }
+
+        void onInsert(const Deque&, const size_t index) {
+            _record(TRACE_INSERT, index);
+        }
+
+        void onRemove(const Deque&, const size_t count) {
+            _record(TRACE_REMOVE, count);
+        }
+
+        void onRemoveAt(const Deque&, const size_t index) {
+            _record(TRACE_REMOVE_AT, index);
+        }
+
+        void onRemoveLast(const Deque&, const size_t count) {
+            _record(TRACE_REMOVE_LAST, count);
+        }
+
+        public:
+        /**
+         * Checks whether operations are currently being recorded.
+         * Runtime: `O(1)`
+         * @return `true` If tracing is started, `false` otherwise.
+         */
+        bool isTracing() const noexcept {
+            return static_cast<bool>(_writer);
+        }
+
+        /**
+         * Start recording operations to `path`, replacing any trace in progress. Operations are recorded relative to
+         * the contents at this point, so replays should start from a deque of the same size (see `TRACE_ASSIGN`): the
+         * current size of the deque is recorded as an assignment first.
+         * Runtime: `O(1)`
+         * @param path Path of the trace file.
+         * @throws std::runtime_error If the file cannot be opened.
+         */
+        void startTrace(const std::string& path) {
+            _writer.reset(new TraceWriter(path));
+            _record(TRACE_ASSIGN, vector_deque_detail::ObserverAccess::deque<Deque>(*this).size());
+        }
+
+        /**
+         * Stop recording and close the trace file.
+         * Runtime: `O(number of buffered records)`
+         * @return The number of records written, or `0` if tracing was not started.
+         */
+        uint64_t stopTrace() {
+            if (!_writer) {
+                return 0;
+            }
+            _writer->flush();
+            const uint64_t numRecords = _writer->numRecords();
+            _writer.reset();
+            return numRecords;
+        }
+    };
+};
+
+#endif
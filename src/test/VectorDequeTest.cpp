@@ -2,9 +2,45 @@
 #include <cppunit/extensions/TestFactoryRegistry.h>
 #include <cppunit/ui/text/TestRunner.h>
 
+#include "AsyncWriterSinkTest.hpp"
+#include "BasicVectorDequeTest.hpp"
+#include "BlockingVectorDequeTest.hpp"
+#include "BufferPoolTest.hpp"
+#include "CoalescerTest.hpp"
+#include "FingerprintedVectorDequeTest.hpp"
+#include "MpscRingTest.hpp"
+#include "PriorityLanesTest.hpp"
+#include "RollingHashDequeTest.hpp"
+#include "SegmentedAlgorithmsTest.hpp"
+#include "SharedMemoryRingTest.hpp"
+#include "SlidingQuantilesTest.hpp"
+#include "StaticVectorDequeTest.hpp"
+#include "TimingWheelTest.hpp"
+#include "VectorDequeChangeLogTest.hpp"
+#include "VectorDequeOccupancyTest.hpp"
+#include "VectorDequeResidencyTest.hpp"
 #include "VectorDequeTest.hpp"
+#include "VectorDequeTraceTest.hpp"
 
+CPPUNIT_TEST_SUITE_REGISTRATION(AsyncWriterSinkTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(BasicVectorDequeTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(BlockingVectorDequeTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(BufferPoolTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(CoalescerTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(FingerprintedVectorDequeTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(MpscRingTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(PriorityLanesTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(RollingHashDequeTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(SegmentedAlgorithmsTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(SharedMemoryRingTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(SlidingQuantilesTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(StaticVectorDequeTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(TimingWheelTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(VectorDequeChangeLogTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(VectorDequeOccupancyTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(VectorDequeResidencyTest);
 CPPUNIT_TEST_SUITE_REGISTRATION(VectorDequeTest);
+CPPUNIT_TEST_SUITE_REGISTRATION(VectorDequeTraceTest);
 
 int main() {
     CppUnit::TextUi::TestRunner runner;
@@ -0,0 +1,148 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "AsyncWriterSink.hpp"
+
+class AsyncWriterSinkTest: public CppUnit::TestFixture {
+    private:
+        std::string path;
+
+        CPPUNIT_TEST_SUITE(AsyncWriterSinkTest);
+        CPPUNIT_TEST(testAppend);
+        CPPUNIT_TEST(testBadPath);
+        CPPUNIT_TEST(testBlockWhenFull);
+        CPPUNIT_TEST(testClose);
+        CPPUNIT_TEST(testDropWhenFull);
+        CPPUNIT_TEST(testFlushOnSize);
+        CPPUNIT_TEST(testFlushOnTime);
+        CPPUNIT_TEST_SUITE_END();
+
+        std::string contents() {
+            std::ifstream stream(path.c_str(), std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+
+        // Options which only write on `flush` and `close`.
+        static AsyncWriterSinkOptions manualOptions() {
+            AsyncWriterSinkOptions options;
+            options.flushBytes = ~static_cast<size_t>(0);
+            options.flushInterval = std::chrono::milliseconds(0);
+            return options;
+        }
+
+    public:
+        void setUp() {
+            path = "AsyncWriterSinkTest.log";
+            std::remove(path.c_str());
+        }
+
+        void testAppend() {
+            AsyncWriterSink sink(path, 64, manualOptions());
+            CPPUNIT_ASSERT(sink.append("first\n"));
+            CPPUNIT_ASSERT(sink.append(std::string("second\n")));
+            CPPUNIT_ASSERT(contents().empty());
+            sink.flush();
+            CPPUNIT_ASSERT(contents() == "first\nsecond\n");
+            CPPUNIT_ASSERT(sink.numBytesWritten() == 13);
+            CPPUNIT_ASSERT(sink.numWrites() == 1);
+            CPPUNIT_ASSERT_THROW(sink.append(std::string(65, 'x')), std::length_error);
+        }
+
+        void testBadPath() {
+            CPPUNIT_ASSERT_THROW(AsyncWriterSink("nonexistent/file.log", 64), std::system_error);
+        }
+
+        void testBlockWhenFull() {
+            AsyncWriterSinkOptions options;
+            options.flushBytes = 16;
+            options.syncPolicy = SYNC_ON_CLOSE;
+            AsyncWriterSink sink(path, 20, options);
+            std::vector<std::thread> threads;
+            for (int thread = 0; thread < 4; ++thread) {
+                threads.push_back(std::thread([&sink]() {
+                    for (int i = 0; i < 500; ++i) {
+                        sink.append("record\n");
+                    }
+                }));
+            }
+            for (size_t i = 0; i < threads.size(); ++i) {
+                threads[i].join();
+            }
+            sink.close();
+            const std::string written = contents();
+            CPPUNIT_ASSERT(written.size() == 4 * 500 * 7);
+            for (size_t i = 0; i < written.size(); i += 7) {
+                CPPUNIT_ASSERT(written.compare(i, 7, "record\n") == 0);
+            }
+            CPPUNIT_ASSERT(sink.numDropped() == 0);
+        }
+
+        void testClose() {
+            {
+                AsyncWriterSink sink(path, 64, manualOptions());
+                sink.append("a");
+                sink.close();
+                CPPUNIT_ASSERT(contents() == "a");
+                CPPUNIT_ASSERT_THROW(sink.append("b"), std::logic_error);
+                sink.close();
+            }
+            {
+                // Destruction writes what is buffered, and files are appended to.
+                AsyncWriterSink sink(path, 64, manualOptions());
+                sink.append("c");
+            }
+            CPPUNIT_ASSERT(contents() == "ac");
+        }
+
+        void testDropWhenFull() {
+            AsyncWriterSinkOptions options = manualOptions();
+            options.fullPolicy = FULL_DROP;
+            AsyncWriterSink sink(path, 8, options);
+            CPPUNIT_ASSERT(sink.append("abcde"));
+            CPPUNIT_ASSERT(!sink.append("fghi"));
+            CPPUNIT_ASSERT(sink.append("fgh"));
+            CPPUNIT_ASSERT(!sink.append("i"));
+            CPPUNIT_ASSERT(sink.numDropped() == 2);
+            sink.flush();
+            CPPUNIT_ASSERT(sink.append("i"));
+            sink.close();
+            CPPUNIT_ASSERT(contents() == "abcdefghi");
+        }
+
+        void testFlushOnSize() {
+            AsyncWriterSinkOptions options = manualOptions();
+            options.flushBytes = 4;
+            options.syncPolicy = SYNC_EVERY_WRITE;
+            AsyncWriterSink sink(path, 64, options);
+            sink.append("abc");
+            sink.append("def");
+            for (int i = 0; i < 1000 && sink.numBytesWritten() < 6; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            CPPUNIT_ASSERT(contents() == "abcdef");
+        }
+
+        void testFlushOnTime() {
+            AsyncWriterSinkOptions options = manualOptions();
+            options.flushInterval = std::chrono::milliseconds(5);
+            AsyncWriterSink sink(path, 64, options);
+            sink.append("abc");
+            for (int i = 0; i < 1000 && sink.numBytesWritten() < 3; ++i) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            CPPUNIT_ASSERT(contents() == "abc");
+        }
+
+        void tearDown() {
+            std::remove(path.c_str());
+        }
+};
@@ -0,0 +1,383 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "VectorDeque.hpp"
+
+class BasicVectorDequeTest: public CppUnit::TestFixture {
+    private:
+        CPPUNIT_TEST_SUITE(BasicVectorDequeTest);
+        CPPUNIT_TEST(testBoundsChecking);
+        CPPUNIT_TEST(testCallbackOnOverflow);
+        CPPUNIT_TEST(testCompactIndices);
+        CPPUNIT_TEST(testDropNewestOnOverflow);
+        CPPUNIT_TEST(testDropOldestOnOverflow);
+        CPPUNIT_TEST(testFixedCapacity);
+        CPPUNIT_TEST(testGrowth);
+        CPPUNIT_TEST(testInlineStorage);
+        CPPUNIT_TEST(testMaskWrapping);
+        CPPUNIT_TEST(testRejectOnOverflow);
+        CPPUNIT_TEST(testSize);
+        CPPUNIT_TEST(testSmallBufferStorage);
+        CPPUNIT_TEST(testStatistics);
+        CPPUNIT_TEST_SUITE_END();
+
+        // Add and remove enough elements at both ends to wrap around several times, checking the contents throughout.
+        template <class Deque>
+        static void checkWrapping(Deque& deque) {
+            for (int round = 0; round < 5; ++round) {
+                for (int i = 0; i < 6; ++i) {
+                    deque.add(i);
+                    deque.addFirst(-i);
+                }
+                deque.insert(100, 3);
+                CPPUNIT_ASSERT(deque.removeAt(3) == 100);
+                for (int i = 5; i >= 0; --i) {
+                    CPPUNIT_ASSERT(deque.pop() == -i);
+                    CPPUNIT_ASSERT(deque.popLast() == i);
+                }
+                CPPUNIT_ASSERT(deque.isEmpty());
+            }
+        }
+
+    public:
+        void testBoundsChecking() {
+            BasicVectorDeque<int, ThrowOnOutOfBounds> throwing;
+            CPPUNIT_ASSERT_THROW(throwing[0], std::length_error);
+            int target[1];
+            CPPUNIT_ASSERT_THROW(throwing.sliceToArray(target, 0, 1), std::length_error);
+            CPPUNIT_ASSERT_THROW(throwing.sliceToArray(target, 1, 0), std::invalid_argument);
+
+            // In-bounds accesses behave the same without checking.
+            BasicVectorDeque<int, NoBoundsChecking> unchecked;
+            unchecked.add(1);
+            unchecked.addFirst(0);
+            CPPUNIT_ASSERT(unchecked[0] == 0);
+            CPPUNIT_ASSERT(unchecked.pop() == 0);
+            CPPUNIT_ASSERT(unchecked.peek() == 1);
+        }
+
+        void testCallbackOnOverflow() {
+            BasicVectorDeque<int, CallbackOnOverflow> deque;
+            deque.setMaxSize(4);
+            size_t lastExcess = 0;
+            // Make room by draining the excess from the front.
+            deque.setOverflowCallback([&](const size_t excess) {
+                lastExcess = excess;
+                deque.skip(excess);
+            });
+            const int elements[] = {0, 1, 2, 3, 4, 5};
+            CPPUNIT_ASSERT(deque.addAll(elements, 3));
+            CPPUNIT_ASSERT(lastExcess == 0);
+            CPPUNIT_ASSERT(deque.addAll(elements + 3, 3));
+            CPPUNIT_ASSERT(lastExcess == 2);
+            CPPUNIT_ASSERT(deque.size() == 4);
+            CPPUNIT_ASSERT(deque.peek() == 2);
+            CPPUNIT_ASSERT(deque.numOverflows() == 1);
+            CPPUNIT_ASSERT(deque.numDropped() == 0);
+
+            // If the callback does not make enough room, the whole batch is rejected.
+            deque.setOverflowCallback([&](const size_t excess) {
+                lastExcess = excess;
+            });
+            CPPUNIT_ASSERT(!deque.addFirst(-1));
+            CPPUNIT_ASSERT(lastExcess == 1);
+            CPPUNIT_ASSERT(deque.numDropped() == 1);
+            deque.setOverflowCallback(std::function<void(size_t)>());
+            CPPUNIT_ASSERT(!deque.addAll(elements, 2));
+            CPPUNIT_ASSERT(deque.numDropped() == 3);
+            CPPUNIT_ASSERT(deque.size() == 4);
+        }
+
+        void testCompactIndices() {
+            BasicVectorDeque<int, CompactIndices> deque;
+            CPPUNIT_ASSERT(sizeof(deque) == 3 * sizeof(uint32_t) + sizeof(int*)
+                    || sizeof(deque) == 4 * sizeof(uint32_t) + sizeof(int*));
+            CPPUNIT_ASSERT(sizeof(deque) < sizeof(VectorDeque<int>));
+            checkWrapping(deque);
+            for (int i = 0; i < 100; ++i) {
+                deque.add(i);
+            }
+            CPPUNIT_ASSERT(deque.size() == 100);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(deque[i] == i);
+            }
+
+            // Growth stops at the largest capacity the index type can hold.
+            BasicVectorDeque<int, Indices<uint8_t> > small;
+            for (int i = 0; i < 255; ++i) {
+                small.add(i);
+            }
+            CPPUNIT_ASSERT(small.capacity() == 255);
+            CPPUNIT_ASSERT_THROW(small.add(255), std::length_error);
+            CPPUNIT_ASSERT(small.size() == 255);
+            CPPUNIT_ASSERT(small.peekLast() == 254);
+            typedef BasicVectorDeque<int, Indices<uint8_t> > SmallDeque;
+            CPPUNIT_ASSERT_THROW(SmallDeque(256), std::length_error);
+            BasicVectorDeque<int, Indices<uint8_t>, MaskWrapping> masked;
+            for (int i = 0; i < 128; ++i) {
+                masked.addFirst(i);
+            }
+            CPPUNIT_ASSERT(masked.capacity() == 128);
+            CPPUNIT_ASSERT_THROW(masked.addFirst(128), std::length_error);
+            CPPUNIT_ASSERT(masked.peek() == 127);
+        }
+
+        void testDropNewestOnOverflow() {
+            BasicVectorDeque<int, DropNewestOnOverflow> deque;
+            deque.setMaxSize(4);
+            const int elements[] = {0, 1, 2, 3, 4, 5};
+            // Only the elements which fit are added.
+            CPPUNIT_ASSERT(!deque.addAll(elements, 6));
+            CPPUNIT_ASSERT(deque.size() == 4);
+            for (int i = 0; i < 4; ++i) {
+                CPPUNIT_ASSERT(deque[i] == i);
+            }
+            CPPUNIT_ASSERT(deque.numDropped() == 2);
+            CPPUNIT_ASSERT(deque.numOverflows() == 1);
+            CPPUNIT_ASSERT(!deque.add(6));
+            CPPUNIT_ASSERT(!deque.addFirst(6));
+            CPPUNIT_ASSERT(deque.numDropped() == 4);
+
+            // At the front, the first elements of the batch are added, as by sequential `addFirst` calls.
+            deque.skip(2);
+            CPPUNIT_ASSERT(!deque.addAllFirst(elements + 3, 3));
+            CPPUNIT_ASSERT(deque.size() == 4);
+            CPPUNIT_ASSERT(deque[0] == 4);
+            CPPUNIT_ASSERT(deque[1] == 3);
+            CPPUNIT_ASSERT(deque[2] == 2);
+            CPPUNIT_ASSERT(deque.numDropped() == 5);
+            CPPUNIT_ASSERT(deque.numOverflows() == 4);
+        }
+
+        void testDropOldestOnOverflow() {
+            BasicVectorDeque<int, DropOldestOnOverflow> deque;
+            deque.setMaxSize(4);
+            for (int i = 0; i < 6; ++i) {
+                CPPUNIT_ASSERT(deque.add(i));
+            }
+            CPPUNIT_ASSERT(deque.size() == 4);
+            CPPUNIT_ASSERT(deque.peek() == 2);
+            CPPUNIT_ASSERT(deque.numDropped() == 2);
+            CPPUNIT_ASSERT(deque.numOverflows() == 2);
+
+            // A batch evicts once, and of a batch larger than the maximum size only the last elements are kept.
+            const std::vector<int> batch = {10, 11, 12, 13, 14, 15};
+            CPPUNIT_ASSERT(deque.addAll(batch.begin(), batch.begin() + 2));
+            CPPUNIT_ASSERT(deque.peek() == 4);
+            CPPUNIT_ASSERT(deque.numOverflows() == 3);
+            CPPUNIT_ASSERT(!deque.addAll(batch.begin(), batch.end()));
+            CPPUNIT_ASSERT(deque.size() == 4);
+            for (int i = 0; i < 4; ++i) {
+                CPPUNIT_ASSERT(deque[i] == 12 + i);
+            }
+            CPPUNIT_ASSERT(deque.numDropped() == 10);
+
+            // At the front, the oldest elements are at the back.
+            CPPUNIT_ASSERT(deque.addFirst(-1));
+            CPPUNIT_ASSERT(deque.peek() == -1);
+            CPPUNIT_ASSERT(deque.peekLast() == 14);
+            const int elements[] = {0, 1, 2};
+            CPPUNIT_ASSERT(deque.addAllFirst(elements, 3));
+            CPPUNIT_ASSERT(deque[0] == 2);
+            CPPUNIT_ASSERT(deque[3] == -1);
+            CPPUNIT_ASSERT(deque.numDropped() == 14);
+
+            // Insertions and transfers are never dropped.
+            CPPUNIT_ASSERT_THROW(deque.insert(5, 2), std::length_error);
+            VectorDeque<int> source;
+            source.add(7);
+            CPPUNIT_ASSERT_THROW(source.transferTo(deque, 1), std::length_error);
+            CPPUNIT_ASSERT(source.size() == 1);
+            deque.skip();
+            source.transferTo(deque, 1);
+            CPPUNIT_ASSERT(deque.peekLast() == 7);
+        }
+
+        void testFixedCapacity() {
+            BasicVectorDeque<int, FixedCapacity> deque(4);
+            for (int i = 0; i < 4; ++i) {
+                deque.add(i);
+            }
+            CPPUNIT_ASSERT_THROW(deque.add(4), std::length_error);
+            CPPUNIT_ASSERT_THROW(deque.addFirst(4), std::length_error);
+            CPPUNIT_ASSERT_THROW(deque.insert(4, 2), std::length_error);
+            // Failed additions leave the contents untouched.
+            CPPUNIT_ASSERT(deque.size() == 4);
+            for (int i = 0; i < 4; ++i) {
+                CPPUNIT_ASSERT(deque[i] == i);
+            }
+            deque.skip();
+            deque.add(4);
+            CPPUNIT_ASSERT(deque.peekLast() == 4);
+        }
+
+        void testGrowth() {
+            BasicVectorDeque<int, OneAndAHalfGrowth> deque(2);
+            deque.add(0);
+            deque.add(1);
+            deque.add(2);
+            CPPUNIT_ASSERT(deque._capacity == 5);
+            deque.clear();
+            checkWrapping(deque);
+        }
+
+        void testInlineStorage() {
+            BasicVectorDeque<int, InlineStorage<16> > deque;
+            CPPUNIT_ASSERT(deque._capacity == 16);
+            CPPUNIT_ASSERT(sizeof(deque) >= 16 * sizeof(int));
+            checkWrapping(deque);
+            for (int i = 0; i < 16; ++i) {
+                deque.add(i);
+            }
+            CPPUNIT_ASSERT_THROW(deque.add(16), std::length_error);
+            typedef BasicVectorDeque<int, InlineStorage<16> > InlineDeque;
+            CPPUNIT_ASSERT_THROW(InlineDeque(17), std::length_error);
+
+            // Moving copies the elements, since each deque owns its own buffer.
+            InlineDeque moved(std::move(deque));
+            CPPUNIT_ASSERT(moved.size() == 16);
+            CPPUNIT_ASSERT(moved._data != deque._data);
+            for (int i = 0; i < 16; ++i) {
+                CPPUNIT_ASSERT(moved[i] == i);
+            }
+            InlineDeque assigned;
+            assigned = std::move(moved);
+            CPPUNIT_ASSERT(assigned.size() == 16);
+            CPPUNIT_ASSERT(assigned.peekLast() == 15);
+        }
+
+        void testMaskWrapping() {
+            BasicVectorDeque<int, MaskWrapping> deque(5);
+            CPPUNIT_ASSERT(deque._capacity == 8);
+            checkWrapping(deque);
+            for (int i = 0; i < 20; ++i) {
+                deque.addFirst(i);
+            }
+            CPPUNIT_ASSERT((deque._capacity & (deque._capacity - 1)) == 0);
+            for (int i = 0; i < 20; ++i) {
+                CPPUNIT_ASSERT(deque.popLast() == i);
+            }
+
+            // Growth doubles the capacity rather than rounding the growth step up to the next power of two.
+            BasicVectorDeque<int, MaskWrapping> doubling(16);
+            BasicVectorDeque<int, MaskWrapping, OneAndAHalfGrowth> oneAndAHalf(16);
+            for (size_t expected = 32; expected <= 1024; expected *= 2) {
+                while (doubling.size() < doubling._capacity) {
+                    doubling.add(0);
+                    oneAndAHalf.add(0);
+                }
+                doubling.add(0);
+                oneAndAHalf.add(0);
+                CPPUNIT_ASSERT(doubling._capacity == expected);
+                CPPUNIT_ASSERT(oneAndAHalf._capacity == expected);
+            }
+            // Bulk additions grow to the smallest power of two which fits.
+            BasicVectorDeque<int, MaskWrapping> bulk(16);
+            bulk.addAll(doubling.begin(), doubling.begin() + 100);
+            CPPUNIT_ASSERT(bulk._capacity == 128);
+
+            BasicVectorDeque<int, MaskWrapping> copy(deque);
+            CPPUNIT_ASSERT(copy._capacity == 0);
+            copy.addFirst(1);
+            CPPUNIT_ASSERT(copy.peek() == 1);
+        }
+
+        void testRejectOnOverflow() {
+            BasicVectorDeque<int, RejectOnOverflow> deque;
+            CPPUNIT_ASSERT(deque.maxSize() == std::numeric_limits<size_t>::max());
+            deque.setMaxSize(3);
+            const int elements[] = {0, 1, 2, 3};
+            // The whole batch is rejected even though some of it would fit.
+            CPPUNIT_ASSERT(!deque.addAll(elements, 4));
+            CPPUNIT_ASSERT(deque.isEmpty());
+            CPPUNIT_ASSERT(deque.numDropped() == 4);
+            CPPUNIT_ASSERT(deque.addAll(elements, 3));
+            CPPUNIT_ASSERT(!deque.add(3));
+            CPPUNIT_ASSERT(!deque.addFirst(3));
+            CPPUNIT_ASSERT(deque.numDropped() == 6);
+            CPPUNIT_ASSERT(deque.numOverflows() == 3);
+            CPPUNIT_ASSERT(deque.size() == 3);
+            CPPUNIT_ASSERT(deque.peekLast() == 2);
+
+            // Copies keep the maximum size.
+            BasicVectorDeque<int, RejectOnOverflow> copy(deque);
+            CPPUNIT_ASSERT(copy.maxSize() == 3);
+            CPPUNIT_ASSERT(!copy.add(3));
+            BasicVectorDeque<int, RejectOnOverflow> moved(std::move(copy));
+            CPPUNIT_ASSERT(moved.maxSize() == 3);
+            CPPUNIT_ASSERT(moved.numDropped() == 7);
+            // So do assigned deques, like copies.
+            BasicVectorDeque<int, RejectOnOverflow> assigned;
+            assigned = moved;
+            CPPUNIT_ASSERT(assigned.maxSize() == 3);
+            CPPUNIT_ASSERT(assigned.numDropped() == 7);
+            CPPUNIT_ASSERT(assigned.size() == 3);
+            CPPUNIT_ASSERT(!assigned.add(3));
+            CPPUNIT_ASSERT(assigned.size() == 3);
+        }
+
+        void testSize() {
+            // Unused policies must not take up any space.
+            CPPUNIT_ASSERT(sizeof(VectorDeque<int>) == 3 * sizeof(size_t) + sizeof(int*));
+            CPPUNIT_ASSERT(sizeof(BasicVectorDeque<int, NoBoundsChecking, MaskWrapping, OneAndAHalfGrowth>)
+                    == sizeof(VectorDeque<int>));
+            CPPUNIT_ASSERT(sizeof(BasicVectorDeque<int, Unbounded>) == sizeof(VectorDeque<int>));
+        }
+
+        void testSmallBufferStorage() {
+            const int elements[] = {-1, 0, 1, 2, 3};
+            BasicVectorDeque<int, SmallBufferStorage<4> > deque;
+            CPPUNIT_ASSERT(deque._capacity == 4);
+            for (int i = 0; i < 4; ++i) {
+                deque.add(i);
+            }
+            CPPUNIT_ASSERT(deque._capacity == 4);
+            deque.addFirst(-1);
+            CPPUNIT_ASSERT(deque._capacity > 4);
+            deque.clear();
+            checkWrapping(deque);
+            deque.addAll(elements, 5);
+
+            // A deque which has moved to the heap hands its array over when moved.
+            int* const data = deque._data;
+            BasicVectorDeque<int, SmallBufferStorage<4> > moved(std::move(deque));
+            CPPUNIT_ASSERT(moved._data == data);
+            CPPUNIT_ASSERT(moved.size() == 5);
+            CPPUNIT_ASSERT(moved.peek() == -1);
+            CPPUNIT_ASSERT(deque.isEmpty());
+            deque.add(1);
+            CPPUNIT_ASSERT(deque.peek() == 1);
+        }
+
+        void testStatistics() {
+            BasicVectorDeque<int, CollectStatistics> deque(2);
+            deque.add(1);
+            deque.add(2);
+            deque.add(3);
+            deque.addFirst(0);
+            deque.insert(5, 2);
+            const int elements[] = {6, 7};
+            deque.addAll(elements, 2);
+            deque.pop();
+            deque.popLast();
+            deque.removeAt(1);
+            deque.skip(2);
+            const VectorDequeStatistics& statistics = deque.observer<CollectStatistics>().statistics();
+            CPPUNIT_ASSERT(statistics.numAdded == 7);
+            CPPUNIT_ASSERT(statistics.numRemoved == 5);
+            CPPUNIT_ASSERT(statistics.maxSize == 7);
+            CPPUNIT_ASSERT(statistics.numResizes == 1);
+            deque.clear();
+            CPPUNIT_ASSERT(deque.observer<CollectStatistics>().statistics().numRemoved == 7);
+
+            // Statistics follow the contents when moved.
+            BasicVectorDeque<int, CollectStatistics> moved(std::move(deque));
+            CPPUNIT_ASSERT(moved.observer<CollectStatistics>().statistics().numAdded == 7);
+        }
+};
@@ -0,0 +1,86 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "BlockingVectorDeque.hpp"
+
+class BlockingVectorDequeTest: public CppUnit::TestFixture {
+    private:
+        CPPUNIT_TEST_SUITE(BlockingVectorDequeTest);
+        CPPUNIT_TEST(testBatches);
+        CPPUNIT_TEST(testBlocking);
+        CPPUNIT_TEST(testTryAdd);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void testBatches() {
+            const int numProducers = 3;
+            const int numBatches = 2000;
+            BlockingVectorDeque<int> deque(8);
+            CPPUNIT_ASSERT_THROW(deque.addAll(std::vector<int>(9).data(), 9), std::length_error);
+            std::vector<std::thread> producers;
+            for (int producer = 0; producer < numProducers; ++producer) {
+                producers.push_back(std::thread([&deque, producer]() {
+                    for (int i = 0; i < numBatches; ++i) {
+                        const int batch[] = {producer, producer, producer, producer, producer};
+                        deque.addAll(batch, 5);
+                    }
+                }));
+            }
+            // Batches are added at once, so each one arrives unbroken.
+            bool unbroken = true;
+            for (int i = 0; i < numProducers * numBatches; ++i) {
+                const int first = deque.pop();
+                for (int j = 1; j < 5; ++j) {
+                    unbroken = unbroken && deque.pop() == first;
+                }
+            }
+            for (std::thread& thread: producers) {
+                thread.join();
+            }
+            CPPUNIT_ASSERT(unbroken);
+            CPPUNIT_ASSERT(deque.size() == 0);
+        }
+
+        void testBlocking() {
+            BlockingVectorDeque<int> deque(2);
+            deque.add(0);
+            deque.add(1);
+            std::thread producer([&deque]() {
+                for (int i = 2; i < 100; ++i) {
+                    deque.add(i);
+                }
+            });
+            // The deque is full, so the first addition blocks. Wait until it has before making room, so that the test
+            // does not depend on how the threads are scheduled.
+            while (deque.numBlocked() == 0) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(deque.pop() == i);
+            }
+            producer.join();
+            CPPUNIT_ASSERT(deque.numBlocked() > 0);
+            CPPUNIT_ASSERT(deque.numDropped() == 0);
+            int element = -1;
+            CPPUNIT_ASSERT(!deque.tryPop(element));
+            CPPUNIT_ASSERT(element == -1);
+        }
+
+        void testTryAdd() {
+            BlockingVectorDeque<int> deque(2);
+            CPPUNIT_ASSERT(deque.maxSize() == 2);
+            CPPUNIT_ASSERT(deque.tryAdd(0));
+            CPPUNIT_ASSERT(deque.tryAdd(1));
+            CPPUNIT_ASSERT(!deque.tryAdd(2));
+            CPPUNIT_ASSERT(deque.numDropped() == 1);
+            CPPUNIT_ASSERT(deque.numBlocked() == 0);
+            int element = -1;
+            CPPUNIT_ASSERT(deque.tryPop(element));
+            CPPUNIT_ASSERT(element == 0);
+            CPPUNIT_ASSERT(deque.tryAdd(2));
+            CPPUNIT_ASSERT(deque.size() == 2);
+        }
+};
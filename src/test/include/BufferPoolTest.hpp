@@ -0,0 +1,177 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "BufferPool.hpp"
+#include "VectorDeque.hpp"
+
+class BufferPoolTest: public CppUnit::TestFixture {
+    private:
+        struct Counted {
+            static size_t numConstructed;
+
+            int value;
+
+            Counted(): value(7) {
+                ++numConstructed;
+            }
+        };
+
+        template <class DataType>
+        using PooledDeque = BasicVectorDeque<DataType, PooledHeapStorage>;
+
+        CPPUNIT_TEST_SUITE(BufferPoolTest);
+        CPPUNIT_TEST(testAllocate);
+        CPPUNIT_TEST(testMaxCachedBytes);
+        CPPUNIT_TEST(testPooledDeque);
+        CPPUNIT_TEST(testPooledDequeElements);
+        CPPUNIT_TEST(testThreads);
+        CPPUNIT_TEST(testTrim);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void testAllocate() {
+            BufferPool pool;
+            size_t bytes = 100;
+            void* const block = pool.allocate(bytes);
+            CPPUNIT_ASSERT(bytes == 128);
+            CPPUNIT_ASSERT(pool.numMisses() == 1);
+            pool.deallocate(block, 100);
+            CPPUNIT_ASSERT(pool.cachedBytes() == 128);
+            // Any request of the same class reuses the block.
+            bytes = 65;
+            CPPUNIT_ASSERT(pool.allocate(bytes) == block);
+            CPPUNIT_ASSERT(bytes == 128);
+            CPPUNIT_ASSERT(pool.numHits() == 1);
+            CPPUNIT_ASSERT(pool.cachedBytes() == 0);
+            pool.deallocate(block, bytes);
+            // Small requests get the smallest class, and large ones bypass the pool.
+            bytes = 1;
+            void* const small = pool.allocate(bytes);
+            CPPUNIT_ASSERT(bytes == static_cast<size_t>(1) << BufferPool::MIN_CLASS);
+            pool.deallocate(small, bytes);
+            bytes = (static_cast<size_t>(1) << BufferPool::MAX_CLASS) + 1;
+            void* const large = pool.allocate(bytes);
+            CPPUNIT_ASSERT(bytes == (static_cast<size_t>(1) << BufferPool::MAX_CLASS) + 1);
+            pool.deallocate(large, bytes);
+            CPPUNIT_ASSERT(pool.cachedBytes() == 128 + (static_cast<size_t>(1) << BufferPool::MIN_CLASS));
+            pool.deallocate(nullptr, 10);
+        }
+
+        void testMaxCachedBytes() {
+            BufferPool pool(256);
+            CPPUNIT_ASSERT(pool.maxCachedBytes() == 256);
+            size_t bytes = 128;
+            void* const first = pool.allocate(bytes);
+            void* const second = pool.allocate(bytes);
+            void* const third = pool.allocate(bytes);
+            pool.deallocate(first, bytes);
+            pool.deallocate(second, bytes);
+            // Over the cap, so freed to the heap.
+            pool.deallocate(third, bytes);
+            CPPUNIT_ASSERT(pool.cachedBytes() == 256);
+            pool.setMaxCachedBytes(128);
+            CPPUNIT_ASSERT(pool.cachedBytes() == 128);
+        }
+
+        void testPooledDeque() {
+            BufferPool& pool = *BufferPool::local();
+            pool.trim();
+            const uint64_t numHits = pool.numHits();
+            int* data;
+            size_t capacity;
+            {
+                PooledDeque<int> deque(10);
+                // Rounded up to fill the 64 byte block.
+                CPPUNIT_ASSERT(deque.capacity() == 16);
+                for (int i = 0; i < 100; ++i) {
+                    deque.add(i);
+                }
+                CPPUNIT_ASSERT(deque[99] == 99);
+                data = deque.segments().first.data;
+                capacity = deque.capacity();
+            }
+            CPPUNIT_ASSERT(pool.cachedBytes() > 0);
+            // A deque of the same size takes the same block.
+            {
+                PooledDeque<int> deque(capacity);
+                CPPUNIT_ASSERT(deque.segments().first.data == data);
+            }
+            CPPUNIT_ASSERT(pool.numHits() > numHits);
+            // Capacities stay powers of two for mask wrapping.
+            BasicVectorDeque<int, PooledHeapStorage, MaskWrapping> masked(10);
+            CPPUNIT_ASSERT(masked.capacity() == 16);
+            // Elements of sizes which are not powers of two keep the requested capacity.
+            struct Triple {
+                char bytes[3];
+            };
+            PooledDeque<Triple> triples(10);
+            CPPUNIT_ASSERT(triples.capacity() == 10);
+            // A capacity of 0 allocates nothing, and moved-from deques release nothing.
+            PooledDeque<int> empty(0);
+            CPPUNIT_ASSERT(empty.capacity() == 0);
+            empty.add(1);
+            PooledDeque<int> moved(std::move(empty));
+            CPPUNIT_ASSERT(moved.peek() == 1);
+            CPPUNIT_ASSERT(sizeof(PooledDeque<int>) == sizeof(VectorDeque<int>));
+        }
+
+        void testPooledDequeElements() {
+            // Every element of a block is constructed when it is taken, including recycled blocks.
+            Counted::numConstructed = 0;
+            {
+                PooledDeque<Counted> deque(10);
+                CPPUNIT_ASSERT(Counted::numConstructed == deque.capacity());
+                deque.add(Counted());
+            }
+            Counted::numConstructed = 0;
+            PooledDeque<Counted> deque(10);
+            CPPUNIT_ASSERT(Counted::numConstructed == deque.capacity());
+            for (int i = 0; i < 100; ++i) {
+                deque.add(Counted());
+            }
+            CPPUNIT_ASSERT(deque[99].value == 7);
+        }
+
+        void testThreads() {
+            BufferPool* const mainPool = BufferPool::local();
+            BufferPool* threadPool = nullptr;
+            PooledDeque<int>* fromThread = nullptr;
+            std::thread thread([&threadPool, &fromThread]() {
+                threadPool = BufferPool::local();
+                {
+                    PooledDeque<int> deque(1000);
+                }
+                CPPUNIT_ASSERT(threadPool->cachedBytes() == 4096);
+                // Outlives the thread and its pool.
+                fromThread = new PooledDeque<int>(1000);
+                fromThread->add(1);
+            });
+            thread.join();
+            CPPUNIT_ASSERT(threadPool != mainPool);
+            // Returned to this thread's pool.
+            const size_t cachedBytes = mainPool->cachedBytes();
+            delete fromThread;
+            CPPUNIT_ASSERT(mainPool->cachedBytes() == cachedBytes + 4096);
+        }
+
+        void testTrim() {
+            BufferPool pool;
+            size_t small = 64;
+            size_t large = 4096;
+            void* const smallBlock = pool.allocate(small);
+            void* const largeBlock = pool.allocate(large);
+            pool.deallocate(smallBlock, small);
+            pool.deallocate(largeBlock, large);
+            CPPUNIT_ASSERT(pool.cachedBytes() == 4160);
+            // Largest first.
+            pool.trim(100);
+            CPPUNIT_ASSERT(pool.cachedBytes() == 64);
+            pool.trim();
+            CPPUNIT_ASSERT(pool.cachedBytes() == 0);
+        }
+};
+
+size_t BufferPoolTest::Counted::numConstructed = 0;
@@ -0,0 +1,140 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "Coalescer.hpp"
+#include "ManualClock.hpp"
+
+class CoalescerTest: public CppUnit::TestFixture {
+    private:
+        typedef BasicCoalescer<int, ManualClock> IntCoalescer;
+
+        CPPUNIT_TEST_SUITE(CoalescerTest);
+        CPPUNIT_TEST(testAge);
+        CPPUNIT_TEST(testBytes);
+        CPPUNIT_TEST(testCount);
+        CPPUNIT_TEST(testFlush);
+        CPPUNIT_TEST(testSegments);
+        CPPUNIT_TEST_SUITE_END();
+
+        // Batches received by the sink.
+        std::vector<std::vector<int> > batches;
+
+        IntCoalescer::Sink recorder() {
+            return [this](const VectorDequeSegments<int> segments) {
+                std::vector<int> batch(segments.first.begin(), segments.first.end());
+                batch.insert(batch.end(), segments.second.begin(), segments.second.end());
+                batches.push_back(batch);
+            };
+        }
+
+    public:
+        void setUp() {
+            ManualClock::nanoseconds() = 0;
+            batches.clear();
+        }
+
+        void testAge() {
+            IntCoalescer coalescer(CoalescerLimits(0, 0, std::chrono::nanoseconds(100)), recorder());
+            CPPUNIT_ASSERT_THROW(coalescer.deadline(), std::logic_error);
+            ManualClock::nanoseconds() = 10;
+            CPPUNIT_ASSERT(!coalescer.add(1));
+            CPPUNIT_ASSERT(coalescer.deadline().time_since_epoch().count() == 110);
+            ManualClock::nanoseconds() = 109;
+            CPPUNIT_ASSERT(!coalescer.add(2));
+            CPPUNIT_ASSERT(!coalescer.poll());
+            ManualClock::nanoseconds() = 110;
+            CPPUNIT_ASSERT(coalescer.poll());
+            CPPUNIT_ASSERT(!coalescer.poll());
+            CPPUNIT_ASSERT(batches.size() == 1);
+            CPPUNIT_ASSERT(batches[0] == std::vector<int>({1, 2}));
+
+            // An add to an old batch emits it along with the new item.
+            CPPUNIT_ASSERT(!coalescer.add(3));
+            ManualClock::nanoseconds() = 300;
+            CPPUNIT_ASSERT(coalescer.add(4));
+            CPPUNIT_ASSERT(batches.size() == 2);
+            CPPUNIT_ASSERT(batches[1] == std::vector<int>({3, 4}));
+        }
+
+        void testBytes() {
+            BasicCoalescer<std::string, ManualClock> coalescer(CoalescerLimits(0, 10),
+                    [this](const VectorDequeSegments<std::string> segments) {
+                        batches.push_back(std::vector<int>(1, static_cast<int>(segments.first.size()
+                                + segments.second.size())));
+                    },
+                    [](const std::string& item) {
+                        return item.size();
+                    });
+            CPPUNIT_ASSERT(!coalescer.add("abcd"));
+            CPPUNIT_ASSERT(!coalescer.add("efgh"));
+            CPPUNIT_ASSERT(coalescer.bytes() == 8);
+            CPPUNIT_ASSERT(coalescer.add("ij"));
+            CPPUNIT_ASSERT(coalescer.bytes() == 0);
+            CPPUNIT_ASSERT(coalescer.add("a long item"));
+            CPPUNIT_ASSERT(batches == std::vector<std::vector<int> >({{3}, {1}}));
+
+            // Without a size function, items count as their `sizeof`.
+            IntCoalescer ints(CoalescerLimits(0, 3 * sizeof(int)), recorder());
+            CPPUNIT_ASSERT(!ints.add(1));
+            CPPUNIT_ASSERT(!ints.add(2));
+            CPPUNIT_ASSERT(ints.add(3));
+        }
+
+        void testCount() {
+            CPPUNIT_ASSERT_THROW(IntCoalescer(CoalescerLimits(3), IntCoalescer::Sink()), std::invalid_argument);
+            IntCoalescer coalescer(CoalescerLimits(3), recorder());
+            for (int i = 0; i < 10; ++i) {
+                CPPUNIT_ASSERT(coalescer.add(i) == (i % 3 == 2));
+            }
+            CPPUNIT_ASSERT(coalescer.size() == 1);
+            CPPUNIT_ASSERT(coalescer.numBatches() == 3);
+            CPPUNIT_ASSERT(batches.size() == 3);
+            CPPUNIT_ASSERT(batches[2] == std::vector<int>({6, 7, 8}));
+        }
+
+        void testFlush() {
+            IntCoalescer coalescer(CoalescerLimits(100), recorder());
+            CPPUNIT_ASSERT(!coalescer.flush());
+            coalescer.add(1);
+            CPPUNIT_ASSERT(coalescer.flush());
+            CPPUNIT_ASSERT(coalescer.size() == 0);
+            CPPUNIT_ASSERT(batches.size() == 1);
+
+            // If the sink throws, the batch is kept.
+            bool fail = true;
+            IntCoalescer failing(CoalescerLimits(100), [&fail](const VectorDequeSegments<int>) {
+                if (fail) {
+                    throw std::runtime_error("Sink failed");
+                }
+            });
+            failing.add(1);
+            CPPUNIT_ASSERT_THROW(failing.flush(), std::runtime_error);
+            CPPUNIT_ASSERT(failing.size() == 1);
+            fail = false;
+            CPPUNIT_ASSERT(failing.flush());
+            CPPUNIT_ASSERT(failing.numBatches() == 1);
+        }
+
+        void testSegments() {
+            // Each batch starts at the beginning of the emptied deque, so it is handed over as a single segment
+            // without being copied.
+            const int* previous = NULL;
+            bool contiguous = true;
+            bool sameStorage = true;
+            IntCoalescer coalescer(CoalescerLimits(4), [&](const VectorDequeSegments<int> segments) {
+                contiguous = contiguous && segments.second.size() == 0 && segments.first.size() == 4;
+                sameStorage = sameStorage && (previous == NULL || previous == segments.first.data);
+                previous = segments.first.data;
+            });
+            for (int i = 0; i < 40; ++i) {
+                coalescer.add(i);
+            }
+            CPPUNIT_ASSERT(contiguous);
+            CPPUNIT_ASSERT(sameStorage);
+            CPPUNIT_ASSERT(coalescer.numBatches() == 10);
+        }
+};
@@ -0,0 +1,122 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "FingerprintedVectorDeque.hpp"
+#include <string>
+
+class FingerprintedVectorDequeTest: public CppUnit::TestFixture {
+    private:
+        FingerprintedVectorDeque<int>* dequePtr;
+        FingerprintedVectorDeque<int>* deque2Ptr;
+
+        CPPUNIT_TEST_SUITE(FingerprintedVectorDequeTest);
+        CPPUNIT_TEST(testAddAndAddFirst);
+        CPPUNIT_TEST(testAddAll);
+        CPPUNIT_TEST(testClear);
+        CPPUNIT_TEST(testPopAndPopLast);
+        CPPUNIT_TEST(testSkip);
+        CPPUNIT_TEST(testSkipLast);
+        CPPUNIT_TEST(testSlidingWindow);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() {
+            dequePtr = new FingerprintedVectorDeque<int>();
+            deque2Ptr = new FingerprintedVectorDeque<int>();
+        }
+
+        void testAddAndAddFirst() {
+            CPPUNIT_ASSERT(dequePtr->fingerprint() == deque2Ptr->fingerprint());
+            dequePtr->add(2);
+            dequePtr->add(3);
+            dequePtr->addFirst(1);
+            deque2Ptr->add(1);
+            deque2Ptr->add(2);
+            CPPUNIT_ASSERT(dequePtr->fingerprint() != deque2Ptr->fingerprint());
+            deque2Ptr->add(3);
+            CPPUNIT_ASSERT(dequePtr->fingerprint() == deque2Ptr->fingerprint());
+            CPPUNIT_ASSERT(dequePtr->contents() == deque2Ptr->contents());
+        }
+
+        void testAddAll() {
+            const int elements[] = {4, 5, 6};
+            dequePtr->addAll(elements, 3);
+            for (int i = 0; i < 3; ++i) {
+                deque2Ptr->add(elements[i]);
+            }
+            CPPUNIT_ASSERT(dequePtr->size() == 3);
+            CPPUNIT_ASSERT(dequePtr->fingerprint() == deque2Ptr->fingerprint());
+        }
+
+        void testClear() {
+            const uint64_t emptyFingerprint = dequePtr->fingerprint();
+            dequePtr->add(3);
+            dequePtr->clear();
+            CPPUNIT_ASSERT(dequePtr->isEmpty());
+            CPPUNIT_ASSERT(dequePtr->fingerprint() == emptyFingerprint);
+        }
+
+        void testPopAndPopLast() {
+            CPPUNIT_ASSERT_THROW(dequePtr->pop(), std::length_error);
+            CPPUNIT_ASSERT_THROW(dequePtr->popLast(), std::length_error);
+            const uint64_t emptyFingerprint = dequePtr->fingerprint();
+            for (int i = 0; i < 5; ++i) {
+                dequePtr->add(i);
+            }
+            deque2Ptr->add(1);
+            deque2Ptr->add(2);
+            deque2Ptr->add(3);
+            CPPUNIT_ASSERT(dequePtr->pop() == 0);
+            CPPUNIT_ASSERT(dequePtr->popLast() == 4);
+            CPPUNIT_ASSERT(dequePtr->fingerprint() == deque2Ptr->fingerprint());
+            dequePtr->pop();
+            dequePtr->pop();
+            dequePtr->popLast();
+            CPPUNIT_ASSERT(dequePtr->fingerprint() == emptyFingerprint);
+        }
+
+        void testSkip() {
+            for (int i = 0; i < 5; ++i) {
+                dequePtr->add(i);
+            }
+            CPPUNIT_ASSERT_THROW(dequePtr->skip(6), std::length_error);
+            dequePtr->skip(2);
+            deque2Ptr->add(2);
+            deque2Ptr->add(3);
+            deque2Ptr->add(4);
+            CPPUNIT_ASSERT(dequePtr->fingerprint() == deque2Ptr->fingerprint());
+        }
+
+        void testSkipLast() {
+            for (int i = 0; i < 5; ++i) {
+                dequePtr->add(i);
+            }
+            CPPUNIT_ASSERT_THROW(dequePtr->skipLast(6), std::length_error);
+            dequePtr->skipLast(2);
+            deque2Ptr->add(0);
+            deque2Ptr->add(1);
+            deque2Ptr->add(2);
+            CPPUNIT_ASSERT(dequePtr->fingerprint() == deque2Ptr->fingerprint());
+        }
+
+        void testSlidingWindow() {
+            // Slide a window of 4 over 0..99 and compare against a freshly built window at every step.
+            for (int i = 0; i < 100; ++i) {
+                dequePtr->add(i);
+                if (dequePtr->size() > 4) {
+                    dequePtr->pop();
+                }
+                FingerprintedVectorDeque<int> fresh;
+                for (int j = i - static_cast<int>(dequePtr->size()) + 1; j <= i; ++j) {
+                    fresh.add(j);
+                }
+                CPPUNIT_ASSERT(dequePtr->fingerprint() == fresh.fingerprint());
+                CPPUNIT_ASSERT(i == 0 || dequePtr->fingerprint() != deque2Ptr->fingerprint());
+                *deque2Ptr = *dequePtr;
+            }
+        }
+
+        void tearDown() {
+            delete dequePtr;
+            delete deque2Ptr;
+        }
+};
@@ -0,0 +1,25 @@
+#ifndef MANUAL_CLOCK_HPP
+#define MANUAL_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+// Clock whose time is set by the tests.
+struct ManualClock {
+    typedef std::chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef std::chrono::time_point<ManualClock> time_point;
+    static const bool is_steady = true;
+
+    static int64_t& nanoseconds() {
+        static int64_t current = 0;
+        return current;
+    }
+
+    static time_point now() noexcept {
+        return time_point(duration(nanoseconds()));
+    }
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MpscRing.hpp"
+
+class MpscRingTest: public CppUnit::TestFixture {
+    private:
+        CPPUNIT_TEST_SUITE(MpscRingTest);
+        CPPUNIT_TEST(testCapacity);
+        CPPUNIT_TEST(testConcurrentProducers);
+        CPPUNIT_TEST(testDrain);
+        CPPUNIT_TEST(testRelease);
+        CPPUNIT_TEST(testStalledProducer);
+        CPPUNIT_TEST(testTryPush);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void testCapacity() {
+            CPPUNIT_ASSERT(MpscRing<int>(0).capacity() == 2);
+            CPPUNIT_ASSERT(MpscRing<int>(1).capacity() == 2);
+            CPPUNIT_ASSERT(MpscRing<int>(8).capacity() == 8);
+            CPPUNIT_ASSERT(MpscRing<int>(9).capacity() == 16);
+            CPPUNIT_ASSERT_THROW(MpscRing<int>(~static_cast<size_t>(0)), std::length_error);
+        }
+
+        void testConcurrentProducers() {
+            const int numProducers = 4;
+            const int numPerProducer = 20000;
+            MpscRing<int> ring(64);
+            std::vector<std::thread> producers;
+            for (int producer = 0; producer < numProducers; ++producer) {
+                producers.push_back(std::thread([&ring, producer]() {
+                    for (int i = 0; i < numPerProducer; i += 2) {
+                        if (i % 10 == 0) {
+                            const int pair[] = {producer * numPerProducer + i, producer * numPerProducer + i + 1};
+                            ring.pushAll(pair, 2);
+                        } else {
+                            ring.push(producer * numPerProducer + i);
+                            while (!ring.tryPush(producer * numPerProducer + i + 1)) {
+                                std::this_thread::yield();
+                            }
+                        }
+                    }
+                }));
+            }
+            // Each producer's elements must arrive in order, and all of them must arrive.
+            std::vector<int> next(numProducers, 0);
+            int numDrained = 0;
+            bool inOrder = true;
+            while (numDrained < numProducers * numPerProducer) {
+                numDrained += static_cast<int>(ring.drain([&](const int* const data, const size_t length) {
+                    for (size_t i = 0; i < length; ++i) {
+                        const int producer = data[i] / numPerProducer;
+                        inOrder = inOrder && data[i] % numPerProducer == next[producer]++;
+                    }
+                }));
+            }
+            for (size_t i = 0; i < producers.size(); ++i) {
+                producers[i].join();
+            }
+            CPPUNIT_ASSERT(inOrder);
+            CPPUNIT_ASSERT(numDrained == numProducers * numPerProducer);
+            CPPUNIT_ASSERT(ring.committed().first.size() == 0);
+        }
+
+        void testDrain() {
+            MpscRing<std::string> ring(8);
+            const std::string strings[] = {"a", "b", "c", "d", "e", "f"};
+            ring.pushAll(strings, 6);
+            CPPUNIT_ASSERT(ring.drain([](std::string*, size_t) {}) == 6);
+            // The next run wraps around the end of the slots, so it is drained in two segments.
+            ring.pushAll(strings, 5);
+            std::vector<size_t> lengths;
+            std::string drained;
+            CPPUNIT_ASSERT(ring.drain([&](std::string* const data, const size_t length) {
+                lengths.push_back(length);
+                for (size_t i = 0; i < length; ++i) {
+                    drained += std::move(data[i]);
+                }
+            }) == 5);
+            CPPUNIT_ASSERT(drained == "abcde");
+            CPPUNIT_ASSERT(lengths.size() == 2);
+            CPPUNIT_ASSERT(lengths[0] == 2);
+            CPPUNIT_ASSERT(lengths[1] == 3);
+            CPPUNIT_ASSERT(ring.drain([](std::string*, size_t) {}) == 0);
+        }
+
+        void testRelease() {
+            MpscRing<int> ring(4);
+            ring.push(1);
+            ring.push(2);
+            CPPUNIT_ASSERT_THROW(ring.release(3), std::invalid_argument);
+            CPPUNIT_ASSERT(ring.committed().first.size() == 2);
+            ring.release(1);
+            const VectorDequeSegments<int> segments = ring.committed();
+            CPPUNIT_ASSERT(segments.first.size() == 1);
+            CPPUNIT_ASSERT(segments.first.data[0] == 2);
+            CPPUNIT_ASSERT(segments.second.size() == 0);
+        }
+
+        void testStalledProducer() {
+            MpscRing<int> ring(8);
+            ring.push(1);
+            // A producer which has reserved its slot but not yet written it.
+            const size_t stalled = ring._tail.fetch_add(1);
+            ring.push(3);
+            ring.push(4);
+            CPPUNIT_ASSERT(ring.drain([](int*, size_t) {}) == 1);
+            CPPUNIT_ASSERT(ring.committed().first.size() == 0);
+            ring._write(stalled, 2);
+            std::vector<int> drained;
+            ring.drain([&](const int* const data, const size_t length) {
+                drained.insert(drained.end(), data, data + length);
+            });
+            CPPUNIT_ASSERT(drained.size() == 3);
+            CPPUNIT_ASSERT(drained[0] == 2);
+            CPPUNIT_ASSERT(drained[2] == 4);
+        }
+
+        void testTryPush() {
+            MpscRing<int> ring(2);
+            CPPUNIT_ASSERT(ring.tryPush(1));
+            CPPUNIT_ASSERT(ring.tryPush(2));
+            CPPUNIT_ASSERT(!ring.tryPush(3));
+            ring.release(1);
+            CPPUNIT_ASSERT(ring.tryPush(3));
+            const VectorDequeSegments<int> segments = ring.committed();
+            CPPUNIT_ASSERT(segments.first.size() == 1);
+            CPPUNIT_ASSERT(segments.first.data[0] == 2);
+            CPPUNIT_ASSERT(segments.second.size() == 1);
+            CPPUNIT_ASSERT(segments.second.data[0] == 3);
+        }
+};
@@ -0,0 +1,93 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <stdexcept>
+
+#include "PriorityLanes.hpp"
+
+class PriorityLanesTest: public CppUnit::TestFixture {
+    private:
+        CPPUNIT_TEST_SUITE(PriorityLanesTest);
+        CPPUNIT_TEST(testAdd);
+        CPPUNIT_TEST(testClear);
+        CPPUNIT_TEST(testPop);
+        CPPUNIT_TEST(testPopSome);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void testAdd() {
+            PriorityLanes<int, 64> lanes;
+            CPPUNIT_ASSERT(lanes.isEmpty());
+            CPPUNIT_ASSERT_THROW(lanes.highestLane(), std::length_error);
+            CPPUNIT_ASSERT_THROW(lanes.add(0, 64), std::length_error);
+            lanes.add(1, 3);
+            lanes.add(2, 63);
+            const int elements[] = {3, 4, 5};
+            lanes.addAll(elements, 3, 0);
+            lanes.addAll(elements, 0, 10);
+            CPPUNIT_ASSERT(lanes.size() == 5);
+            CPPUNIT_ASSERT(lanes.nonEmptyLanes() == ((static_cast<uint64_t>(1) << 63) | (1 << 3) | 1));
+            CPPUNIT_ASSERT(lanes.highestLane() == 63);
+            CPPUNIT_ASSERT(lanes.lane(0).size() == 3);
+            CPPUNIT_ASSERT(lanes.lane(0).peekLast() == 5);
+            CPPUNIT_ASSERT(lanes.lane(10).isEmpty());
+            CPPUNIT_ASSERT_THROW(lanes.lane(64), std::length_error);
+        }
+
+        void testClear() {
+            PriorityLanes<int, 8> lanes;
+            lanes.add(1, 7);
+            lanes.add(2, 2);
+            lanes.clear();
+            CPPUNIT_ASSERT(lanes.isEmpty());
+            CPPUNIT_ASSERT(lanes.nonEmptyLanes() == 0);
+            lanes.add(3, 1);
+            CPPUNIT_ASSERT(lanes.pop() == 3);
+        }
+
+        void testPop() {
+            PriorityLanes<int, 16> lanes;
+            for (int i = 0; i < 16; ++i) {
+                lanes.add(i, static_cast<size_t>(i % 4));
+            }
+            // Highest lane first, and first in first out within a lane.
+            const int expected[] = {3, 7, 11, 15, 2, 6, 10, 14, 1, 5, 9, 13, 0, 4, 8, 12};
+            for (int i = 0; i < 16; ++i) {
+                CPPUNIT_ASSERT(lanes.peek() == expected[i]);
+                CPPUNIT_ASSERT(lanes.pop() == expected[i]);
+            }
+            CPPUNIT_ASSERT(lanes.isEmpty());
+            CPPUNIT_ASSERT(lanes.nonEmptyLanes() == 0);
+            CPPUNIT_ASSERT_THROW(lanes.pop(), std::length_error);
+            CPPUNIT_ASSERT_THROW(lanes.peek(), std::length_error);
+
+            // A higher lane added to later takes precedence.
+            lanes.add(1, 0);
+            lanes.add(2, 5);
+            CPPUNIT_ASSERT(lanes.pop() == 2);
+            CPPUNIT_ASSERT(lanes.highestLane() == 0);
+        }
+
+        void testPopSome() {
+            PriorityLanes<int, 4> lanes;
+            for (int i = 0; i < 12; ++i) {
+                lanes.add(i, static_cast<size_t>(i % 3));
+            }
+            int target[12];
+            CPPUNIT_ASSERT_THROW(lanes.popSome(target, 13), std::length_error);
+            CPPUNIT_ASSERT(lanes.size() == 12);
+            // Spans lane 2 and part of lane 1.
+            lanes.popSome(target, 6);
+            const int expected[] = {2, 5, 8, 11, 1, 4, 7, 10, 0, 3, 6, 9};
+            for (int i = 0; i < 6; ++i) {
+                CPPUNIT_ASSERT(target[i] == expected[i]);
+            }
+            CPPUNIT_ASSERT(lanes.size() == 6);
+            CPPUNIT_ASSERT(lanes.nonEmptyLanes() == 3);
+            lanes.popSome(target, 6);
+            for (int i = 0; i < 6; ++i) {
+                CPPUNIT_ASSERT(target[i] == expected[6 + i]);
+            }
+            CPPUNIT_ASSERT(lanes.isEmpty());
+            CPPUNIT_ASSERT(lanes.nonEmptyLanes() == 0);
+        }
+};
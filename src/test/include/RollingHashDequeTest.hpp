@@ -0,0 +1,127 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "RollingHashDeque.hpp"
+#include <algorithm>
+#include <vector>
+
+class RollingHashDequeTest: public CppUnit::TestFixture {
+    private:
+        RollingHashDeque* dequePtr;
+        std::vector<uint8_t>* streamPtr;
+
+        CPPUNIT_TEST_SUITE(RollingHashDequeTest);
+        CPPUNIT_TEST(testAdd);
+        CPPUNIT_TEST(testClear);
+        CPPUNIT_TEST(testConstructors);
+        CPPUNIT_TEST(testFeed);
+        CPPUNIT_TEST(testFeedBlockInvariance);
+        CPPUNIT_TEST(testPop);
+        CPPUNIT_TEST_SUITE_END();
+
+        // Hash of the bytes `[from, until)` of the stream, computed from scratch.
+        uint64_t hashOf(const size_t from, const size_t until) {
+            RollingHashDeque fresh(dequePtr->windowSize());
+            for (size_t i = from; i < until; ++i) {
+                fresh.add((*streamPtr)[i]);
+            }
+            return fresh.hash();
+        }
+
+    public:
+        void setUp() {
+            dequePtr = new RollingHashDeque(16, 6, 8, 256);
+            streamPtr = new std::vector<uint8_t>();
+            uint32_t state = 12345;
+            for (int i = 0; i < 20000; ++i) {
+                state = state * 1103515245 + 12345;
+                streamPtr->push_back(static_cast<uint8_t>(state >> 16));
+            }
+        }
+
+        void testAdd() {
+            CPPUNIT_ASSERT(dequePtr->size() == 0);
+            for (size_t i = 0; i < 100; ++i) {
+                dequePtr->add((*streamPtr)[i]);
+                const size_t from = i + 1 > 16 ? i + 1 - 16 : 0;
+                CPPUNIT_ASSERT(dequePtr->size() == i + 1 - from);
+                CPPUNIT_ASSERT(dequePtr->hash() == hashOf(from, i + 1));
+                CPPUNIT_ASSERT(dequePtr->window()[0] == (*streamPtr)[from]);
+            }
+            CPPUNIT_ASSERT(dequePtr->isFull());
+        }
+
+        void testClear() {
+            dequePtr->add(3);
+            dequePtr->clear();
+            CPPUNIT_ASSERT(dequePtr->size() == 0);
+            CPPUNIT_ASSERT(dequePtr->hash() == 0);
+            std::vector<uint64_t> boundaries;
+            dequePtr->feed(&(*streamPtr)[0], streamPtr->size(), boundaries);
+            std::vector<uint64_t> boundariesAfterClear;
+            dequePtr->clear();
+            dequePtr->feed(&(*streamPtr)[0], streamPtr->size(), boundariesAfterClear);
+            CPPUNIT_ASSERT(boundaries == boundariesAfterClear);
+        }
+
+        void testConstructors() {
+            CPPUNIT_ASSERT_THROW(RollingHashDeque(0), std::invalid_argument);
+            CPPUNIT_ASSERT_THROW(RollingHashDeque(16, 64), std::invalid_argument);
+            CPPUNIT_ASSERT_THROW(RollingHashDeque(16, 6, 0, 256), std::invalid_argument);
+            CPPUNIT_ASSERT_THROW(RollingHashDeque(16, 6, 257, 256), std::invalid_argument);
+            RollingHashDeque defaultDeque;
+            CPPUNIT_ASSERT(defaultDeque.windowSize() == 48);
+        }
+
+        void testFeed() {
+            std::vector<uint64_t> boundaries;
+            const size_t numFound = dequePtr->feed(&(*streamPtr)[0], streamPtr->size(), boundaries);
+            CPPUNIT_ASSERT(numFound == boundaries.size());
+            CPPUNIT_ASSERT(numFound > 20000 / 256);
+            CPPUNIT_ASSERT(dequePtr->hash() == hashOf(streamPtr->size() - 16, streamPtr->size()));
+            uint64_t previous = 0;
+            for (size_t i = 0; i < boundaries.size(); ++i) {
+                const uint64_t length = boundaries[i] - previous;
+                CPPUNIT_ASSERT(length >= 8 && length <= 256);
+                if (length < 256) {
+                    // Boundaries short of the maximum are decided by the hash of the window ending at the boundary.
+                    const size_t end = static_cast<size_t>(boundaries[i]);
+                    CPPUNIT_ASSERT((hashOf(end < 16 ? 0 : end - 16, end) & 63) == 0);
+                }
+                previous = boundaries[i];
+            }
+        }
+
+        void testFeedBlockInvariance() {
+            std::vector<uint64_t> expected;
+            dequePtr->feed(&(*streamPtr)[0], streamPtr->size(), expected);
+            const size_t blockSizes[] = {1, 3, 15, 16, 17, 1000};
+            for (size_t b = 0; b < 6; ++b) {
+                RollingHashDeque blockDeque(16, 6, 8, 256);
+                std::vector<uint64_t> boundaries;
+                for (size_t i = 0; i < streamPtr->size(); i += blockSizes[b]) {
+                    const size_t length = std::min(blockSizes[b], streamPtr->size() - i);
+                    blockDeque.feed(&(*streamPtr)[i], length, boundaries);
+                }
+                CPPUNIT_ASSERT(boundaries == expected);
+                CPPUNIT_ASSERT(blockDeque.hash() == dequePtr->hash());
+                CPPUNIT_ASSERT(blockDeque.window() == dequePtr->window());
+            }
+        }
+
+        void testPop() {
+            CPPUNIT_ASSERT_THROW(dequePtr->pop(), std::length_error);
+            for (size_t i = 0; i < 10; ++i) {
+                dequePtr->add((*streamPtr)[i]);
+            }
+            for (size_t i = 0; i < 10; ++i) {
+                CPPUNIT_ASSERT(dequePtr->pop() == (*streamPtr)[i]);
+                CPPUNIT_ASSERT(dequePtr->hash() == hashOf(i + 1, 10));
+            }
+            CPPUNIT_ASSERT(dequePtr->hash() == 0);
+        }
+
+        void tearDown() {
+            delete dequePtr;
+            delete streamPtr;
+        }
+};
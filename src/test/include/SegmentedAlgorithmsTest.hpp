@@ -0,0 +1,377 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+
+#include "SegmentedAlgorithms.hpp"
+#include "VectorDeque.hpp"
+
+class SegmentedAlgorithmsTest: public CppUnit::TestFixture {
+    private:
+        // Contains 0 to 99, wrapped around the end of its backing array.
+        VectorDeque<int>* wrappedPtr;
+
+        CPPUNIT_TEST_SUITE(SegmentedAlgorithmsTest);
+        CPPUNIT_TEST(testCopy);
+        CPPUNIT_TEST(testCopyIf);
+        CPPUNIT_TEST(testExclusiveScan);
+        CPPUNIT_TEST(testFill);
+        CPPUNIT_TEST(testFind);
+        CPPUNIT_TEST(testInclusiveScan);
+        CPPUNIT_TEST(testIsSegmentedIterator);
+        CPPUNIT_TEST(testParallelScan);
+        CPPUNIT_TEST(testPartition);
+        CPPUNIT_TEST(testRemoveIf);
+        CPPUNIT_TEST(testStandardAlgorithms);
+        CPPUNIT_TEST_SUITE_END();
+
+        // Check that scanning a wrapped deque of `DataType` gives the same sums as `std::partial_sum`, both in place
+        // and into an array.
+        template <class DataType>
+        void checkScan() {
+            VectorDeque<DataType> deque(64);
+            for (int i = 0; i < 23; ++i) {
+                deque.addFirst(static_cast<DataType>(22 - i));
+            }
+            for (int i = 23; i < 50; ++i) {
+                deque.add(static_cast<DataType>(i));
+            }
+            std::vector<DataType> expected(50);
+            std::partial_sum(deque.cbegin(), deque.cend(), expected.begin());
+            std::vector<DataType> actual(50);
+            segmentedInclusiveScan(deque.cbegin(), deque.cend(), actual.begin());
+            CPPUNIT_ASSERT(actual == expected);
+            segmentedExclusiveScan(deque.cbegin(), deque.cend(), actual.data(), static_cast<DataType>(1));
+            CPPUNIT_ASSERT(actual[0] == 1);
+            for (int i = 1; i < 50; ++i) {
+                CPPUNIT_ASSERT(actual[i] == expected[i - 1] + 1);
+            }
+            segmentedInclusiveScan(deque.begin(), deque.end(), deque.begin());
+            CPPUNIT_ASSERT(std::equal(expected.begin(), expected.end(), deque.cbegin()));
+        }
+
+        // Deque of 1000 pseudorandom `DataType`s from -50 to 49 (0 to 99 if unsigned), wrapped around the end of its
+        // backing array.
+        template <class DataType>
+        static VectorDeque<DataType> randomWrapped() {
+            VectorDeque<DataType> deque(1024);
+            uint32_t state = 12345;
+            for (int i = 0; i < 1000; ++i) {
+                state = state * 1103515245 + 12345;
+                const int value = static_cast<int>(state >> 16 & 0x7FFF) % 100
+                        - (std::is_signed<DataType>::value ? 50 : 0);
+                if (i < 600) {
+                    deque.addFirst(static_cast<DataType>(value));
+                } else {
+                    deque.add(static_cast<DataType>(value));
+                }
+            }
+            return deque;
+        }
+
+        // Check that the compactions of a wrapped deque of `DataType` by every kind of `Comparison` agree with the
+        // corresponding `std::` algorithms.
+        template <class DataType>
+        void checkCompaction() {
+            const ComparisonOperator ops[] = {COMPARE_EQUAL, COMPARE_NOT_EQUAL, COMPARE_LESS, COMPARE_LESS_EQUAL,
+                    COMPARE_GREATER, COMPARE_GREATER_EQUAL};
+            const VectorDeque<DataType> original = randomWrapped<DataType>();
+            for (const ComparisonOperator op: ops) {
+                for (const int value: {-60, -3, 0, 7, 120}) {
+                    const Comparison<DataType> pred(op, static_cast<DataType>(value));
+                    std::vector<DataType> expected;
+                    std::copy_if(original.cbegin(), original.cend(), std::back_inserter(expected), pred);
+                    std::vector<DataType> actual;
+                    segmentedCopyIf(original.cbegin(), original.cend(), std::back_inserter(actual), pred);
+                    CPPUNIT_ASSERT(actual == expected);
+
+                    VectorDeque<DataType> deque(original);
+                    std::vector<DataType> kept(original.cbegin(), original.cend());
+                    kept.erase(std::remove_if(kept.begin(), kept.end(), pred), kept.end());
+                    const typename VectorDeque<DataType>::Iterator newEnd = segmentedRemoveIf(deque.begin(),
+                            deque.end(), pred);
+                    CPPUNIT_ASSERT(static_cast<size_t>(newEnd - deque.begin()) == kept.size());
+                    CPPUNIT_ASSERT(std::equal(kept.begin(), kept.end(), deque.cbegin()));
+
+                    deque = original;
+                    std::vector<DataType> partitioned(original.cbegin(), original.cend());
+                    const auto middle = std::stable_partition(partitioned.begin(), partitioned.end(), pred);
+                    CPPUNIT_ASSERT(segmentedPartition(deque.begin(), deque.end(), pred) - deque.begin()
+                            == middle - partitioned.begin());
+                    CPPUNIT_ASSERT(std::equal(partitioned.begin(), partitioned.end(), deque.cbegin()));
+                }
+            }
+        }
+
+    public:
+        void setUp() {
+            wrappedPtr = new VectorDeque<int>(128);
+            for (int i = 39; i >= 0; --i) {
+                wrappedPtr->addFirst(i);
+            }
+            for (int i = 40; i < 100; ++i) {
+                wrappedPtr->add(i);
+            }
+        }
+
+        void testCopy() {
+            std::vector<int> copied(100);
+            CPPUNIT_ASSERT(segmentedCopy(wrappedPtr->cbegin(), wrappedPtr->cend(), copied.begin()) == copied.end());
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(copied[i] == i);
+            }
+            // Part of the range, spanning the wrap.
+            int target[20];
+            segmentedCopy(wrappedPtr->begin() + 30, wrappedPtr->begin() + 50, target);
+            for (int i = 0; i < 20; ++i) {
+                CPPUNIT_ASSERT(target[i] == i + 30);
+            }
+            // Reverse iterators are not segmented, but still work.
+            segmentedCopy(wrappedPtr->crbegin(), wrappedPtr->crend(), copied.begin());
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(copied[i] == 99 - i);
+            }
+        }
+
+        void testCopyIf() {
+            checkCompaction<int32_t>();
+            checkCompaction<uint32_t>();
+            checkCompaction<int64_t>();
+            checkCompaction<uint64_t>();
+            checkCompaction<float>();
+            checkCompaction<double>();
+            checkCompaction<int16_t>();
+            // A predicate other than `Comparison`, over the wrap.
+            std::vector<int> odd;
+            segmentedCopyIf(wrappedPtr->cbegin() + 30, wrappedPtr->cbegin() + 50, std::back_inserter(odd),
+                    [](const int element) {
+                        return element % 2 != 0;
+                    });
+            CPPUNIT_ASSERT(odd.size() == 10);
+            for (size_t i = 0; i < odd.size(); ++i) {
+                CPPUNIT_ASSERT(odd[i] == static_cast<int>(31 + 2 * i));
+            }
+            // NaN compares unequal to everything.
+            VectorDeque<float> floats;
+            floats.add(1.0f);
+            floats.add(std::numeric_limits<float>::quiet_NaN());
+            std::vector<float> notOne;
+            segmentedCopyIf(floats.cbegin(), floats.cend(), std::back_inserter(notOne),
+                    Comparison<float>(COMPARE_NOT_EQUAL, 1.0f));
+            CPPUNIT_ASSERT(notOne.size() == 1 && notOne[0] != notOne[0]);
+            // Neither arithmetic nor segmented.
+            std::list<std::string> words;
+            words.push_back("a");
+            words.push_back("bb");
+            words.push_back("c");
+            std::vector<std::string> single;
+            segmentedCopyIf(words.begin(), words.end(), std::back_inserter(single), [](const std::string& word) {
+                return word.size() == 1;
+            });
+            CPPUNIT_ASSERT(single.size() == 2 && single[0] == "a" && single[1] == "c");
+        }
+
+        void testExclusiveScan() {
+            VectorDeque<int> copy(*wrappedPtr);
+            segmentedExclusiveScan(wrappedPtr->begin(), wrappedPtr->end(), wrappedPtr->begin(), 5);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT((*wrappedPtr)[i] == 5 + i * (i - 1) / 2);
+            }
+            // Into another deque, whose segments split at different points.
+            VectorDeque<int> target(128);
+            for (int i = 0; i < 70; ++i) {
+                target.addFirst(0);
+            }
+            for (int i = 0; i < 30; ++i) {
+                target.add(0);
+            }
+            segmentedExclusiveScan(copy.cbegin(), copy.cend(), target.begin(), 0);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(target[i] == i * (i - 1) / 2);
+            }
+            std::list<std::string> words;
+            words.push_back("a");
+            words.push_back("b");
+            std::vector<std::string> prefixes(2);
+            segmentedExclusiveScan(words.begin(), words.end(), prefixes.begin(), std::string(">"));
+            CPPUNIT_ASSERT(prefixes[0] == ">");
+            CPPUNIT_ASSERT(prefixes[1] == ">a");
+        }
+
+        void testFill() {
+            segmentedFill(wrappedPtr->begin() + 30, wrappedPtr->begin() + 50, -1);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT((*wrappedPtr)[i] == (i >= 30 && i < 50 ? -1 : i));
+            }
+            std::list<int> list(3, 0);
+            segmentedFill(list.begin(), list.end(), 2);
+            CPPUNIT_ASSERT(std::count(list.begin(), list.end(), 2) == 3);
+        }
+
+        void testFind() {
+            for (int i = 0; i < 100; ++i) {
+                const VectorDeque<int>::ConstIterator found = segmentedFind(wrappedPtr->cbegin(), wrappedPtr->cend(), i);
+                CPPUNIT_ASSERT(found - wrappedPtr->cbegin() == i);
+            }
+            CPPUNIT_ASSERT(segmentedFind(wrappedPtr->begin(), wrappedPtr->end(), 100) == wrappedPtr->end());
+            CPPUNIT_ASSERT(segmentedFind(wrappedPtr->begin() + 50, wrappedPtr->end(), 10) == wrappedPtr->end());
+        }
+
+        void testInclusiveScan() {
+            checkScan<int>();
+            checkScan<unsigned>();
+            checkScan<int64_t>();
+            checkScan<short>();
+            checkScan<float>();
+            checkScan<double>();
+            std::vector<int> sums(100);
+            CPPUNIT_ASSERT(segmentedInclusiveScan(wrappedPtr->cbegin() + 30, wrappedPtr->cbegin() + 50, sums.begin())
+                    == sums.begin() + 20);
+            for (int i = 0; i < 20; ++i) {
+                CPPUNIT_ASSERT(sums[i] == (i + 1) * (60 + i) / 2);
+            }
+            VectorDeque<std::string> strings;
+            strings.add("b");
+            strings.addFirst("a");
+            strings.add("c");
+            segmentedInclusiveScan(strings.begin(), strings.end(), strings.begin());
+            CPPUNIT_ASSERT(strings.peekLast() == "abc");
+        }
+
+        void testIsSegmentedIterator() {
+            static_assert(IsSegmentedIterator<VectorDeque<int>::Iterator>::value, "Iterators should be segmented");
+            static_assert(IsSegmentedIterator<VectorDeque<int>::ConstIterator>::value,
+                    "Iterators should be segmented");
+            static_assert(!IsSegmentedIterator<VectorDeque<int>::ReverseIterator>::value,
+                    "Reverse iterators should not be segmented");
+            static_assert(!IsSegmentedIterator<int*>::value, "Pointers should not be segmented");
+            static_assert(!IsSegmentedIterator<std::list<int>::iterator>::value, "Lists should not be segmented");
+        }
+
+        void testParallelScan() {
+            const int length = 100000;
+            VectorDeque<int64_t> deque(length + 1);
+            for (int i = 0; i < length / 3; ++i) {
+                deque.addFirst(i);
+            }
+            for (int i = length / 3; i < length; ++i) {
+                deque.add(i);
+            }
+            std::vector<int64_t> expected(length);
+            segmentedInclusiveScan(deque.cbegin(), deque.cend(), expected.begin());
+            std::vector<int64_t> actual(length);
+            CPPUNIT_ASSERT(parallelInclusiveScan(deque.cbegin(), deque.cend(), actual.begin(), 4) == actual.end());
+            CPPUNIT_ASSERT(actual == expected);
+            parallelExclusiveScan(deque.cbegin(), deque.cend(), actual.begin(), 7, 3);
+            CPPUNIT_ASSERT(actual[0] == 7);
+            CPPUNIT_ASSERT(actual[length - 1] == expected[length - 2] + 7);
+            parallelInclusiveScan(deque.begin(), deque.end(), deque.begin(), 4);
+            CPPUNIT_ASSERT(std::equal(expected.begin(), expected.end(), deque.cbegin()));
+            // Too short to be split.
+            parallelInclusiveScan(wrappedPtr->begin(), wrappedPtr->end(), wrappedPtr->begin());
+            CPPUNIT_ASSERT(wrappedPtr->peekLast() == 4950);
+        }
+
+        void testPartition() {
+            // Evens first, over the wrap.
+            const VectorDeque<int>::Iterator middle = segmentedPartition(wrappedPtr->begin(), wrappedPtr->end(),
+                    [](const int element) {
+                        return element % 2 == 0;
+                    });
+            CPPUNIT_ASSERT(middle - wrappedPtr->begin() == 50);
+            for (int i = 0; i < 50; ++i) {
+                CPPUNIT_ASSERT((*wrappedPtr)[i] == 2 * i);
+                CPPUNIT_ASSERT((*wrappedPtr)[50 + i] == 2 * i + 1);
+            }
+            VectorDeque<std::string> words;
+            words.add("bb");
+            words.add("a");
+            words.add("cc");
+            words.add("d");
+            const VectorDeque<std::string>::Iterator wordsMiddle = segmentedPartition(words.begin(), words.end(),
+                    [](const std::string& word) {
+                        return word.size() == 1;
+                    });
+            CPPUNIT_ASSERT(wordsMiddle - words.begin() == 2);
+            CPPUNIT_ASSERT(words[0] == "a" && words[1] == "d" && words[2] == "bb" && words[3] == "cc");
+        }
+
+        void testRemoveIf() {
+            // Remove multiples of 3 from part of the range, over the wrap.
+            const VectorDeque<int>::Iterator newEnd = segmentedRemoveIf(wrappedPtr->begin() + 20,
+                    wrappedPtr->begin() + 60, [](const int element) {
+                        return element % 3 == 0;
+                    });
+            CPPUNIT_ASSERT(newEnd - wrappedPtr->begin() == 47);
+            for (int i = 0; i < 20; ++i) {
+                CPPUNIT_ASSERT((*wrappedPtr)[i] == i);
+            }
+            int expected = 20;
+            for (int i = 20; i < 47; ++i, ++expected) {
+                if (expected % 3 == 0) {
+                    ++expected;
+                }
+                CPPUNIT_ASSERT((*wrappedPtr)[i] == expected);
+            }
+            for (int i = 60; i < 100; ++i) {
+                CPPUNIT_ASSERT((*wrappedPtr)[i] == i);
+            }
+            // Trim the whole deque to the elements kept.
+            VectorDeque<int> deque = randomWrapped<int>();
+            const size_t numNegative = static_cast<size_t>(std::count_if(deque.cbegin(), deque.cend(),
+                    Comparison<int>(COMPARE_LESS, 0)));
+            const VectorDeque<int>::Iterator nonNegativeEnd = segmentedRemoveIf(deque.begin(), deque.end(),
+                    Comparison<int>(COMPARE_LESS, 0));
+            deque.skipLast(static_cast<size_t>(deque.end() - nonNegativeEnd));
+            CPPUNIT_ASSERT(deque.size() == 1000 - numNegative);
+            CPPUNIT_ASSERT(std::count_if(deque.cbegin(), deque.cend(), Comparison<int>(COMPARE_LESS, 0)) == 0);
+            std::vector<std::string> words;
+            words.push_back("a");
+            words.push_back("bb");
+            words.erase(segmentedRemoveIf(words.begin(), words.end(), [](const std::string& word) {
+                return word.size() == 1;
+            }), words.end());
+            CPPUNIT_ASSERT(words.size() == 1 && words[0] == "bb");
+        }
+
+        void testStandardAlgorithms() {
+            static_assert(std::is_same<std::iterator_traits<VectorDeque<int>::Iterator>::iterator_category,
+                    std::random_access_iterator_tag>::value, "Iterators should be random access");
+            static_assert(std::is_same<std::iterator_traits<VectorDeque<int>::ConstIterator>::reference,
+                    const int&>::value, "Constant iterators should give constant references");
+#if defined(__cpp_lib_ranges)
+            static_assert(std::random_access_iterator<VectorDeque<int>::Iterator>, "Should satisfy the concept");
+            static_assert(std::random_access_iterator<VectorDeque<int>::ConstReverseIterator>,
+                    "Should satisfy the concept");
+            static_assert(std::ranges::random_access_range<VectorDeque<int> >, "Should be a range");
+            static_assert(std::ranges::random_access_range<const VectorDeque<int> >, "Should be a range");
+            static_assert(std::ranges::contiguous_range<VectorDequeSegment<int> >, "Segments should be contiguous");
+            CPPUNIT_ASSERT(*std::ranges::find(*wrappedPtr, 42) == 42);
+            CPPUNIT_ASSERT(std::ranges::distance(*wrappedPtr | std::views::reverse | std::views::take(5)) == 5);
+#endif
+            std::reverse(wrappedPtr->begin(), wrappedPtr->end());
+            CPPUNIT_ASSERT(wrappedPtr->peek() == 99);
+            std::sort(wrappedPtr->begin(), wrappedPtr->end());
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT((*wrappedPtr)[i] == i);
+            }
+            CPPUNIT_ASSERT(std::lower_bound(wrappedPtr->cbegin(), wrappedPtr->cend(), 57) - wrappedPtr->cbegin() == 57);
+            VectorDeque<int>::Iterator it;
+            it = wrappedPtr->begin() + 3;
+            CPPUNIT_ASSERT(*it == 3);
+        }
+
+        void tearDown() {
+            delete wrappedPtr;
+        }
+};
@@ -0,0 +1,124 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "SharedMemoryRing.hpp"
+
+class SharedMemoryRingTest: public CppUnit::TestFixture {
+    private:
+        CPPUNIT_TEST_SUITE(SharedMemoryRingTest);
+        CPPUNIT_TEST(testBadHeader);
+        CPPUNIT_TEST(testFork);
+        CPPUNIT_TEST(testNamed);
+        CPPUNIT_TEST(testPeek);
+        CPPUNIT_TEST(testTimeout);
+        CPPUNIT_TEST(testWrap);
+        CPPUNIT_TEST_SUITE_END();
+
+        // The `i`th record written by `testFork`.
+        static std::string forkRecord(const int i) {
+            return std::string(static_cast<size_t>(i % 61), static_cast<char>('a' + i % 26));
+        }
+
+    public:
+        void testBadHeader() {
+            SharedMemoryRing ring = SharedMemoryRing::createAnonymous(64);
+            ring._header->version = SharedMemoryRing::VERSION + 1;
+            CPPUNIT_ASSERT_THROW(SharedMemoryRing::fromFd(dup(ring.fd())), std::runtime_error);
+            ring._header->version = SharedMemoryRing::VERSION;
+            ring._header->magic = 0;
+            CPPUNIT_ASSERT_THROW(SharedMemoryRing::fromFd(dup(ring.fd())), std::runtime_error);
+            CPPUNIT_ASSERT_THROW(SharedMemoryRing::open("/VectorDequeTestMissing"), std::system_error);
+        }
+
+        void testFork() {
+            const int numRecords = 20000;
+            // Small, so that both processes wait for each other often.
+            SharedMemoryRing ring = SharedMemoryRing::createAnonymous(256);
+            const pid_t child = fork();
+            CPPUNIT_ASSERT(child >= 0);
+            if (child == 0) {
+                for (int i = 0; i < numRecords; ++i) {
+                    ring.write(forkRecord(i));
+                }
+                _exit(0);
+            }
+            bool allRead = true;
+            std::string record;
+            for (int i = 0; i < numRecords && allRead; ++i) {
+                allRead = ring.read(record, std::chrono::seconds(10)) && record == forkRecord(i);
+            }
+            int status;
+            CPPUNIT_ASSERT(waitpid(child, &status, 0) == child);
+            CPPUNIT_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+            CPPUNIT_ASSERT(allRead);
+            CPPUNIT_ASSERT(!ring.tryRead(record));
+        }
+
+        void testNamed() {
+            const std::string name = "/VectorDequeTest" + std::to_string(getpid());
+            SharedMemoryRing producer = SharedMemoryRing::create(name, 100);
+            CPPUNIT_ASSERT(producer.capacity() == 128);
+            CPPUNIT_ASSERT_THROW(SharedMemoryRing::create(name, 100), std::system_error);
+            SharedMemoryRing consumer = SharedMemoryRing::open(name);
+            SharedMemoryRing::unlink(name);
+            CPPUNIT_ASSERT_THROW(SharedMemoryRing::unlink(name), std::system_error);
+            CPPUNIT_ASSERT(consumer.capacity() == 128);
+            CPPUNIT_ASSERT(producer.write("hello"));
+            CPPUNIT_ASSERT(producer.write(""));
+            std::string record;
+            CPPUNIT_ASSERT(consumer.tryRead(record));
+            CPPUNIT_ASSERT(record == "hello");
+            CPPUNIT_ASSERT(consumer.tryRead(record));
+            CPPUNIT_ASSERT(record.empty());
+            CPPUNIT_ASSERT(!consumer.tryRead(record));
+        }
+
+        void testPeek() {
+            SharedMemoryRing ring = SharedMemoryRing::createAnonymous(64);
+            VectorDequeSegments<const char> record;
+            CPPUNIT_ASSERT(!ring.peek(record));
+            CPPUNIT_ASSERT_THROW(ring.skip(), std::length_error);
+            ring.write("abc");
+            CPPUNIT_ASSERT(ring.peek(record));
+            CPPUNIT_ASSERT(record.first.size() == 3);
+            CPPUNIT_ASSERT(std::memcmp(record.first.data, "abc", 3) == 0);
+            CPPUNIT_ASSERT(record.second.size() == 0);
+            // Read in place, from the shared memory.
+            CPPUNIT_ASSERT(record.first.data > reinterpret_cast<const char*>(ring._header));
+            ring.skip();
+            CPPUNIT_ASSERT(!ring.peek(record));
+        }
+
+        void testTimeout() {
+            SharedMemoryRing ring = SharedMemoryRing::createAnonymous(16);
+            std::string record;
+            CPPUNIT_ASSERT(!ring.read(record, std::chrono::milliseconds(1)));
+            CPPUNIT_ASSERT(ring.write(std::string(12, 'x'), std::chrono::milliseconds(1)));
+            CPPUNIT_ASSERT(!ring.write("", std::chrono::milliseconds(1)));
+            CPPUNIT_ASSERT(!ring.tryWrite("", 0));
+            CPPUNIT_ASSERT_THROW(ring.tryWrite(std::string(13, 'x').c_str(), 13), std::length_error);
+        }
+
+        void testWrap() {
+            SharedMemoryRing ring = SharedMemoryRing::createAnonymous(32);
+            std::string record;
+            ring.write(std::string(20, 'a'));
+            CPPUNIT_ASSERT(ring.tryRead(record));
+            // Starts 24 bytes in, so its bytes continue at the start of the data.
+            ring.write("0123456789");
+            VectorDequeSegments<const char> segments;
+            CPPUNIT_ASSERT(ring.peek(segments));
+            CPPUNIT_ASSERT(segments.first.size() == 4);
+            CPPUNIT_ASSERT(segments.second.size() == 6);
+            CPPUNIT_ASSERT(ring.tryRead(record));
+            CPPUNIT_ASSERT(record == "0123456789");
+        }
+};
@@ -0,0 +1,139 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "SlidingQuantiles.hpp"
+
+class SlidingQuantilesTest: public CppUnit::TestFixture {
+    private:
+        CPPUNIT_TEST_SUITE(SlidingQuantilesTest);
+        CPPUNIT_TEST(testAdd);
+        CPPUNIT_TEST(testClear);
+        CPPUNIT_TEST(testEquivalent);
+        CPPUNIT_TEST(testPop);
+        CPPUNIT_TEST(testQuantile);
+        CPPUNIT_TEST(testRandom);
+        CPPUNIT_TEST(testInternalReusesNodes);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void testAdd() {
+            SlidingQuantiles<int> quantiles(3);
+            CPPUNIT_ASSERT(quantiles.isEmpty());
+            CPPUNIT_ASSERT(!quantiles.add(5));
+            CPPUNIT_ASSERT(!quantiles.add(1));
+            CPPUNIT_ASSERT(!quantiles.add(3));
+            CPPUNIT_ASSERT(quantiles.size() == 3);
+            CPPUNIT_ASSERT(quantiles.select(0) == 1);
+            CPPUNIT_ASSERT(quantiles.select(1) == 3);
+            CPPUNIT_ASSERT(quantiles.select(2) == 5);
+            // Evicts 5.
+            CPPUNIT_ASSERT(quantiles.add(2));
+            CPPUNIT_ASSERT(quantiles.size() == 3);
+            CPPUNIT_ASSERT(quantiles.select(0) == 1);
+            CPPUNIT_ASSERT(quantiles.select(1) == 2);
+            CPPUNIT_ASSERT(quantiles.select(2) == 3);
+            CPPUNIT_ASSERT(quantiles.window().peek() == 1);
+            CPPUNIT_ASSERT(quantiles.window().peekLast() == 2);
+            CPPUNIT_ASSERT_THROW(quantiles.select(3), std::length_error);
+        }
+
+        void testClear() {
+            SlidingQuantiles<int> quantiles;
+            for (int i = 0; i < 100; ++i) {
+                quantiles.add(i);
+            }
+            quantiles.clear();
+            CPPUNIT_ASSERT(quantiles.isEmpty());
+            CPPUNIT_ASSERT_THROW(quantiles.median(), std::length_error);
+            quantiles.add(7);
+            quantiles.add(-7);
+            CPPUNIT_ASSERT(quantiles.select(0) == -7);
+            CPPUNIT_ASSERT(quantiles.select(1) == 7);
+        }
+
+        void testEquivalent() {
+            // Ordered by the first member only, so evicting has to remove the right one of equivalent samples.
+            typedef std::pair<int, int> Sample;
+            const auto byFirst = [](const Sample& a, const Sample& b) {
+                return a.first < b.first;
+            };
+            SlidingQuantiles<Sample, std::function<bool(const Sample&, const Sample&)> > quantiles(2, byFirst);
+            quantiles.add(Sample(1, 0));
+            quantiles.add(Sample(1, 1));
+            quantiles.add(Sample(1, 2));
+            CPPUNIT_ASSERT(quantiles.select(0) == Sample(1, 1));
+            CPPUNIT_ASSERT(quantiles.select(1) == Sample(1, 2));
+        }
+
+        void testPop() {
+            SlidingQuantiles<int, std::greater<int> > quantiles;
+            CPPUNIT_ASSERT_THROW(quantiles.pop(), std::length_error);
+            quantiles.add(1);
+            quantiles.add(2);
+            quantiles.add(3);
+            CPPUNIT_ASSERT(quantiles.select(0) == 3);
+            CPPUNIT_ASSERT(quantiles.pop() == 1);
+            CPPUNIT_ASSERT(quantiles.pop() == 2);
+            CPPUNIT_ASSERT(quantiles.select(0) == 3);
+            CPPUNIT_ASSERT(quantiles.pop() == 3);
+            CPPUNIT_ASSERT(quantiles.isEmpty());
+        }
+
+        void testQuantile() {
+            SlidingQuantiles<int> quantiles;
+            CPPUNIT_ASSERT_THROW(quantiles.quantile(0.5), std::length_error);
+            for (int i = 100; i >= 0; --i) {
+                quantiles.add(i);
+            }
+            CPPUNIT_ASSERT(quantiles.quantile(0) == 0);
+            CPPUNIT_ASSERT(quantiles.quantile(0.5) == 50);
+            CPPUNIT_ASSERT(quantiles.quantile(0.9) == 90);
+            CPPUNIT_ASSERT(quantiles.quantile(0.99) == 99);
+            CPPUNIT_ASSERT(quantiles.quantile(1) == 100);
+            CPPUNIT_ASSERT(quantiles.median() == 50);
+            quantiles.pop();
+            CPPUNIT_ASSERT(quantiles.median() == 49);
+            CPPUNIT_ASSERT_THROW(quantiles.quantile(-0.1), std::invalid_argument);
+            CPPUNIT_ASSERT_THROW(quantiles.quantile(1.5), std::invalid_argument);
+        }
+
+        void testRandom() {
+            std::srand(3);
+            SlidingQuantiles<int> quantiles(200);
+            std::vector<int> sorted;
+            for (int i = 0; i < 3000; ++i) {
+                quantiles.add(std::rand() % 100);
+                if (i % 7 == 0) {
+                    quantiles.pop();
+                }
+                if (i % 50 == 0) {
+                    sorted.assign(quantiles.window().cbegin(), quantiles.window().cend());
+                    std::sort(sorted.begin(), sorted.end());
+                    for (size_t rank = 0; rank < sorted.size(); ++rank) {
+                        CPPUNIT_ASSERT(quantiles.select(rank) == sorted[rank]);
+                    }
+                }
+            }
+        }
+
+        void testInternalReusesNodes() {
+            SlidingQuantiles<int> quantiles(10);
+            for (int i = 0; i < 10000; ++i) {
+                quantiles.add(i % 13);
+            }
+            // Without reuse, there would be about two links per sample ever added, rather than a few per sample in the
+            // window.
+            CPPUNIT_ASSERT(quantiles._links.size() < SlidingQuantiles<int>::MAX_LEVELS + 500);
+            size_t numFree = 0;
+            for (size_t height = 1; height <= SlidingQuantiles<int>::MAX_LEVELS; ++height) {
+                numFree += quantiles._freeNodes[height - 1].size();
+            }
+            CPPUNIT_ASSERT(numFree > 0);
+        }
+};
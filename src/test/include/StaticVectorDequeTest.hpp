@@ -0,0 +1,158 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "StaticVectorDeque.hpp"
+
+class StaticVectorDequeTest: public CppUnit::TestFixture {
+    private:
+        StaticVectorDeque<int, 100>* dequePtr;
+
+        CPPUNIT_TEST_SUITE(StaticVectorDequeTest);
+        CPPUNIT_TEST(testAccess);
+        CPPUNIT_TEST(testAdd);
+        CPPUNIT_TEST(testAddFirst);
+        CPPUNIT_TEST(testConstexpr);
+        CPPUNIT_TEST(testFind);
+        CPPUNIT_TEST(testPop);
+        CPPUNIT_TEST(testPopLast);
+        CPPUNIT_TEST(testSkip);
+        CPPUNIT_TEST(testWrapAround);
+        CPPUNIT_TEST_SUITE_END();
+
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+        // Breadth-first search over a small static graph, evaluated at compile time.
+        static constexpr int bfsDistance(const int (&edges)[6][2], const int from, const int to) {
+            int distances[6] = {-1, -1, -1, -1, -1, -1};
+            StaticVectorDeque<int, 6> frontier;
+            distances[from] = 0;
+            frontier.add(from);
+            while (!frontier.isEmpty()) {
+                const int node = frontier.pop();
+                for (int i = 0; i < 2; ++i) {
+                    const int next = edges[node][i];
+                    if (next >= 0 && distances[next] == -1) {
+                        distances[next] = distances[node] + 1;
+                        frontier.add(next);
+                    }
+                }
+            }
+            return distances[to];
+        }
+
+        static constexpr int sumAfterWrapping() {
+            StaticVectorDeque<int, 3> deque;
+            int sum = 0;
+            for (int i = 0; i < 10; ++i) {
+                deque.add(i);
+                deque.addFirst(-i);
+                sum += deque.popLast() + deque.pop();
+            }
+            return sum + static_cast<int>(deque.size());
+        }
+#endif
+
+    public:
+        void setUp() {
+            dequePtr = new StaticVectorDeque<int, 100>();
+        }
+
+        void testAccess() {
+            CPPUNIT_ASSERT_THROW((*dequePtr)[0], std::length_error);
+            dequePtr->add(3);
+            CPPUNIT_ASSERT((*dequePtr)[0] == 3);
+            (*dequePtr)[0] = 4;
+            const StaticVectorDeque<int, 100>& constDeque = *dequePtr;
+            CPPUNIT_ASSERT(constDeque[0] == 4);
+            CPPUNIT_ASSERT_THROW(constDeque[1], std::length_error);
+        }
+
+        void testAdd() {
+            for (int i = 0; i < 100; ++i) {
+                dequePtr->add(i);
+            }
+            CPPUNIT_ASSERT(dequePtr->isFull());
+            CPPUNIT_ASSERT_THROW(dequePtr->add(100), std::length_error);
+            CPPUNIT_ASSERT(dequePtr->size() == 100);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT((*dequePtr)[i] == i);
+            }
+        }
+
+        void testAddFirst() {
+            for (int i = 0; i < 100; ++i) {
+                dequePtr->addFirst(i);
+            }
+            CPPUNIT_ASSERT_THROW(dequePtr->addFirst(100), std::length_error);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT((*dequePtr)[i] == 99 - i);
+            }
+            CPPUNIT_ASSERT(dequePtr->capacity() == 100);
+        }
+
+        void testConstexpr() {
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201304L
+            constexpr int edges[6][2] = {{1, 2}, {3, -1}, {3, 4}, {5, -1}, {5, -1}, {-1, -1}};
+            static_assert(bfsDistance(edges, 0, 5) == 3, "BFS should be evaluated at compile time");
+            static_assert(bfsDistance(edges, 1, 2) == -1, "BFS should be evaluated at compile time");
+            static_assert(sumAfterWrapping() == 0, "Wrapping should work at compile time");
+            CPPUNIT_ASSERT(bfsDistance(edges, 2, 5) == 2);
+#endif
+        }
+
+        void testFind() {
+            CPPUNIT_ASSERT(dequePtr->find(3) == -1);
+            dequePtr->add(3);
+            dequePtr->addFirst(5);
+            CPPUNIT_ASSERT(dequePtr->find(3) == 1);
+            CPPUNIT_ASSERT(dequePtr->find(5) == 0);
+        }
+
+        void testPop() {
+            CPPUNIT_ASSERT_THROW(dequePtr->pop(), std::length_error);
+            dequePtr->add(3);
+            dequePtr->add(4);
+            CPPUNIT_ASSERT(dequePtr->peek() == 3);
+            CPPUNIT_ASSERT(dequePtr->pop() == 3);
+            CPPUNIT_ASSERT(dequePtr->pop() == 4);
+            CPPUNIT_ASSERT(dequePtr->isEmpty());
+        }
+
+        void testPopLast() {
+            CPPUNIT_ASSERT_THROW(dequePtr->popLast(), std::length_error);
+            dequePtr->add(3);
+            dequePtr->add(4);
+            CPPUNIT_ASSERT(dequePtr->peekLast() == 4);
+            CPPUNIT_ASSERT(dequePtr->popLast() == 4);
+            CPPUNIT_ASSERT(dequePtr->popLast() == 3);
+            CPPUNIT_ASSERT(dequePtr->isEmpty());
+        }
+
+        void testSkip() {
+            CPPUNIT_ASSERT_THROW(dequePtr->skip(1), std::length_error);
+            CPPUNIT_ASSERT_THROW(dequePtr->skipLast(1), std::length_error);
+            for (int i = 0; i < 10; ++i) {
+                dequePtr->add(i);
+            }
+            dequePtr->skip(3);
+            dequePtr->skipLast(3);
+            CPPUNIT_ASSERT(dequePtr->size() == 4);
+            CPPUNIT_ASSERT(dequePtr->peek() == 3);
+            CPPUNIT_ASSERT(dequePtr->peekLast() == 6);
+            dequePtr->clear();
+            CPPUNIT_ASSERT(dequePtr->isEmpty());
+        }
+
+        void testWrapAround() {
+            for (int round = 0; round < 3; ++round) {
+                for (int i = 0; i < 70; ++i) {
+                    dequePtr->add(i);
+                }
+                for (int i = 0; i < 70; ++i) {
+                    CPPUNIT_ASSERT(dequePtr->pop() == i);
+                }
+            }
+        }
+
+        void tearDown() {
+            delete dequePtr;
+        }
+};
@@ -0,0 +1,129 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include "TimingWheel.hpp"
+
+class TimingWheelTest: public CppUnit::TestFixture {
+    private:
+        CPPUNIT_TEST_SUITE(TimingWheelTest);
+        CPPUNIT_TEST(testCancel);
+        CPPUNIT_TEST(testCascade);
+        CPPUNIT_TEST(testExpire);
+        CPPUNIT_TEST(testRandom);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void testCancel() {
+            TimingWheel<int> wheel;
+            const TimerHandle first = wheel.schedule(1, 10);
+            const TimerHandle second = wheel.schedule(2, 10);
+            CPPUNIT_ASSERT(wheel.size() == 2);
+            CPPUNIT_ASSERT(wheel.cancel(first));
+            CPPUNIT_ASSERT(!wheel.cancel(first));
+            CPPUNIT_ASSERT(!wheel.isPending(first));
+            CPPUNIT_ASSERT(wheel.isPending(second));
+            CPPUNIT_ASSERT(wheel.size() == 1);
+            VectorDeque<int> expired;
+            CPPUNIT_ASSERT(wheel.advance(10, expired) == 1);
+            CPPUNIT_ASSERT(expired.size() == 1);
+            CPPUNIT_ASSERT(expired.peek() == 2);
+            CPPUNIT_ASSERT(!wheel.cancel(second));
+
+            // Both nodes were reclaimed, and stale handles do not match the timers reusing them.
+            CPPUNIT_ASSERT(wheel._freeNodes.size() == 2);
+            const TimerHandle third = wheel.schedule(3, 20);
+            CPPUNIT_ASSERT(third.node == first.node || third.node == second.node);
+            CPPUNIT_ASSERT(!wheel.cancel(first));
+            CPPUNIT_ASSERT(!wheel.cancel(second));
+            CPPUNIT_ASSERT(wheel.isPending(third));
+        }
+
+        void testCascade() {
+            TimingWheel<int> wheel(5);
+            // Far enough ahead to start at the top level and cascade through all of them.
+            const uint64_t far = (static_cast<uint64_t>(1) << 62) + 12345;
+            wheel.schedule(1, far);
+            wheel.schedule(2, 64);
+            wheel.schedule(3, 4096 + 7);
+            CPPUNIT_ASSERT(wheel._occupied[0] == 0);
+            CPPUNIT_ASSERT(wheel._occupied[1] != 0);
+            CPPUNIT_ASSERT(wheel._occupied[2] != 0);
+            CPPUNIT_ASSERT(wheel._occupied[TimingWheel<int>::NUM_LEVELS - 1] != 0);
+            VectorDeque<int> expired;
+            CPPUNIT_ASSERT(wheel.advance(4096 + 6, expired) == 1);
+            CPPUNIT_ASSERT(expired.pop() == 2);
+            CPPUNIT_ASSERT(wheel.advance(4096 + 7, expired) == 1);
+            CPPUNIT_ASSERT(expired.pop() == 3);
+            CPPUNIT_ASSERT(wheel.advance(far - 1, expired) == 0);
+            CPPUNIT_ASSERT(wheel.now() == far - 1);
+            CPPUNIT_ASSERT(wheel.advance(far, expired) == 1);
+            CPPUNIT_ASSERT(expired.pop() == 1);
+            CPPUNIT_ASSERT(wheel.size() == 0);
+        }
+
+        void testExpire() {
+            TimingWheel<int> wheel;
+            for (int i = 0; i < 200; ++i) {
+                wheel.schedule(i, static_cast<uint64_t>(200 - i));
+            }
+            VectorDeque<int> expired;
+            // Deadlines at or before now expire on the next advance.
+            wheel.advance(50, expired);
+            wheel.schedule(-1, 20);
+            CPPUNIT_ASSERT(expired.size() == 50);
+            for (int i = 0; i < 50; ++i) {
+                CPPUNIT_ASSERT(expired[i] == 199 - i);
+            }
+            expired.clear();
+            CPPUNIT_ASSERT(wheel.advance(50, expired) == 0);
+            CPPUNIT_ASSERT(wheel.advance(51, expired) == 2);
+            CPPUNIT_ASSERT(expired[0] == 149);
+            CPPUNIT_ASSERT(expired[1] == -1);
+            CPPUNIT_ASSERT(wheel.size() == 149);
+        }
+
+        void testRandom() {
+            TimingWheel<int> wheel;
+            std::srand(7);
+            // Expected deadline of every pending timer, by value.
+            std::map<int, uint64_t> pending;
+            std::vector<TimerHandle> handles;
+            VectorDeque<int> expired;
+            uint64_t now = 0;
+            bool correct = true;
+            for (int i = 0; i < 20000; ++i) {
+                const uint64_t deadline = now + 1 + static_cast<uint64_t>(std::rand() % (1 << (std::rand() % 20)));
+                handles.push_back(wheel.schedule(i, deadline));
+                pending[i] = deadline;
+                if (std::rand() % 4 == 0) {
+                    const int victim = std::rand() % (i + 1);
+                    if (wheel.cancel(handles[static_cast<size_t>(victim)])) {
+                        correct = correct && pending.erase(victim) == 1;
+                    }
+                }
+                if (std::rand() % 8 == 0) {
+                    now += static_cast<uint64_t>(std::rand() % 5000);
+                    expired.clear();
+                    wheel.advance(now, expired);
+                    uint64_t last = 0;
+                    for (size_t j = 0; j < expired.size(); ++j) {
+                        const std::map<int, uint64_t>::iterator it = pending.find(expired[j]);
+                        correct = correct && it != pending.end() && it->second <= now && it->second >= last;
+                        if (it != pending.end()) {
+                            last = it->second;
+                            pending.erase(it);
+                        }
+                    }
+                    for (const std::pair<const int, uint64_t>& timer: pending) {
+                        correct = correct && timer.second > now;
+                    }
+                }
+            }
+            CPPUNIT_ASSERT(correct);
+            CPPUNIT_ASSERT(wheel.size() == pending.size());
+        }
+};
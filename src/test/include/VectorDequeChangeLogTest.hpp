@@ -0,0 +1,236 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "VectorDeque.hpp"
+#include "VectorDequeChangeLog.hpp"
+
+class VectorDequeChangeLogTest: public CppUnit::TestFixture {
+    private:
+        typedef BasicVectorDeque<int, LogChanges> LoggedDeque;
+
+        std::string base;
+
+        CPPUNIT_TEST_SUITE(VectorDequeChangeLogTest);
+        CPPUNIT_TEST(testAssign);
+        CPPUNIT_TEST(testBadCheckpoint);
+        CPPUNIT_TEST(testCompaction);
+        CPPUNIT_TEST(testFillAndNthElement);
+        CPPUNIT_TEST(testMergedRemovals);
+        CPPUNIT_TEST(testRecover);
+        CPPUNIT_TEST(testResume);
+        CPPUNIT_TEST(testTornRecord);
+        CPPUNIT_TEST_SUITE_END();
+
+        static bool exists(const std::string& path) {
+            return static_cast<bool>(std::ifstream(path.c_str()));
+        }
+
+        // Recover the checkpoint into a plain deque and check that it matches `deque`.
+        void checkRecovered(const LoggedDeque& deque) {
+            VectorDeque<int> recovered;
+            recoverChangeLog(base, recovered);
+            CPPUNIT_ASSERT(recovered.size() == deque.size());
+            for (size_t i = 0; i < deque.size(); ++i) {
+                CPPUNIT_ASSERT(recovered[i] == deque[i]);
+            }
+        }
+
+        // Make a mix of every kind of change.
+        static void modify(LoggedDeque& deque, const int seed) {
+            for (int i = 0; i < 20; ++i) {
+                deque.add(seed + i);
+                deque.addFirst(seed - i);
+            }
+            const int elements[] = {seed, seed + 1, seed + 2};
+            deque.addAll(elements, 3);
+            deque.addAllFirst(elements, 3);
+            deque.pop();
+            deque.pop();
+            deque.popLast();
+            deque.insert(seed * 2, 5);
+            deque.removeAt(7);
+            deque.set(3, -seed);
+            deque.skip(4);
+            deque.skipLast(2);
+        }
+
+    public:
+        void setUp() {
+            base = "VectorDequeChangeLogTest";
+        }
+
+        void tearDown() {
+            std::remove((base + ".snapshot").c_str());
+            for (int generation = 1; generation <= 200; ++generation) {
+                std::remove((base + ".log." + std::to_string(generation)).c_str());
+            }
+        }
+
+        void testAssign() {
+            LoggedDeque deque;
+            auto& log = deque.observer<LogChanges>();
+            log.startLog(base);
+            LoggedDeque other;
+            for (int i = 0; i < 10; ++i) {
+                other.add(i);
+            }
+            deque = other;
+            deque.add(10);
+            log.checkpoint();
+            checkRecovered(deque);
+            deque.clear();
+            log.checkpoint();
+            checkRecovered(deque);
+        }
+
+        void testBadCheckpoint() {
+            VectorDeque<int> deque;
+            CPPUNIT_ASSERT_THROW(recoverChangeLog("nonexistent/checkpoint", deque), std::runtime_error);
+            LoggedDeque logged;
+            auto& log = logged.observer<LogChanges>();
+            CPPUNIT_ASSERT_THROW(log.checkpoint(), std::logic_error);
+            CPPUNIT_ASSERT(log.stopLog() == 0);
+            logged.add(1);
+            log.startLog(base);
+            logged.add(2);
+            log.stopLog();
+            // The element size is checked.
+            VectorDeque<int64_t> wide;
+            CPPUNIT_ASSERT_THROW(recoverChangeLog(base, wide), std::runtime_error);
+            {
+                std::ofstream stream((base + ".snapshot").c_str(), std::ios::binary);
+                stream << "VDQX";
+            }
+            CPPUNIT_ASSERT_THROW(recoverChangeLog(base, deque), std::runtime_error);
+        }
+
+        void testCompaction() {
+            LoggedDeque deque;
+            auto& log = deque.observer<LogChanges>();
+            log.startLog(base, 256);
+            for (int round = 0; round < 50; ++round) {
+                modify(deque, round);
+                if (log.generation() > 3) {
+                    // Let some compactions finish while logging continues.
+                    log.checkpoint();
+                }
+            }
+            CPPUNIT_ASSERT(log.generation() > 1);
+            const uint64_t generation = log.stopLog();
+            CPPUNIT_ASSERT(!log.isLogging());
+            checkRecovered(deque);
+
+            // The compacted logs were folded into the snapshot and removed.
+            VectorDeque<int> recovered;
+            uint64_t snapshotGeneration = recoverChangeLog(base, recovered, 0);
+            CPPUNIT_ASSERT(snapshotGeneration > 0);
+            CPPUNIT_ASSERT(snapshotGeneration < generation);
+            CPPUNIT_ASSERT(!exists(base + ".log.1"));
+            CPPUNIT_ASSERT(!exists(base + ".log." + std::to_string(snapshotGeneration)));
+            CPPUNIT_ASSERT(exists(base + ".log." + std::to_string(generation)));
+            CPPUNIT_ASSERT(recoverChangeLog(base, recovered) == generation);
+        }
+
+        void testFillAndNthElement() {
+            LoggedDeque deque;
+            auto& log = deque.observer<LogChanges>();
+            log.startLog(base);
+            for (int i = 5; i > 0; --i) {
+                deque.add(i);
+            }
+            deque.fill(7);
+            deque.add(9);
+            deque.addFirst(8);
+            deque.nthElement(0);
+            CPPUNIT_ASSERT(deque[0] == 7);
+            log.checkpoint();
+            checkRecovered(deque);
+        }
+
+        void testMergedRemovals() {
+            LoggedDeque deque;
+            auto& log = deque.observer<LogChanges>();
+            for (int i = 0; i < 100; ++i) {
+                deque.add(i);
+            }
+            log.startLog(base);
+            for (int i = 0; i < 10; ++i) {
+                deque.pop();
+            }
+            deque.skip(40);
+            log.checkpoint();
+            // One record: the operation and a 1 byte count.
+            CPPUNIT_ASSERT(log.logBytes() == 2);
+            checkRecovered(deque);
+        }
+
+        void testRecover() {
+            LoggedDeque deque;
+            auto& log = deque.observer<LogChanges>();
+            for (int i = 0; i < 100; ++i) {
+                deque.add(i);
+            }
+            // Changes before logging starts are in the snapshot.
+            log.startLog(base);
+            CPPUNIT_ASSERT(log.isLogging());
+            CPPUNIT_ASSERT(log.generation() == 1);
+            checkRecovered(deque);
+            modify(deque, 1000);
+            log.checkpoint();
+            checkRecovered(deque);
+            modify(deque, 2000);
+            CPPUNIT_ASSERT(log.stopLog() == 1);
+            checkRecovered(deque);
+
+            // Starting again replaces the checkpoint.
+            log.startLog(base);
+            deque.clear();
+            deque.add(5);
+            log.stopLog();
+            checkRecovered(deque);
+        }
+
+        void testResume() {
+            LoggedDeque deque;
+            auto& log = deque.observer<LogChanges>();
+            log.startLog(base, 128);
+            modify(deque, 1);
+            modify(deque, 2);
+            log.stopLog();
+
+            LoggedDeque recovered;
+            auto& recoveredLog = recovered.observer<LogChanges>();
+            const uint64_t generation = recoverChangeLog(base, recovered);
+            CPPUNIT_ASSERT(generation == log.generation());
+            CPPUNIT_ASSERT(!recoveredLog.isLogging());
+            recoveredLog.resumeLog(base, generation, 128);
+            CPPUNIT_ASSERT(recoveredLog.generation() == generation + 1);
+            modify(recovered, 3);
+            recoveredLog.compact();
+            modify(recovered, 4);
+            recoveredLog.stopLog();
+            checkRecovered(recovered);
+        }
+
+        void testTornRecord() {
+            LoggedDeque deque;
+            auto& log = deque.observer<LogChanges>();
+            log.startLog(base);
+            modify(deque, 7);
+            const uint64_t generation = log.stopLog();
+            {
+                // An addition of 5 elements cut short by a crash.
+                std::ofstream stream((base + ".log." + std::to_string(generation)).c_str(),
+                        std::ios::binary | std::ios::app);
+                stream.put(static_cast<char>(CHANGE_ADD));
+                stream.put(5);
+                stream.write("abc", 3);
+            }
+            checkRecovered(deque);
+        }
+};
@@ -0,0 +1,85 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <chrono>
+#include <string>
+
+#include "ManualClock.hpp"
+#include "VectorDeque.hpp"
+#include "VectorDequeOccupancy.hpp"
+
+class VectorDequeOccupancyTest: public CppUnit::TestFixture {
+    private:
+        typedef BasicRecordOccupancy<ManualClock, 4> RecordManualOccupancy;
+        typedef BasicVectorDeque<int, RecordManualOccupancy> RecordedDeque;
+
+        CPPUNIT_TEST_SUITE(VectorDequeOccupancyTest);
+        CPPUNIT_TEST(testExport);
+        CPPUNIT_TEST(testSampleByOperations);
+        CPPUNIT_TEST(testSampleByTime);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() {
+            ManualClock::nanoseconds() = 0;
+        }
+
+        void testExport() {
+            RecordedDeque deque(2);
+            auto& occupancy = deque.observer<RecordManualOccupancy>();
+            CPPUNIT_ASSERT(occupancy.occupancyCsv()
+                    == "time,operations,size,low_size,high_size,capacity,high_capacity\n");
+            CPPUNIT_ASSERT(occupancy.occupancyJson() == "[]");
+            deque.add(1);
+            deque.add(2);
+            deque.pop();
+            ManualClock::nanoseconds() = 7;
+            occupancy.closeOccupancySample();
+            // Closing an interval without operations records nothing.
+            occupancy.closeOccupancySample();
+            CPPUNIT_ASSERT(occupancy.occupancyCsv()
+                    == "time,operations,size,low_size,high_size,capacity,high_capacity\n7,3,1,1,2,2,2\n");
+            CPPUNIT_ASSERT(occupancy.occupancyJson() == "[{\"time\":7,\"operations\":3,\"size\":1,\"lowSize\":1,"
+                    "\"highSize\":2,\"capacity\":2,\"highCapacity\":2}]");
+        }
+
+        void testSampleByOperations() {
+            RecordedDeque deque(2);
+            auto& occupancy = deque.observer<RecordManualOccupancy>();
+            occupancy.sampleOccupancyEvery(3);
+            deque.add(1);
+            deque.add(2);
+            // Resizing counts as an operation: the interval ends after the resize, before the addition.
+            deque.add(3);
+            CPPUNIT_ASSERT(occupancy.occupancySamples().size() == 1);
+            const OccupancySample& first = occupancy.occupancySamples()[0];
+            CPPUNIT_ASSERT(first.operations == 3);
+            CPPUNIT_ASSERT(first.lowSize == 1);
+            CPPUNIT_ASSERT(first.highSize == 2);
+            CPPUNIT_ASSERT(first.capacity == 7);
+            for (int i = 0; i < 20; ++i) {
+                deque.add(i);
+                deque.pop();
+            }
+            // Only the last 4 intervals are kept.
+            CPPUNIT_ASSERT(occupancy.occupancySamples().size() == 4);
+            CPPUNIT_ASSERT(occupancy.occupancySamples()[3].operations == 42);
+            CPPUNIT_ASSERT(occupancy.occupancySamples()[3].lowSize == 3);
+            CPPUNIT_ASSERT(occupancy.occupancySamples()[3].highSize == 4);
+        }
+
+        void testSampleByTime() {
+            RecordedDeque deque;
+            auto& occupancy = deque.observer<RecordManualOccupancy>();
+            occupancy.sampleOccupancyEvery(0, std::chrono::nanoseconds(100));
+            for (int i = 0; i < 10; ++i) {
+                ManualClock::nanoseconds() += 30;
+                deque.add(i);
+            }
+            // Intervals start at their first operation, at 30 and 180.
+            CPPUNIT_ASSERT(occupancy.occupancySamples().size() == 2);
+            CPPUNIT_ASSERT(occupancy.occupancySamples()[0].time == 150);
+            CPPUNIT_ASSERT(occupancy.occupancySamples()[0].highSize == 5);
+            CPPUNIT_ASSERT(occupancy.occupancySamples()[1].time == 300);
+            CPPUNIT_ASSERT(occupancy.occupancySamples()[1].lowSize == 6);
+        }
+};
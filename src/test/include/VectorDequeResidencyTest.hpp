@@ -0,0 +1,137 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+
+#include "ManualClock.hpp"
+#include "VectorDeque.hpp"
+#include "VectorDequeResidency.hpp"
+
+class VectorDequeResidencyTest: public CppUnit::TestFixture {
+    private:
+        typedef BasicTrackResidency<ManualClock> TrackManualResidency;
+        typedef BasicVectorDeque<int, TrackManualResidency> TrackedDeque;
+
+        CPPUNIT_TEST_SUITE(VectorDequeResidencyTest);
+        CPPUNIT_TEST(testBuckets);
+        CPPUNIT_TEST(testHistogram);
+        CPPUNIT_TEST(testMerge);
+        CPPUNIT_TEST(testResidency);
+        CPPUNIT_TEST(testResidencyOfCopies);
+        CPPUNIT_TEST_SUITE_END();
+
+    public:
+        void setUp() {
+            ManualClock::nanoseconds() = 1000;
+        }
+
+        void testBuckets() {
+            for (uint64_t value = 0; value < 8; ++value) {
+                CPPUNIT_ASSERT(LogLinearHistogram::bucketOf(value) == value);
+            }
+            CPPUNIT_ASSERT(LogLinearHistogram::bucketOf(8) == 8);
+            CPPUNIT_ASSERT(LogLinearHistogram::bucketOf(17) == 16);
+            CPPUNIT_ASSERT(LogLinearHistogram::bucketOf(~static_cast<uint64_t>(0))
+                    == LogLinearHistogram::NUM_BUCKETS - 1);
+            for (size_t bucket = 0; bucket < LogLinearHistogram::NUM_BUCKETS; ++bucket) {
+                const uint64_t lower = LogLinearHistogram::lowerBound(bucket);
+                const uint64_t upper = LogLinearHistogram::upperBound(bucket);
+                CPPUNIT_ASSERT(LogLinearHistogram::bucketOf(lower) == bucket);
+                CPPUNIT_ASSERT(LogLinearHistogram::bucketOf(upper) == bucket);
+                // Buckets are at most 1/8 as wide as their values.
+                CPPUNIT_ASSERT((upper - lower) / 8 <= lower / 64);
+            }
+            CPPUNIT_ASSERT_THROW(LogLinearHistogram::lowerBound(LogLinearHistogram::NUM_BUCKETS), std::out_of_range);
+            CPPUNIT_ASSERT_THROW(LogLinearHistogram().countAt(LogLinearHistogram::NUM_BUCKETS), std::out_of_range);
+        }
+
+        void testHistogram() {
+            LogLinearHistogram histogram;
+            CPPUNIT_ASSERT(histogram.quantile(0.5) == 0);
+            CPPUNIT_ASSERT(histogram.mean() == 0);
+            for (uint64_t value = 1; value <= 100; ++value) {
+                histogram.record(value * 1000);
+            }
+            CPPUNIT_ASSERT(histogram.count() == 100);
+            CPPUNIT_ASSERT(histogram.min() == 1000);
+            CPPUNIT_ASSERT(histogram.max() == 100000);
+            CPPUNIT_ASSERT(histogram.mean() == 50500);
+            const uint64_t median = histogram.quantile(0.5);
+            CPPUNIT_ASSERT(median >= 50000 && median <= 50000 * 9 / 8);
+            CPPUNIT_ASSERT(histogram.quantile(1) == 100000);
+            CPPUNIT_ASSERT(histogram.countAt(LogLinearHistogram::bucketOf(1000)) == 1);
+            CPPUNIT_ASSERT_THROW(histogram.quantile(1.5), std::invalid_argument);
+            histogram.clear();
+            CPPUNIT_ASSERT(histogram.count() == 0);
+        }
+
+        void testMerge() {
+            LogLinearHistogram first;
+            LogLinearHistogram second;
+            second.record(5);
+            second.record(7);
+            first.merge(second);
+            CPPUNIT_ASSERT(first.count() == 2);
+            CPPUNIT_ASSERT(first.min() == 5);
+            first.record(3);
+            first.merge(second);
+            CPPUNIT_ASSERT(first.count() == 5);
+            CPPUNIT_ASSERT(first.min() == 3);
+            CPPUNIT_ASSERT(first.max() == 7);
+            CPPUNIT_ASSERT(first.countAt(5) == 2);
+        }
+
+        void testResidency() {
+            TrackedDeque deque;
+            deque.add(1);
+            ManualClock::nanoseconds() += 10;
+            const int elements[] = {2, 3, 4};
+            deque.addAll(elements, 3);
+            ManualClock::nanoseconds() += 10;
+            deque.addFirst(0);
+            deque.insert(9, 2);
+            ManualClock::nanoseconds() += 100;
+            // Each element is stamped at its position: 0 (at 1020), 1 (1000), 9 (1020), 2, 3, 4 (1010).
+            CPPUNIT_ASSERT(deque.pop() == 0);
+            CPPUNIT_ASSERT(deque.observer<TrackManualResidency>().residencyHistogram().max() == 100);
+            CPPUNIT_ASSERT(deque.popLast() == 4);
+            CPPUNIT_ASSERT(deque.observer<TrackManualResidency>().residencyHistogram().max() == 110);
+            CPPUNIT_ASSERT(deque.removeAt(1) == 9);
+            int popped[2];
+            deque.popSome(popped, 2);
+            CPPUNIT_ASSERT(deque.observer<TrackManualResidency>().residencyHistogram().max() == 120);
+            const LogLinearHistogram& histogram = deque.observer<TrackManualResidency>().residencyHistogram();
+            CPPUNIT_ASSERT(histogram.count() == 5);
+            CPPUNIT_ASSERT(histogram.min() == 100);
+            CPPUNIT_ASSERT(histogram.mean() == (100 + 110 + 100 + 120 + 110) / 5.0);
+            deque.observer<TrackManualResidency>().resetResidencyHistogram();
+            ManualClock::nanoseconds() += 1000;
+            deque.clear();
+            CPPUNIT_ASSERT(histogram.count() == 1);
+            CPPUNIT_ASSERT(histogram.min() == 1110);
+        }
+
+        void testResidencyOfCopies() {
+            TrackedDeque deque;
+            deque.add(1);
+            ManualClock::nanoseconds() += 50;
+            // Copies are stamped when they are made.
+            TrackedDeque copy(deque);
+            ManualClock::nanoseconds() += 50;
+            copy.pop();
+            CPPUNIT_ASSERT(copy.observer<TrackManualResidency>().residencyHistogram().max() == 50);
+            // Moves keep the stamps.
+            TrackedDeque moved(std::move(deque));
+            moved.pop();
+            CPPUNIT_ASSERT(moved.observer<TrackManualResidency>().residencyHistogram().max() == 100);
+            VectorDeque<int> transferred;
+            transferred.add(2);
+            TrackedDeque target;
+            transferred.transferTo(target, 1);
+            ManualClock::nanoseconds() += 5;
+            target.pop();
+            CPPUNIT_ASSERT(target.observer<TrackManualResidency>().residencyHistogram().max() == 5);
+            static_assert(sizeof(VectorDeque<int>) == 4 * sizeof(void*), "Deques without the policy pay nothing");
+        }
+};
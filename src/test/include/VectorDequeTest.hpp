@@ -2,8 +2,34 @@
 
 #include "VectorDeque.hpp"
 #include <iostream>
+#include <queue>
+#include <stack>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
+// Compares equal to any value with the same last decimal digit, so that equal values may have different bytes.
+struct LastDigit {
+    int value;
+
+    bool operator ==(const LastDigit& that) const {
+        return value % 10 == that.value % 10;
+    }
+
+    bool operator !=(const LastDigit& that) const {
+        return !(*this == that);
+    }
+};
+
+namespace std {
+    template <>
+    struct hash<LastDigit> {
+        size_t operator ()(const LastDigit& digit) const {
+            return std::hash<int>()(digit.value % 10);
+        }
+    };
+}
+
 class VectorDequeTest: public CppUnit::TestFixture {
     private:
         VectorDeque<int>* vectorDequePtr;
@@ -22,19 +48,31 @@ class VectorDequeTest: public CppUnit::TestFixture {
         CPPUNIT_TEST(testAddAll);
         CPPUNIT_TEST(testAddAllFirst);
         CPPUNIT_TEST(testAddFirst);
+        CPPUNIT_TEST(testAdopt);
         CPPUNIT_TEST(testAssignment);
+        CPPUNIT_TEST(testBack);
         CPPUNIT_TEST(testClear);
+        CPPUNIT_TEST(testConstexpr);
         CPPUNIT_TEST(testConstructors);
         CPPUNIT_TEST(testContains);
         CPPUNIT_TEST(testCopyToArray);
+        CPPUNIT_TEST(testEmplace);
         CPPUNIT_TEST(testEquality);
+        CPPUNIT_TEST(testFill);
         CPPUNIT_TEST(testFind);
         CPPUNIT_TEST(testFromBack);
+        CPPUNIT_TEST(testFront);
+        CPPUNIT_TEST(testHash);
         CPPUNIT_TEST(testInequality);
         CPPUNIT_TEST(testInsert);
         CPPUNIT_TEST(testInsertIterator);
+        CPPUNIT_TEST(testIntoVector);
         CPPUNIT_TEST(testIsEmpty);
         CPPUNIT_TEST(testIterators);
+        CPPUNIT_TEST(testLinearize);
+        CPPUNIT_TEST(testMedianOf);
+        CPPUNIT_TEST(testNthElement);
+        CPPUNIT_TEST(testNthElementOf);
         CPPUNIT_TEST(testPeek);
         CPPUNIT_TEST(testPeekLast);
         CPPUNIT_TEST(testPop);
@@ -43,13 +81,22 @@ class VectorDequeTest: public CppUnit::TestFixture {
         CPPUNIT_TEST(testPopLast);
         CPPUNIT_TEST(testPopSome);
         CPPUNIT_TEST(testPopSomeLast);
+        CPPUNIT_TEST(testPushPop);
+        CPPUNIT_TEST(testRelease);
         CPPUNIT_TEST(testRemoveAt);
         CPPUNIT_TEST(testRemoveAtIterator);
         CPPUNIT_TEST(testReverseCopyToArray);
         CPPUNIT_TEST(testReverseSliceToArray);
+        CPPUNIT_TEST(testSegments);
+        CPPUNIT_TEST(testSet);
         CPPUNIT_TEST(testSize);
         CPPUNIT_TEST(testSliceToArray);
+        CPPUNIT_TEST(testStdAdaptors);
+        CPPUNIT_TEST(testStrings);
         CPPUNIT_TEST(testToString);
+        CPPUNIT_TEST(testTopK);
+        CPPUNIT_TEST(testTransferLastTo);
+        CPPUNIT_TEST(testTransferTo);
         CPPUNIT_TEST(testInternalInitialCapacity);
         CPPUNIT_TEST(testInternalPositionalInvariance);
         CPPUNIT_TEST(testInternalSpecialInsertion);
@@ -110,6 +157,16 @@ class VectorDequeTest: public CppUnit::TestFixture {
             CPPUNIT_ASSERT(*(iterator - 2) == i);
             CPPUNIT_ASSERT(*(iterator -= 2) == i);
         }
+
+        // Fill `vectorDequePtr` with a permutation of 0 to 99, wrapping 10 elements around the end of its backing array.
+        void wrapShuffled() {
+            vectorDequePtr->addAll(arrayOf0To99, 100);
+            vectorDequePtr->clear();
+            vectorDequePtr->_position = vectorDequePtr->_capacity - 90;
+            for (int i = 0; i < 100; ++i) {
+                vectorDequePtr->add(i * 37 % 100);
+            }
+        }
     
         void setUp() {
             vectorDequePtr = new VectorDeque<int>();
@@ -218,6 +275,43 @@ class VectorDequeTest: public CppUnit::TestFixture {
             CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequeOf99To0Ptr);
         }
 
+        void testAdopt() {
+            int* const data = new int[8];
+            for (int i = 0; i < 5; ++i) {
+                data[i] = i;
+            }
+            vectorDequePtr->add(3);
+            vectorDequePtr->adopt(data, 5, 8);
+            CPPUNIT_ASSERT(vectorDequePtr->size() == 5);
+            CPPUNIT_ASSERT(vectorDequePtr->capacity() == 8);
+            CPPUNIT_ASSERT(vectorDequePtr->segments().first.data == data);
+            for (int i = 0; i < 5; ++i) {
+                CPPUNIT_ASSERT((*vectorDequePtr)[i] == i);
+            }
+            // The adopted array grows like any other.
+            for (int i = 5; i < 100; ++i) {
+                vectorDequePtr->add(i);
+            }
+            CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequeOf0To99Ptr);
+
+            int* const notAdopted = new int[4];
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->adopt(notAdopted, 5, 4), std::invalid_argument);
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->adopt(NULL, 0, 4), std::invalid_argument);
+            CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequeOf0To99Ptr);
+            BasicVectorDeque<int, MaskWrapping> masked;
+            CPPUNIT_ASSERT_THROW(masked.adopt(notAdopted, 2, 3), std::invalid_argument);
+            masked.adopt(notAdopted, 2, 4);
+            CPPUNIT_ASSERT(masked.size() == 2);
+            CPPUNIT_ASSERT(masked.capacity() == 4);
+
+            // Observers see the replaced contents removed.
+            BasicVectorDeque<int, CollectStatistics> observed;
+            observed.add(1);
+            observed.add(2);
+            observed.adopt(new int[4], 0, 4);
+            CPPUNIT_ASSERT(observed.observer<CollectStatistics>().statistics().numRemoved == 2);
+        }
+
         void testAssignment() {
             *vectorDequePtr = *vectorDequePtr;
             CPPUNIT_ASSERT(vectorDequePtr->isEmpty());
@@ -229,6 +323,16 @@ class VectorDequeTest: public CppUnit::TestFixture {
             CPPUNIT_ASSERT(vectorDequePtr->isEmpty());
         }
 
+        void testBack() {
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->back(), std::length_error);
+            int& last = vectorDequeOf0To99Ptr->back();
+            CPPUNIT_ASSERT(last == 99);
+            last = 100;
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->peekLast() == 100);
+            const VectorDeque<int>& constDeque = *vectorDequeOf0To99Ptr;
+            CPPUNIT_ASSERT(&constDeque.back() == &last);
+        }
+
         void testClear() {
             vectorDequePtr->clear();
             CPPUNIT_ASSERT(vectorDequePtr->isEmpty());
@@ -238,6 +342,52 @@ class VectorDequeTest: public CppUnit::TestFixture {
             vectorDequePtr->addAll(arrayOf0To99, 100);
             vectorDequePtr->clear();
             vectorDequePtr->isEmpty();
+            // Clearing rewinds to the start of the backing array, even after the elements have wrapped around.
+            VectorDeque<int> wrapped(4);
+            wrapped.add(0);
+            wrapped.add(1);
+            wrapped.pop();
+            wrapped.add(2);
+            wrapped.add(3);
+            wrapped.add(4);
+            CPPUNIT_ASSERT(wrapped._position == 1);
+            wrapped.clear();
+            CPPUNIT_ASSERT(wrapped._position == 0);
+            wrapped.addFirst(5);
+            wrapped.add(6);
+            CPPUNIT_ASSERT(wrapped.peek() == 5);
+            CPPUNIT_ASSERT(wrapped.peekLast() == 6);
+            wrapped.clear();
+            wrapped.add(7);
+            CPPUNIT_ASSERT(wrapped._position == 0);
+            CPPUNIT_ASSERT(wrapped._data[0] == 7);
+        }
+
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L
+        // Exercise growth, wrapping, insertion and removal during constant evaluation.
+        static constexpr int sumAtCompileTime() {
+            VectorDeque<int> vectorDeque(2);
+            for (int i = 0; i < 20; ++i) {
+                vectorDeque.add(i);
+                vectorDeque.addFirst(-i);
+            }
+            vectorDeque.insert(100, 5);
+            vectorDeque.removeAt(3);
+            VectorDeque<int> moved(static_cast<VectorDeque<int>&&>(vectorDeque));
+            int sum = 0;
+            while (!moved.isEmpty()) {
+                sum += moved.pop();
+            }
+            return sum;
+        }
+#endif
+
+        void testConstexpr() {
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L
+            // The element removed at index 3 is -16.
+            static_assert(sumAtCompileTime() == 116, "VectorDeque should be usable at compile time");
+            CPPUNIT_ASSERT(sumAtCompileTime() == 116);
+#endif
         }
 
         void testConstructors() {
@@ -251,6 +401,11 @@ class VectorDequeTest: public CppUnit::TestFixture {
             *vectorDequePtr = VectorDeque<int>(*vectorDequeOf0To99Ptr);
             CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequeOf0To99Ptr);
 
+            std::vector<int> vector(*vectorOf0To99Ptr);
+            *vectorDequePtr = VectorDeque<int>(std::move(vector));
+            CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequeOf0To99Ptr);
+            CPPUNIT_ASSERT(vector.empty());
+
             *vectorDequePtr = VectorDeque<int>();
             CPPUNIT_ASSERT(vectorDequePtr->isEmpty());
         }
@@ -286,6 +441,15 @@ class VectorDequeTest: public CppUnit::TestFixture {
             }
         }
 
+        void testEmplace() {
+            VectorDeque<std::pair<int, int> > pairs;
+            CPPUNIT_ASSERT(pairs.emplace_back(1, 2));
+            CPPUNIT_ASSERT(pairs.emplace_front(3, 4));
+            CPPUNIT_ASSERT(pairs.size() == 2);
+            CPPUNIT_ASSERT(pairs.front() == std::make_pair(3, 4));
+            CPPUNIT_ASSERT(pairs.back() == std::make_pair(1, 2));
+        }
+
         void testEquality() {
             CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequePtr);
             CPPUNIT_ASSERT(*vectorDequePtr == VectorDeque<int>());
@@ -297,6 +461,18 @@ class VectorDequeTest: public CppUnit::TestFixture {
             CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequeOf0To99Ptr);
         }
 
+        void testFill() {
+            vectorDequePtr->fill(3);
+            vectorDequePtr->addAll(arrayOf0To99, 100);
+            vectorDequePtr->skip(50);
+            vectorDequePtr->addAll(arrayOf0To99, 50);
+            vectorDequePtr->fill(7);
+            CPPUNIT_ASSERT(vectorDequePtr->size() == 100);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT((*vectorDequePtr)[i] == 7);
+            }
+        }
+
         void testFind() {
             CPPUNIT_ASSERT(vectorDequePtr->find(3) == -1);
             vectorDequePtr->add(3);
@@ -310,6 +486,15 @@ class VectorDequeTest: public CppUnit::TestFixture {
                 CPPUNIT_ASSERT(vectorDequePtr->find(i) == i);
             }
             CPPUNIT_ASSERT(vectorDequePtr->find(100) == -1);
+
+            // Elements after the wrap are found at their logical index.
+            vectorDequePtr->clear();
+            vectorDequePtr->_position = vectorDequePtr->_capacity - 10;
+            vectorDequePtr->addAll(arrayOf0To99, 100);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(vectorDequePtr->find(i) == i);
+            }
+            CPPUNIT_ASSERT(vectorDequePtr->find(100) == -1);
         }
 
         void testFromBack() {
@@ -328,6 +513,52 @@ class VectorDequeTest: public CppUnit::TestFixture {
             }
         }
 
+        void testFront() {
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->front(), std::length_error);
+            int& first = vectorDequeOf0To99Ptr->front();
+            CPPUNIT_ASSERT(first == 0);
+            first = -1;
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->peek() == -1);
+            const VectorDeque<int>& constDeque = *vectorDequeOf0To99Ptr;
+            CPPUNIT_ASSERT(&constDeque.front() == &first);
+        }
+
+        void testHash() {
+            CPPUNIT_ASSERT(vectorDequePtr->hash() == VectorDeque<int>().hash());
+            CPPUNIT_ASSERT(vectorDequePtr->hash() != vectorDequeOf0To99Ptr->hash());
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->hash() != vectorDequeOf99To0Ptr->hash());
+            // The hash should not depend on where the contents wrap around.
+            vectorDequePtr->addAll(arrayOf0To99, 100);
+            const size_t expected = vectorDequeOf0To99Ptr->hash();
+            for (size_t i = 0; i < vectorDequePtr->_capacity; ++i) {
+                vectorDequePtr->clear();
+                vectorDequePtr->_position = i;
+                vectorDequePtr->addAll(arrayOf0To99, 100);
+                CPPUNIT_ASSERT(vectorDequePtr->hash() == expected);
+            }
+            VectorDeque<std::string> strings1;
+            VectorDeque<std::string> strings2;
+            strings1.add("b");
+            strings1.addFirst("a");
+            strings2.add("a");
+            strings2.add("b");
+            CPPUNIT_ASSERT(strings1.hash() == strings2.hash());
+            strings2.add("c");
+            CPPUNIT_ASSERT(strings1.hash() != strings2.hash());
+            // Equal elements with different bytes hash the same.
+            VectorDeque<LastDigit> digits1;
+            VectorDeque<LastDigit> digits2;
+            digits1.add(LastDigit{3});
+            digits2.add(LastDigit{13});
+            CPPUNIT_ASSERT(digits1 == digits2);
+            CPPUNIT_ASSERT(digits1.hash() == digits2.hash());
+
+            std::unordered_set<VectorDeque<int> > set;
+            set.insert(*vectorDequeOf0To99Ptr);
+            CPPUNIT_ASSERT(set.count(*vectorDequePtr) == 1);
+            CPPUNIT_ASSERT(set.count(*vectorDequeOf99To0Ptr) == 0);
+        }
+
         void testInequality() {
             CPPUNIT_ASSERT(!(*vectorDequePtr != *vectorDequePtr));
             CPPUNIT_ASSERT(!(*vectorDequePtr != VectorDeque<int>()));
@@ -382,6 +613,41 @@ class VectorDequeTest: public CppUnit::TestFixture {
             CPPUNIT_ASSERT((*vectorDequePtr)[3] == 7);
         }
 
+        void testIntoVector() {
+            CPPUNIT_ASSERT(vectorDequePtr->intoVector().empty());
+            wrapShuffled();
+            const std::vector<int> vector = vectorDequePtr->intoVector();
+            CPPUNIT_ASSERT(vector.size() == 100);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(vector[i] == i * 37 % 100);
+            }
+            CPPUNIT_ASSERT(vectorDequePtr->isEmpty());
+            CPPUNIT_ASSERT(vectorDequePtr->capacity() == 0);
+            // The deque is still usable.
+            vectorDequePtr->addAll(arrayOf0To99, 100);
+            CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequeOf0To99Ptr);
+
+            // Elements which own memory are moved in and out rather than copied bytewise.
+            std::vector<std::string> strings;
+            for (size_t i = 0; i < 10; ++i) {
+                strings.push_back(std::string(40, static_cast<char>('a' + i)));
+            }
+            VectorDeque<std::string> stringDeque{std::vector<std::string>(strings)};
+            CPPUNIT_ASSERT(stringDeque.size() == 10);
+            CPPUNIT_ASSERT(stringDeque[3] == strings[3]);
+            CPPUNIT_ASSERT(stringDeque.intoVector() == strings);
+
+            // The deque built from a vector grows like any other before going back.
+            VectorDeque<std::string> grown{std::vector<std::string>(strings)};
+            for (size_t i = 0; i < 30; ++i) {
+                grown.addFirst(std::string(40, static_cast<char>('A' + i)));
+                strings.insert(strings.begin(), grown.peek());
+            }
+            CPPUNIT_ASSERT(grown.size() == 40);
+            CPPUNIT_ASSERT(grown.intoVector() == strings);
+            CPPUNIT_ASSERT(grown.capacity() == 0);
+        }
+
         void testIsEmpty() {
             CPPUNIT_ASSERT(vectorDequePtr->isEmpty());
             CPPUNIT_ASSERT(!vectorDequeOf0To99Ptr->isEmpty());
@@ -421,6 +687,67 @@ class VectorDequeTest: public CppUnit::TestFixture {
             CPPUNIT_ASSERT(stringIterator->length() == 2);
         }
 
+        void testLinearize() {
+            // Already contiguous, so nothing moves.
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->linearize() == vectorDequeOf0To99Ptr->segments().first.data);
+            wrapShuffled();
+            const size_t capacity = vectorDequePtr->capacity();
+            CPPUNIT_ASSERT(vectorDequePtr->segments().second.size() == 10);
+            const int* const elements = vectorDequePtr->linearize();
+            CPPUNIT_ASSERT(vectorDequePtr->segments().second.size() == 0);
+            CPPUNIT_ASSERT(vectorDequePtr->capacity() == capacity);
+            CPPUNIT_ASSERT(elements == vectorDequePtr->segments().first.data);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(elements[i] == i * 37 % 100);
+                CPPUNIT_ASSERT((*vectorDequePtr)[i] == i * 37 % 100);
+            }
+        }
+
+        void testMedianOf() {
+            std::vector<int> scratch;
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->medianOf(scratch), std::length_error);
+            wrapShuffled();
+            CPPUNIT_ASSERT(vectorDequePtr->medianOf(scratch) == 49);
+            CPPUNIT_ASSERT(vectorDequePtr->medianOf(scratch, std::greater<int>()) == 50);
+            vectorDequePtr->popLast();
+            CPPUNIT_ASSERT(vectorDequePtr->medianOf(scratch) == 49);
+            // Left untouched.
+            for (int i = 0; i < 99; ++i) {
+                CPPUNIT_ASSERT((*vectorDequePtr)[i] == i * 37 % 100);
+            }
+        }
+
+        void testNthElement() {
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->nthElement(0), std::length_error);
+            wrapShuffled();
+            CPPUNIT_ASSERT(vectorDequePtr->nthElement(98) == 98);
+            CPPUNIT_ASSERT((*vectorDequePtr)[98] == 98);
+            CPPUNIT_ASSERT(vectorDequePtr->segments().second.size() == 0);
+            for (int i = 0; i < 98; ++i) {
+                CPPUNIT_ASSERT((*vectorDequePtr)[i] < 98);
+            }
+            CPPUNIT_ASSERT((*vectorDequePtr)[99] == 99);
+            // The returned reference is to the element in place.
+            vectorDequePtr->nthElement(0, std::greater<int>()) = -1;
+            CPPUNIT_ASSERT(vectorDequePtr->peek() == -1);
+            CPPUNIT_ASSERT(!vectorDequePtr->contains(99));
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->nthElement(100), std::length_error);
+        }
+
+        void testNthElementOf() {
+            std::vector<int> scratch;
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->nthElementOf(0, scratch), std::length_error);
+            wrapShuffled();
+            const VectorDeque<int>& constDeque = *vectorDequePtr;
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(constDeque.nthElementOf(static_cast<size_t>(i), scratch) == i);
+            }
+            CPPUNIT_ASSERT(scratch.size() == 100);
+            CPPUNIT_ASSERT(constDeque.nthElementOf(98, scratch, std::greater<int>()) == 1);
+            CPPUNIT_ASSERT(constDeque.segments().second.size() == 10);
+            CPPUNIT_ASSERT_THROW(constDeque.nthElementOf(100, scratch), std::length_error);
+        }
+
         void testPeek() {
             CPPUNIT_ASSERT_THROW(vectorDequePtr->peek(), std::length_error);
             vectorDequePtr->add(3);
@@ -557,6 +884,83 @@ class VectorDequeTest: public CppUnit::TestFixture {
             }
         }
 
+        void testPushPop() {
+            CPPUNIT_ASSERT(vectorDequePtr->empty());
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->pop_front(), std::length_error);
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->pop_back(), std::length_error);
+            for (int i = 50; i < 100; ++i) {
+                CPPUNIT_ASSERT(vectorDequePtr->push_back(i));
+            }
+            for (int i = 49; i >= 0; --i) {
+                CPPUNIT_ASSERT(vectorDequePtr->push_front(i));
+            }
+            CPPUNIT_ASSERT(!vectorDequePtr->empty());
+            CPPUNIT_ASSERT(*vectorDequePtr == *vectorDequeOf0To99Ptr);
+            vectorDequePtr->pop_front();
+            vectorDequePtr->pop_back();
+            CPPUNIT_ASSERT(vectorDequePtr->front() == 1);
+            CPPUNIT_ASSERT(vectorDequePtr->back() == 98);
+
+            // Elements of the deque itself may be pushed, even when the deque has to grow.
+            VectorDeque<int> small(1);
+            small.push_back(7);
+            small.push_back(small.front());
+            small.push_front(small.back());
+            CPPUNIT_ASSERT(small.size() == 3);
+            for (size_t i = 0; i < 3; ++i) {
+                CPPUNIT_ASSERT(small[i] == 7);
+            }
+        }
+
+        void testRelease() {
+            // Contiguous at the start: the backing array is handed out as is.
+            const int* const data = vectorDequeOf0To99Ptr->segments().first.data;
+            const size_t capacity = vectorDequeOf0To99Ptr->capacity();
+            VectorDequeBuffer<int> buffer = vectorDequeOf0To99Ptr->release();
+            CPPUNIT_ASSERT(buffer.data == data);
+            CPPUNIT_ASSERT(buffer.size == 100);
+            CPPUNIT_ASSERT(buffer.capacity == capacity);
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->isEmpty());
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->capacity() == 0);
+
+            // Round trip through another deque.
+            vectorDequePtr->adopt(buffer.data, buffer.size, buffer.capacity);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT((*vectorDequePtr)[i] == i);
+            }
+
+            // Wrapped: the elements are moved to the start first.
+            vectorDequePtr->clear();
+            wrapShuffled();
+            buffer = vectorDequePtr->release();
+            CPPUNIT_ASSERT(buffer.size == 100);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(buffer.data[i] == i * 37 % 100);
+            }
+            delete[] buffer.data;
+
+            // Offset but not wrapped.
+            vectorDequePtr->addAll(arrayOf0To99, 100);
+            vectorDequePtr->skip(40);
+            buffer = vectorDequePtr->release();
+            CPPUNIT_ASSERT(buffer.size == 60);
+            for (int i = 0; i < 60; ++i) {
+                CPPUNIT_ASSERT(buffer.data[i] == i + 40);
+            }
+            delete[] buffer.data;
+
+            // Inline arrays are copied out.
+            BasicVectorDeque<int, SmallBufferStorage<8> > small;
+            small.add(1);
+            small.add(2);
+            buffer = small.release();
+            CPPUNIT_ASSERT(buffer.size == 2);
+            CPPUNIT_ASSERT(buffer.data[0] == 1);
+            CPPUNIT_ASSERT(buffer.data[1] == 2);
+            CPPUNIT_ASSERT(small.isEmpty());
+            delete[] buffer.data;
+        }
+
         void testRemoveAt() {
             CPPUNIT_ASSERT_THROW(vectorDequePtr->removeAt(0), std::length_error);
             vectorDequePtr->add(3);
@@ -568,6 +972,14 @@ class VectorDequeTest: public CppUnit::TestFixture {
             CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->removeAt(37) == 37);
             int result = vectorDequeOf0To99Ptr->removeAt(37);
             CPPUNIT_ASSERT(result == 38);
+
+            // Removing from the back half shifts the back elements, leaving the front where it is.
+            const size_t position = vectorDequeOf0To99Ptr->_position;
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->removeAt(90) == 92);
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->_position == position);
+            CPPUNIT_ASSERT((*vectorDequeOf0To99Ptr)[90] == 93);
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->peekLast() == 99);
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->size() == 97);
         }
 
         void testRemoveAtIterator() {
@@ -613,6 +1025,52 @@ class VectorDequeTest: public CppUnit::TestFixture {
             }
         }
 
+        void testSegments() {
+            VectorDequeSegments<int> segments = vectorDequePtr->segments();
+            CPPUNIT_ASSERT(segments.first.size() == 0);
+            CPPUNIT_ASSERT(segments.second.size() == 0);
+
+            segments = vectorDequeOf0To99Ptr->segments();
+            CPPUNIT_ASSERT(segments.first.size() == 100);
+            CPPUNIT_ASSERT(segments.second.size() == 0);
+            CPPUNIT_ASSERT(segments.first.data[42] == 42);
+
+            // Wrap 10 elements around the end of the backing array.
+            vectorDequePtr->addAll(arrayOf0To99, 100);
+            vectorDequePtr->clear();
+            vectorDequePtr->_position = vectorDequePtr->_capacity - 90;
+            vectorDequePtr->addAll(arrayOf0To99, 100);
+            const VectorDeque<int>& constDeque = *vectorDequePtr;
+            const VectorDequeSegments<const int> constSegments = constDeque.segments();
+            CPPUNIT_ASSERT(constSegments.first.size() == 90);
+            CPPUNIT_ASSERT(constSegments.second.size() == 10);
+            CPPUNIT_ASSERT(constSegments.second.data == vectorDequePtr->_data);
+            int expected = 0;
+            for (const int element: constSegments.first) {
+                CPPUNIT_ASSERT(element == expected++);
+            }
+            for (const int element: constSegments.second) {
+                CPPUNIT_ASSERT(element == expected++);
+            }
+
+            // Segments of part of the contents.
+            segments = (vectorDequePtr->begin() + 85).segmentsUntil(vectorDequePtr->begin() + 95);
+            CPPUNIT_ASSERT(segments.first.size() == 5);
+            CPPUNIT_ASSERT(segments.first.data[0] == 85);
+            CPPUNIT_ASSERT(segments.second.size() == 5);
+            CPPUNIT_ASSERT(segments.second.data[4] == 94);
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->end().segmentsUntil(vectorDequePtr->begin()), std::invalid_argument);
+        }
+
+        void testSet() {
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->set(0, 1), std::length_error);
+            wrapShuffled();
+            vectorDequePtr->set(95, -1);
+            CPPUNIT_ASSERT((*vectorDequePtr)[95] == -1);
+            CPPUNIT_ASSERT((*vectorDequePtr)[94] == 94 * 37 % 100);
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->set(100, 1), std::length_error);
+        }
+
         void testSize() {
             CPPUNIT_ASSERT(vectorDequePtr->size() == 0);
             vectorDequePtr->add(3);
@@ -675,6 +1133,59 @@ class VectorDequeTest: public CppUnit::TestFixture {
             }
         }
 
+        void testStdAdaptors() {
+            std::queue<int, VectorDeque<int> > queue;
+            std::stack<int, VectorDeque<int> > stack;
+            for (int i = 0; i < 100; ++i) {
+                queue.push(i);
+                stack.emplace(i);
+            }
+            CPPUNIT_ASSERT(queue.size() == 100);
+            CPPUNIT_ASSERT(queue.back() == 99);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(queue.front() == i);
+                CPPUNIT_ASSERT(stack.top() == 99 - i);
+                queue.pop();
+                stack.pop();
+            }
+            CPPUNIT_ASSERT(queue.empty());
+            CPPUNIT_ASSERT(stack.empty());
+            std::queue<int, VectorDeque<int> > other;
+            other.push(3);
+            queue.swap(other);
+            CPPUNIT_ASSERT(queue.front() == 3);
+            CPPUNIT_ASSERT(other.empty());
+        }
+
+        void testStrings() {
+            // Elements that own memory must survive growth, shifting, copying and assignment.
+            VectorDeque<std::string> strings(1);
+            for (int i = 0; i < 20; ++i) {
+                strings.add(std::string(40, static_cast<char>('a' + i)));
+                strings.addFirst(std::string(40, static_cast<char>('A' + i)));
+            }
+            strings.insert("middle", 20);
+            strings.removeAt(5);
+            VectorDeque<std::string> copy(strings);
+            VectorDeque<std::string> assigned(1);
+            assigned = strings;
+            CPPUNIT_ASSERT(strings.size() == 40);
+            CPPUNIT_ASSERT(copy == strings);
+            CPPUNIT_ASSERT(assigned == strings);
+            CPPUNIT_ASSERT(strings[0] == std::string(40, 'T'));
+            CPPUNIT_ASSERT(strings[5] == std::string(40, 'N'));
+            CPPUNIT_ASSERT(strings[19] == "middle");
+            CPPUNIT_ASSERT(strings[39] == std::string(40, 't'));
+            // Growing during insertion.
+            VectorDeque<std::string> full(2);
+            full.add("first");
+            full.add("last");
+            full.insert("inserted", 1);
+            CPPUNIT_ASSERT(full.pop() == "first");
+            CPPUNIT_ASSERT(full.pop() == "inserted");
+            CPPUNIT_ASSERT(full.pop() == "last");
+        }
+
         void testToString() {
             CPPUNIT_ASSERT(((std::string) *vectorDequePtr) == "{}");
             vectorDequePtr->add(3);
@@ -684,6 +1195,114 @@ class VectorDequeTest: public CppUnit::TestFixture {
             CPPUNIT_ASSERT(((std::string) *vectorDequePtr) == "{3, 4, 5}");
         }
 
+        void testTopK() {
+            int top[10];
+            vectorDequePtr->topK(0, top);
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->topK(1, top), std::length_error);
+            wrapShuffled();
+            vectorDequePtr->topK(10, top);
+            for (int i = 0; i < 10; ++i) {
+                CPPUNIT_ASSERT(top[i] == 99 - i);
+            }
+            vectorDequePtr->topK(3, top, std::greater<int>());
+            CPPUNIT_ASSERT(top[0] == 0);
+            CPPUNIT_ASSERT(top[1] == 1);
+            CPPUNIT_ASSERT(top[2] == 2);
+            // Left untouched.
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT((*vectorDequePtr)[i] == i * 37 % 100);
+            }
+            // Every element.
+            vectorDequeOf0To99Ptr->topK(100, destArray);
+            for (int i = 0; i < 100; ++i) {
+                CPPUNIT_ASSERT(destArray[i] == 99 - i);
+            }
+        }
+
+        void testTransferLastTo() {
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->transferLastTo(*vectorDeque2Ptr, 1), std::length_error);
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->transferLastTo(*vectorDequePtr, 0), std::invalid_argument);
+            vectorDequeOf0To99Ptr->transferLastTo(*vectorDequePtr, 0);
+            CPPUNIT_ASSERT(vectorDequePtr->isEmpty());
+
+            // Both the source and the target range wrap around their backing arrays.
+            VectorDeque<int> source(64);
+            source._position = 50;
+            source.addAll(arrayOf0To99, 30);
+            VectorDeque<int> target(64);
+            target._position = 5;
+            target.add(100);
+            target.add(101);
+            source.transferLastTo(target, 20);
+            CPPUNIT_ASSERT(source.size() == 10);
+            CPPUNIT_ASSERT(source.peekLast() == 9);
+            CPPUNIT_ASSERT(target.size() == 22);
+            for (int i = 0; i < 20; ++i) {
+                CPPUNIT_ASSERT(target[i] == i + 10);
+            }
+            CPPUNIT_ASSERT(target[20] == 100);
+            CPPUNIT_ASSERT(target[21] == 101);
+
+            // The target resizes once if needed.
+            VectorDeque<int> small(2);
+            small.add(-1);
+            vectorDequeOf0To99Ptr->transferLastTo(small, 50);
+            CPPUNIT_ASSERT(small.size() == 51);
+            CPPUNIT_ASSERT(small.peek() == 50);
+            CPPUNIT_ASSERT(small.peekLast() == -1);
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->size() == 50);
+            CPPUNIT_ASSERT(vectorDequeOf0To99Ptr->peekLast() == 49);
+        }
+
+        void testTransferTo() {
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->transferTo(*vectorDeque2Ptr, 1), std::length_error);
+            CPPUNIT_ASSERT_THROW(vectorDequePtr->transferTo(*vectorDequePtr, 0), std::invalid_argument);
+
+            // Both the source and the target range wrap around their backing arrays.
+            VectorDeque<int> source(64);
+            source._position = 50;
+            source.addAll(arrayOf0To99, 30);
+            VectorDeque<int> target(64);
+            target._position = 40;
+            target.add(100);
+            target.add(101);
+            source.transferTo(target, 25);
+            CPPUNIT_ASSERT(source.size() == 5);
+            CPPUNIT_ASSERT(source.peek() == 25);
+            CPPUNIT_ASSERT(target.size() == 27);
+            CPPUNIT_ASSERT(target[0] == 100);
+            CPPUNIT_ASSERT(target[1] == 101);
+            for (int i = 0; i < 25; ++i) {
+                CPPUNIT_ASSERT(target[i + 2] == i);
+            }
+
+            // Transfers work between deques with different policies, and move non-trivial elements.
+            VectorDeque<std::string> strings(8);
+            for (int i = 0; i < 6; ++i) {
+                strings.add(std::string(40, static_cast<char>('a' + i)));
+            }
+            BasicVectorDeque<std::string, CollectStatistics> stringTarget(16);
+            strings.transferTo(stringTarget, 4);
+            CPPUNIT_ASSERT(stringTarget.size() == 4);
+            CPPUNIT_ASSERT(stringTarget.peekLast() == std::string(40, 'd'));
+            CPPUNIT_ASSERT(stringTarget.observer<CollectStatistics>().statistics().numAdded == 4);
+            CPPUNIT_ASSERT(strings.size() == 2);
+            CPPUNIT_ASSERT(strings.peek() == std::string(40, 'e'));
+            // A target which must grow moves its own elements into the new backing array.
+            VectorDeque<std::string> smallTarget(1);
+            smallTarget.add("existing");
+            stringTarget.transferLastTo(smallTarget, 3);
+            CPPUNIT_ASSERT(smallTarget.size() == 4);
+            CPPUNIT_ASSERT(smallTarget.peek() == std::string(40, 'b'));
+            CPPUNIT_ASSERT(smallTarget[2] == std::string(40, 'd'));
+            CPPUNIT_ASSERT(smallTarget.peekLast() == "existing");
+            strings.transferTo(smallTarget, 2);
+            CPPUNIT_ASSERT(smallTarget.size() == 6);
+            CPPUNIT_ASSERT(smallTarget.peekLast() == std::string(40, 'f'));
+            CPPUNIT_ASSERT(stringTarget.size() == 1);
+            CPPUNIT_ASSERT(stringTarget.peek() == std::string(40, 'a'));
+        }
+
         void testInternalInitialCapacity() {
             VectorDeque<int> newVectorDeque1;
             CPPUNIT_ASSERT(newVectorDeque1._capacity == VectorDeque<int>::DEFAULT_INITIAL_CAPACITY);
@@ -748,6 +1367,16 @@ class VectorDequeTest: public CppUnit::TestFixture {
             for (int i = 6; i <= previousCapacity; ++i) {
                 CPPUNIT_ASSERT((*vectorDequePtr)[i] == i - 1);
             }
+            // Shifting the first element down past the start of the backing array.
+            VectorDeque<int> wrapping(10);
+            wrapping.add(1);
+            wrapping.add(2);
+            wrapping.add(3);
+            wrapping.insert(9, 1);
+            CPPUNIT_ASSERT(wrapping[0] == 1);
+            CPPUNIT_ASSERT(wrapping[1] == 9);
+            CPPUNIT_ASSERT(wrapping[2] == 2);
+            CPPUNIT_ASSERT(wrapping[3] == 3);
         }
 
         void tearDown() {
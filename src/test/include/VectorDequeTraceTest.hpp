@@ -0,0 +1,115 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "VectorDeque.hpp"
+#include "VectorDequeTrace.hpp"
+
+class VectorDequeTraceTest: public CppUnit::TestFixture {
+    private:
+        std::string path;
+
+        CPPUNIT_TEST_SUITE(VectorDequeTraceTest);
+        CPPUNIT_TEST(testBadTrace);
+        CPPUNIT_TEST(testLargeArguments);
+        CPPUNIT_TEST(testRecord);
+        CPPUNIT_TEST_SUITE_END();
+
+        void checkNext(TraceReader& reader, const TraceOperation operation, const uint64_t argument) {
+            TraceRecord record;
+            CPPUNIT_ASSERT(reader.next(record));
+            CPPUNIT_ASSERT(record.operation == operation);
+            CPPUNIT_ASSERT(record.argument == argument);
+        }
+
+    public:
+        void setUp() {
+            path = "VectorDequeTraceTest.trace";
+        }
+
+        void testBadTrace() {
+            CPPUNIT_ASSERT_THROW(TraceReader("nonexistent/trace"), std::runtime_error);
+            {
+                std::ofstream stream(path.c_str(), std::ios::binary);
+                stream << "VDQX";
+                stream.put(1);
+            }
+            CPPUNIT_ASSERT_THROW(TraceReader reader(path), std::runtime_error);
+            {
+                std::ofstream stream(path.c_str(), std::ios::binary);
+                stream << "VDQT";
+                stream.put(static_cast<char>(TraceWriter::version()));
+                // An addition whose 2 byte argument is cut off after the first byte.
+                stream.put(TRACE_ADD);
+                stream.put(static_cast<char>(0x80));
+            }
+            TraceReader reader(path);
+            TraceRecord record;
+            CPPUNIT_ASSERT_THROW(reader.next(record), std::runtime_error);
+            std::remove(path.c_str());
+        }
+
+        void testLargeArguments() {
+            {
+                TraceWriter writer(path);
+                writer.write(TRACE_REMOVE, 0);
+                writer.write(TRACE_ADD, 127);
+                writer.write(TRACE_ADD, 128);
+                writer.write(TRACE_ACCESS, 0xFFFFFFFFFFFFFFFFULL);
+                CPPUNIT_ASSERT(writer.numRecords() == 4);
+            }
+            TraceReader reader(path);
+            checkNext(reader, TRACE_REMOVE, 0);
+            checkNext(reader, TRACE_ADD, 127);
+            checkNext(reader, TRACE_ADD, 128);
+            checkNext(reader, TRACE_ACCESS, 0xFFFFFFFFFFFFFFFFULL);
+            TraceRecord record;
+            CPPUNIT_ASSERT(!reader.next(record));
+            std::remove(path.c_str());
+        }
+
+        void testRecord() {
+            BasicVectorDeque<int, TraceOperations> deque;
+            auto& trace = deque.observer<TraceOperations>();
+            deque.add(1);
+            CPPUNIT_ASSERT(!trace.isTracing());
+            CPPUNIT_ASSERT(trace.stopTrace() == 0);
+            trace.startTrace(path);
+            CPPUNIT_ASSERT(trace.isTracing());
+            const int elements[] = {2, 3, 4, 5};
+            deque.addAll(elements, 4);
+            deque.addFirst(0);
+            CPPUNIT_ASSERT(deque[2] == 2);
+            // Accesses made internally by other methods are not recorded.
+            CPPUNIT_ASSERT(deque.peek() == 0);
+            CPPUNIT_ASSERT(deque == deque);
+            deque.insert(9, 3);
+            CPPUNIT_ASSERT(deque.removeAt(3) == 9);
+            deque.pop();
+            deque.skipLast(2);
+            deque.clear();
+            // Copies are not traced.
+            BasicVectorDeque<int, TraceOperations> copy(deque);
+            CPPUNIT_ASSERT(!copy.observer<TraceOperations>().isTracing());
+            copy.add(1);
+            CPPUNIT_ASSERT(trace.stopTrace() == 9);
+            deque.add(1);
+
+            TraceReader reader(path);
+            checkNext(reader, TRACE_ASSIGN, 1);
+            checkNext(reader, TRACE_ADD, 4);
+            checkNext(reader, TRACE_ADD_FIRST, 1);
+            checkNext(reader, TRACE_ACCESS, 2);
+            checkNext(reader, TRACE_INSERT, 3);
+            checkNext(reader, TRACE_REMOVE_AT, 3);
+            checkNext(reader, TRACE_REMOVE, 1);
+            checkNext(reader, TRACE_REMOVE_LAST, 2);
+            checkNext(reader, TRACE_REMOVE, 3);
+            TraceRecord record;
+            CPPUNIT_ASSERT(!reader.next(record));
+            std::remove(path.c_str());
+        }
+};